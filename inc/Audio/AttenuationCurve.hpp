@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Config.hpp"
+
+#include <memory>
+
+namespace Audio
+{
+class AttenuationCurveImpl;
+
+/// <summary>
+/// A distance attenuation curve that replaces the attenuation model of the sounds it is assigned to
+/// (see `Sound::setAttenuationCurve`). The curve is defined by a set of points (distance, gain) that are
+/// authored by a sound designer (or loaded from a file, see `Device::loadAttenuationCurve`).
+/// </summary>
+/// <remarks>
+/// The curve is baked into a lookup table when it is created, so evaluating the curve costs the same for any
+/// number of points. A curve can be shared by any number of sounds. The gains of all sounds that use the same
+/// curve are evaluated together on the audio thread at the start of every period. Beyond the last point the gain
+/// of the last point is used, and before the first point the gain of the first point is used.
+/// The cone, the minimum and maximum gain, and the volume of the sound still apply.
+/// </remarks>
+class AUDIO_API AttenuationCurve
+{
+public:
+    enum class Interpolation
+    {
+        Linear,  ///< Straight lines between the points.
+        Smooth,  ///< A smooth (monotone cubic) curve through the points. The curve does not overshoot the points.
+    };
+
+    struct Point
+    {
+        float distance;  ///< The distance from the listener.
+        float gain;      ///< The gain (in the range [0 .. 1]) at the distance.
+    };
+
+    /// <summary>
+    /// Get the gain of the curve at a distance.
+    /// </summary>
+    /// <param name="distance">The distance from the listener.</param>
+    /// <returns>The gain at the distance.</returns>
+    float getGain( float distance ) const;
+
+    /// <summary>
+    /// Get the distance of the last point of the curve.
+    /// </summary>
+    /// <returns>The distance beyond which the gain no longer changes.</returns>
+    float getMaxDistance() const;
+
+    AttenuationCurve();
+    ~AttenuationCurve();
+    AttenuationCurve( const AttenuationCurve& );
+    AttenuationCurve( AttenuationCurve&& ) noexcept;
+    AttenuationCurve& operator=( const AttenuationCurve& );
+    AttenuationCurve& operator=( AttenuationCurve&& ) noexcept;
+
+    /// <summary>
+    /// Allow nullptr assignment.
+    /// </summary>
+    /// <remarks>
+    /// Assigning `nullptr` will release the underlying implementation.
+    /// This is the same as using the `reset` function on this object.
+    /// </remarks>
+    AttenuationCurve& operator=( nullptr_t ) noexcept;
+
+    /// <summary>
+    /// Allow for null checks.
+    /// </summary>
+    bool operator==( nullptr_t ) const noexcept;
+    bool operator!=( nullptr_t ) const noexcept;
+
+    /// <summary>
+    /// Explicit bool conversion allows to check for a valid object.
+    /// </summary>
+    /// <returns>`true` if this object contains a valid pointer to implementation. `false` otherwise.</returns>
+    explicit operator bool() const noexcept;
+
+    /// <summary>
+    /// Get the pointer to the implementation.
+    /// </summary>
+    /// <returns>The pointer to the attenuation curve implementation.</returns>
+    std::shared_ptr<AttenuationCurveImpl> get() const noexcept;
+
+    /// <summary>
+    /// Release the underlying pointer to implementation.
+    /// </summary>
+    void reset() noexcept;
+
+protected:
+    AttenuationCurve( std::shared_ptr<AttenuationCurveImpl> impl );
+
+private:
+    std::shared_ptr<AttenuationCurveImpl> impl;
+};
+}  // namespace Audio
+
+namespace std
+{
+// Export DLL API to suppress warnings.
+AUDIO_EXTERN template class AUDIO_API shared_ptr<Audio::AttenuationCurveImpl>;
+}  // namespace std
@@ -0,0 +1,314 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Effect.hpp"
+#include "Listener.hpp"
+#include "Room.hpp"
+
+#include <memory>
+
+namespace Audio
+{
+class BusImpl;
+
+/// <summary>
+/// A bus mixes a group of sounds (and child buses) together before sending
+/// the mix to its parent bus. Volume, pitch, and effects applied to a bus are
+/// applied once to the mix of all of the sounds that play on the bus.
+/// </summary>
+class AUDIO_API Bus
+{
+public:
+    /// <summary>
+    /// The built-in buses.
+    /// All built-in buses (except the master bus) are children of the master bus.
+    /// </summary>
+    enum class Type
+    {
+        Master,   ///< The master bus. All buses end up in the master bus.
+        Music,    ///< Background music. Sounds loaded with `Device::loadMusic` play on this bus.
+        Effects,  ///< Sound effects. Sounds loaded with `Device::loadSound` play on this bus.
+        Voice,    ///< Dialog and narration.
+        UI,       ///< User interface sounds.
+    };
+
+    /// <summary>
+    /// The ambisonic order of the sound field of a bus.
+    /// </summary>
+    enum class Ambisonics
+    {
+        None,        ///< The 3D sounds of the bus are spatialized individually.
+        FirstOrder,  ///< 4 channels. Cheap, but the sounds are not very well localized.
+        ThirdOrder,  ///< 16 channels. Sharper localization.
+    };
+
+    /// <summary>
+    /// Get one of the built-in buses.
+    /// </summary>
+    /// <param name="type">The built-in bus to get.</param>
+    explicit Bus( Type type );
+
+    /// <summary>
+    /// Set the volume of the bus.
+    /// </summary>
+    /// <param name="volume">The volume to set this bus to (in the range [0 .. 1])</param>
+    void setVolume( float volume );
+
+    /// <summary>
+    /// Get the volume of the bus.
+    /// </summary>
+    /// <returns>The current volume of this bus.</returns>
+    float getVolume() const;
+
+    /// <summary>
+    /// Set the pitch of all of the sounds on this bus.
+    /// </summary>
+    /// <param name="pitch">The pitch to set this bus to.</param>
+    void setPitch( float pitch );
+
+    /// <summary>
+    /// Get the pitch of this bus.
+    /// </summary>
+    /// <returns>The current pitch of this bus.</returns>
+    float getPitch() const;
+
+    /// <summary>
+    /// Mute (or unmute) this bus.
+    /// Muting a bus does not change the volume of the bus.
+    /// </summary>
+    /// <param name="muted">`true` to mute the bus, `false` to unmute the bus.</param>
+    void setMuted( bool muted );
+
+    /// <summary>
+    /// Check if this bus is muted.
+    /// </summary>
+    /// <returns>`true` if the bus is muted, `false` otherwise.</returns>
+    bool isMuted() const;
+
+    /// <summary>
+    /// Render this bus (with its sounds, child buses, and effects) in parallel with other buses.
+    /// Parallel buses are rendered on a pool of worker threads at the start of every audio period,
+    /// so the mixing capacity scales with the number of cores. Use parallel buses for large,
+    /// independent groups of sounds (for example, the effects bus and the ambience bus).
+    /// </summary>
+    /// <remarks>
+    /// A bus (or any of its child buses) that is rendered in parallel can only send to buses
+    /// that are rendered by the same thread (the same parallel bus). Sends and sidechains of the
+    /// parallel bus itself are not restricted. The master bus cannot be rendered in parallel.
+    /// </remarks>
+    /// <param name="parallel">`true` to render the bus in parallel, `false` to render the bus on the audio thread.</param>
+    void setParallel( bool parallel );
+
+    /// <summary>
+    /// Check if this bus is rendered in parallel with other buses.
+    /// </summary>
+    /// <returns>`true` if the bus is rendered in parallel, `false` otherwise.</returns>
+    bool isParallel() const;
+
+    /// <summary>
+    /// Cluster the 3D sounds of this bus that are close together. The sounds of a cluster are
+    /// mixed together and spatialized once (at the centroid of the cluster) instead of being
+    /// spatialized individually, which makes large crowds of 3D sounds much cheaper to render.
+    /// Clusters are updated by `Device::update`.
+    /// </summary>
+    /// <remarks>
+    /// The cluster size is relative to the distance to the listener: a sound can join a cluster if
+    /// its distance to the centroid is less than `clusterSize` times the distance between the centroid
+    /// and the listener. Distant sounds are clustered more aggressively than nearby sounds.
+    /// The sounds of a cluster are attenuated like the cluster, and have no cone or doppler effect.
+    /// </remarks>
+    /// <param name="clusterSize">The relative size of the clusters (for example, 0.1), or 0 to disable clustering.</param>
+    void setClustering( float clusterSize );
+
+    /// <summary>
+    /// Get the relative size of the clusters of this bus.
+    /// </summary>
+    /// <returns>The relative cluster size, or 0 if clustering is disabled.</returns>
+    float getClustering() const;
+
+    /// <summary>
+    /// Let the reverb zones around the listener of this bus set the sends of this bus to the reverb buses of
+    /// the zones (see `ReverbZone`). The sends are updated by `Device::update`. If the bus has no listener
+    /// (see `setListener`), the sends follow the first listener.
+    /// </summary>
+    /// <param name="enabled">`true` to let the reverb zones drive the sends, `false` to remove the sends to the reverb buses of the zones.</param>
+    void setZoneSends( bool enabled );
+
+    /// <summary>
+    /// Check if the sends of this bus are driven by the reverb zones.
+    /// </summary>
+    /// <returns>`true` if the reverb zones drive the sends of this bus.</returns>
+    bool getZoneSends() const;
+
+    /// <summary>
+    /// Mix the 3D sounds of this bus into an ambisonic sound field. Each sound is only encoded into
+    /// the sound field (a gain per ambisonic channel), and the sound field is decoded once for the
+    /// whole bus. The cost of decoding (and rotating the sound field with the listener) does not
+    /// depend on the number of sounds, which makes dense scenes much cheaper to render.
+    /// </summary>
+    /// <remarks>
+    /// The sound field is rendered for the listener of the bus (see `setListener`), or the first listener. The sounds are still attenuated by distance,
+    /// and keep their cone and doppler effect.
+    /// Binaural decoding uses the HRTF that was loaded with `Device::loadHrtf` and requires a stereo device
+    /// (the sound field is decoded to the speakers until an HRTF is loaded).
+    /// Sounds that are clustered (see `setClustering`) are spatialized by their cluster instead.
+    /// </remarks>
+    /// <param name="ambisonics">The ambisonic order, or `Ambisonics::None` to spatialize the sounds individually.</param>
+    /// <param name="binaural">`true` to decode the sound field with the HRTF, `false` to decode it to the speakers.</param>
+    void setAmbisonics( Ambisonics ambisonics, bool binaural = false );
+
+    /// <summary>
+    /// Get the ambisonic order of the sound field of this bus.
+    /// </summary>
+    /// <returns>The ambisonic order, or `Ambisonics::None` if the 3D sounds are spatialized individually.</returns>
+    Ambisonics getAmbisonics() const;
+
+    /// <summary>
+    /// Add the early reflections of a room to the 3D sounds of this bus (see `Room`). The reflections of
+    /// all sounds of the bus are rendered through a single delay line, which is mixed into this bus.
+    /// </summary>
+    /// <remarks>
+    /// The reflections are computed for the listener of each sound. Sounds that are clustered (see `setClustering`)
+    /// have no reflections. A room can be shared by several buses.
+    /// </remarks>
+    /// <param name="room">The room, or an empty room to remove the reflections.</param>
+    void setRoom( const Room& room );
+
+    /// <summary>
+    /// Spatialize the 3D sounds of this bus for a specific listener.
+    /// Together with `setOutputChannels`, this renders a separate submix per listener (for example,
+    /// one bus per player in split-screen). To hear a sound from several listeners, play a copy of
+    /// the sound on the bus of each listener: sounds that are loaded from the same file with
+    /// `Device::loadSound` share the decoded audio data, so each copy only costs its own spatialization.
+    /// </summary>
+    /// <remarks>
+    /// The listener of the bus overrides the pinned listener of its sounds (see `Sound::setPinnedListener`).
+    /// A listener only applies to the sounds that play directly on this bus.
+    /// </remarks>
+    /// <param name="listener">The listener, or an empty listener to spatialize the sounds for the closest listener.</param>
+    void setListener( const Listener& listener );
+
+    /// <summary>
+    /// Get the listener the 3D sounds of this bus are spatialized for.
+    /// </summary>
+    /// <returns>The listener, or an empty listener if the sounds are spatialized for the closest listener.</returns>
+    Listener getListener() const;
+
+    /// <summary>
+    /// Route the output of this bus to a range of output channels of the device. The mix is
+    /// downmixed to `channelCount` channels, and the other output channels are silent.
+    /// For example, on a 4 channel device, the submix of one player can be routed to channels 0 - 1
+    /// and the submix of another player to channels 2 - 3.
+    /// </summary>
+    /// <remarks>
+    /// The routing is applied after the sends of this bus (the sends receive the full mix). The range
+    /// is clamped to the channels of the device.
+    /// </remarks>
+    /// <param name="firstChannel">The first output channel.</param>
+    /// <param name="channelCount">The number of output channels, or 0 to output to all channels.</param>
+    void setOutputChannels( uint32_t firstChannel, uint32_t channelCount );
+
+    /// <summary>
+    /// Get the parent of this bus.
+    /// </summary>
+    /// <returns>The parent bus, or an empty bus for the master bus.</returns>
+    Bus getParent() const;
+
+    /// <summary>
+    /// Add an effect to the end of the effect chain of this bus.
+    /// </summary>
+    /// <remarks>
+    /// An effect can only be in the effect chain of one bus. Remove it from its bus before adding it to another bus.
+    /// </remarks>
+    /// <param name="effect">The effect to add.</param>
+    void addEffect( const Effect& effect );
+
+    /// <summary>
+    /// Remove an effect from the effect chain of this bus.
+    /// </summary>
+    /// <param name="effect">The effect to remove.</param>
+    void removeEffect( const Effect& effect );
+
+    /// <summary>
+    /// Remove all effects from the effect chain of this bus.
+    /// </summary>
+    void clearEffects();
+
+    /// <summary>
+    /// Send the output of this bus to another bus (in addition to the parent bus).
+    /// Sends are used to share a single (expensive) effect, like a reverb, between many buses.
+    /// If this bus already sends to the target bus, the send level is updated.
+    /// </summary>
+    /// <remarks>
+    /// Sends are applied after the effect chain and the volume of this bus.
+    /// A bus cannot send to a bus that (directly or indirectly) feeds this bus.
+    /// </remarks>
+    /// <param name="target">The bus to send to.</param>
+    /// <param name="level">The level of the send (in the range [0 .. 1]).</param>
+    void setSend( const Bus& target, float level );
+
+    /// <summary>
+    /// Get the level of a send from this bus.
+    /// </summary>
+    /// <param name="target">The target bus of the send.</param>
+    /// <returns>The level of the send, or 0 if this bus does not send to the target bus.</returns>
+    float getSend( const Bus& target ) const;
+
+    /// <summary>
+    /// Stop sending the output of this bus to another bus.
+    /// </summary>
+    /// <param name="target">The target bus of the send.</param>
+    void removeSend( const Bus& target );
+
+    Bus();
+    ~Bus();
+    Bus( const Bus& );
+    Bus( Bus&& ) noexcept;
+    Bus& operator=( const Bus& );
+    Bus& operator=( Bus&& ) noexcept;
+
+    /// <summary>
+    /// Allow nullptr assignment.
+    /// </summary>
+    /// <remarks>
+    /// Assigning `nullptr` will release the underlying implementation.
+    /// This is the same as using the `reset` function on this object.
+    /// </remarks>
+    Bus& operator=( nullptr_t ) noexcept;
+
+    /// <summary>
+    /// Allow for null checks.
+    /// </summary>
+    bool operator==( nullptr_t ) const noexcept;
+    bool operator!=( nullptr_t ) const noexcept;
+
+    /// <summary>
+    /// Explicit bool conversion allows to check for a valid object.
+    /// </summary>
+    /// <returns>`true` if this object contains a valid pointer to implementation. `false` otherwise.</returns>
+    explicit operator bool() const noexcept;
+
+    /// <summary>
+    /// Get a pointer to the implementation.
+    /// </summary>
+    /// <returns>A pointer to the Bus implementation.</returns>
+    std::shared_ptr<BusImpl> get() const noexcept;
+
+    /// <summary>
+    /// Release the underlying pointer to implementation.
+    /// </summary>
+    void reset() noexcept;
+
+protected:
+    explicit Bus( std::shared_ptr<BusImpl> impl );
+
+private:
+    std::shared_ptr<BusImpl> impl;
+};
+}  // namespace Audio
+
+namespace std
+{
+// Export DLL API to suppress warnings.
+AUDIO_EXTERN template class AUDIO_API shared_ptr<Audio::BusImpl>;
+}  // namespace std
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Effect.hpp"
+
+namespace Audio
+{
+/// <summary>
+/// A dynamic range compressor.
+/// The compressor reduces the volume of a bus when the level of the bus exceeds the threshold.
+/// </summary>
+/// <remarks>
+/// All channels of the bus are compressed by the same amount (based on the loudest channel),
+/// so the stereo image of the bus is preserved.
+/// </remarks>
+class AUDIO_API Compressor : public Effect
+{
+public:
+    /// <summary>
+    /// Create a compressor.
+    /// </summary>
+    /// <param name="threshold">The level (in dB) above which the bus is compressed.</param>
+    /// <param name="ratio">(optional) The compression ratio. Default: 4</param>
+    explicit Compressor( float threshold, float ratio = 4.0f );
+
+    /// <summary>
+    /// Set the level above which the bus is compressed.
+    /// </summary>
+    /// <param name="threshold">The threshold (in dB).</param>
+    void setThreshold( float threshold );
+
+    /// <summary>
+    /// Get the level above which the bus is compressed.
+    /// </summary>
+    /// <returns>The threshold (in dB).</returns>
+    float getThreshold() const;
+
+    /// <summary>
+    /// Set the compression ratio.
+    /// For example, a ratio of 4 means that an increase of 4 dB above the threshold
+    /// only increases the output level by 1 dB.
+    /// </summary>
+    /// <param name="ratio">The compression ratio (1 or higher).</param>
+    void setRatio( float ratio );
+
+    /// <summary>
+    /// Get the compression ratio.
+    /// </summary>
+    /// <returns>The compression ratio.</returns>
+    float getRatio() const;
+
+    /// <summary>
+    /// Set the time it takes the compressor to react to an increase in level.
+    /// </summary>
+    /// <param name="attack">The attack time (in seconds). Default: 0.01</param>
+    void setAttack( float attack );
+
+    /// <summary>
+    /// Get the time it takes the compressor to react to an increase in level.
+    /// </summary>
+    /// <returns>The attack time (in seconds).</returns>
+    float getAttack() const;
+
+    /// <summary>
+    /// Set the time it takes the compressor to recover after the level decreased.
+    /// </summary>
+    /// <param name="release">The release time (in seconds). Default: 0.1</param>
+    void setRelease( float release );
+
+    /// <summary>
+    /// Get the time it takes the compressor to recover after the level decreased.
+    /// </summary>
+    /// <returns>The release time (in seconds).</returns>
+    float getRelease() const;
+
+    /// <summary>
+    /// Set the width of the knee around the threshold.
+    /// A wider knee makes the onset of the compression more gradual.
+    /// </summary>
+    /// <param name="knee">The width of the knee (in dB). Default: 6</param>
+    void setKnee( float knee );
+
+    /// <summary>
+    /// Get the width of the knee around the threshold.
+    /// </summary>
+    /// <returns>The width of the knee (in dB).</returns>
+    float getKnee() const;
+
+    /// <summary>
+    /// Set the gain that is applied after compression.
+    /// </summary>
+    /// <param name="makeupGain">The makeup gain (in dB). Default: 0</param>
+    void setMakeupGain( float makeupGain );
+
+    /// <summary>
+    /// Get the gain that is applied after compression.
+    /// </summary>
+    /// <returns>The makeup gain (in dB).</returns>
+    float getMakeupGain() const;
+
+    Compressor() = default;
+
+protected:
+    explicit Compressor( std::shared_ptr<EffectImpl> impl );
+};
+}  // namespace Audio
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Effect.hpp"
+
+#include <filesystem>
+
+namespace Audio
+{
+/// <summary>
+/// A reverb effect that convolves the audio of a bus with the impulse response of a real (or simulated) room.
+/// </summary>
+/// <remarks>
+/// The impulse response is loaded from an audio file (any file type supported by `Sound`).
+/// Mono impulse responses are applied to every channel. Multichannel impulse responses
+/// are applied per channel.
+///
+/// The start of the impulse response is processed on the audio thread with a short block
+/// size (adding 256 frames of latency to the reverb). The tail of the impulse response
+/// is processed with a much larger block size on a worker thread, so long impulse responses
+/// (several seconds) can be used at a low and constant CPU cost.
+/// </remarks>
+class AUDIO_API ConvolutionReverb : public Effect
+{
+public:
+    /// <summary>
+    /// Create a convolution reverb.
+    /// </summary>
+    /// <param name="impulseResponse">The path to the impulse response file.</param>
+    explicit ConvolutionReverb( const std::filesystem::path& impulseResponse );
+
+    /// <summary>
+    /// Set the level of the reverberated signal.
+    /// </summary>
+    /// <param name="wet">The level of the reverberated signal. Default: 0.5</param>
+    void setWet( float wet );
+
+    /// <summary>
+    /// Get the level of the reverberated signal.
+    /// </summary>
+    /// <returns>The level of the reverberated signal.</returns>
+    float getWet() const;
+
+    /// <summary>
+    /// Set the level of the original (dry) signal.
+    /// Use 0 when the reverb is used on a bus that only receives sends.
+    /// </summary>
+    /// <param name="dry">The level of the original signal. Default: 1</param>
+    void setDry( float dry );
+
+    /// <summary>
+    /// Get the level of the original (dry) signal.
+    /// </summary>
+    /// <returns>The level of the original signal.</returns>
+    float getDry() const;
+
+    ConvolutionReverb() = default;
+
+protected:
+    explicit ConvolutionReverb( std::shared_ptr<EffectImpl> impl );
+};
+}  // namespace Audio
@@ -1,17 +1,73 @@
 #pragma once
 
+#include "AttenuationCurve.hpp"
+#include "Bus.hpp"
+#include "Compressor.hpp"
 #include "Config.hpp"
+#include "ConvolutionReverb.hpp"
+#include "Ducker.hpp"
+#include "Filter.hpp"
+#include "Limiter.hpp"
 #include "Listener.hpp"
+#include "Portal.hpp"
+#include "Reverb.hpp"
+#include "ReverbZone.hpp"
+#include "Room.hpp"
 #include "Sound.hpp"
+#include "TransformBuffer.hpp"
 #include "Waveform.hpp"
 
 #include <filesystem>
+#include <functional>
+#include <vector>
 
 namespace Audio
 {
 class AUDIO_API Device
 {
 public:
+    /// <summary>
+    /// The speakers of the output (with the standard channel order: front left, front right, center, LFE,
+    /// followed by the back and the side channels).
+    /// </summary>
+    enum class SpeakerLayout
+    {
+        Default,     ///< The channel count of the playback device (stereo for offline rendering).
+        Mono,        ///< A single speaker.
+        Stereo,      ///< Front left and right.
+        Surround51,  ///< Front left, right, center, LFE, and side left and right.
+        Surround71,  ///< Front left, right, center, LFE, back left and right, and side left and right.
+    };
+
+    /// <summary>
+    /// An occlusion query of a sound (see `setOcclusionCallback`).
+    /// </summary>
+    struct OcclusionQuery
+    {
+        /// <summary>
+        /// The position of the listener of the sound.
+        /// </summary>
+        Vector listener;
+
+        /// <summary>
+        /// The position of the sound.
+        /// </summary>
+        Vector emitter;
+
+        /// <summary>
+        /// The occlusion and obstruction (in the range [0 .. 1]) of the sound. These are the results of the
+        /// previous query of the sound when the callback is called, and the callback sets the new results.
+        /// </summary>
+        float occlusion;
+        float obstruction;
+    };
+
+    /// <summary>
+    /// A batch raycast function that computes the occlusion of each query (for example, by casting rays from the
+    /// listener to the emitter with the physics engine). The callback is called on a worker thread.
+    /// </summary>
+    using OcclusionCallback = std::function<void( OcclusionQuery* queries, size_t count )>;
+
     /// <summary>
     /// Set the master volume for the audio device. A value of 0 is silent,
     /// a value of 1 is 100% volume and a value over 1 is amplification.
@@ -19,11 +75,54 @@ public:
     /// <param name="volume">The master volume.</param>
     static void setMasterVolume( float volume );
 
+    /// <summary>
+    /// Set the speaker layout of the output. This must be called before the device is used
+    /// (before any other function of the device, and before any sound is loaded).
+    /// </summary>
+    /// <remarks>
+    /// On multichannel layouts (more than two channels), 3D sounds are panned between the pair of adjacent
+    /// speakers around their direction (vector base amplitude panning), and 2D sounds are up- or downmixed
+    /// to the speakers. HRTF rendering requires a stereo layout.
+    /// </remarks>
+    /// <param name="layout">The speaker layout. Default: `SpeakerLayout::Default`</param>
+    /// <returns>`true` if the layout was set, `false` if the device is already in use.</returns>
+    static bool setSpeakerLayout( SpeakerLayout layout );
+
+    /// <summary>
+    /// Get the speaker layout that was set with `setSpeakerLayout`.
+    /// </summary>
+    /// <returns>The speaker layout.</returns>
+    static SpeakerLayout getSpeakerLayout();
+
+    /// <summary>
+    /// Get the number of output channels.
+    /// </summary>
+    /// <returns>The number of output channels.</returns>
+    static uint32_t getChannelCount();
+
+    /// <summary>
+    /// Render the output offline (without a playback device) with `render`, for example to validate the
+    /// output channels of a speaker layout. This must be called before the device is used.
+    /// </summary>
+    /// <param name="enabled">`true` to render offline, `false` to play to the playback device.</param>
+    /// <param name="sampleRate">(optional) The sample rate of the offline output. Default: 48000</param>
+    /// <returns>`true` if offline rendering was set, `false` if the device is already in use.</returns>
+    static bool setOfflineRendering( bool enabled, uint32_t sampleRate = 48000 );
+
+    /// <summary>
+    /// Render the next frames of the output (only if offline rendering is enabled). The sounds are processed
+    /// exactly as they are for the playback device, so `update` should be called between the calls to `render`.
+    /// </summary>
+    /// <param name="frames">The interleaved output frames (`frameCount` * `getChannelCount` samples).</param>
+    /// <param name="frameCount">The number of frames to render.</param>
+    /// <returns>The number of frames that were rendered.</returns>
+    static uint64_t render( float* frames, uint64_t frameCount );
+
     /// <summary>
     /// Get an audio listener at a particular index.
     /// </summary>
     /// <remarks>
-    /// There is a maximum of 4 listeners at index 0 - 3. Requesting an out-of-range listener
+    /// There is a maximum of 8 listeners at index 0 - 7. Requesting an out-of-range listener
     /// will result in an invalid listener.
     /// </remarks>
     /// <param name="listenerIndex">(optional) The listener index to retrieve. Default: 0</param>
@@ -65,6 +164,215 @@ public:
     /// <returns>The waveform.</returns>
     static Waveform createWaveform( Waveform::Type type, float amplitude, float frequency );
 
+    /// <summary>
+    /// Get one of the built-in buses.
+    /// </summary>
+    /// <param name="type">(optional) The built-in bus to get. Default: Master</param>
+    /// <returns>The built-in bus.</returns>
+    static Bus getBus( Bus::Type type = Bus::Type::Master );
+
+    /// <summary>
+    /// Create a new bus (submix) that mixes into a parent bus.
+    /// </summary>
+    /// <param name="parent">(optional) The parent bus. If no parent is specified, the master bus is used.</param>
+    /// <returns>The new bus.</returns>
+    static Bus createBus( const Bus& parent = {} );
+
+    /// <summary>
+    /// Create a buffer of transforms that sounds can be attached to (see `Sound::setTransform`).
+    /// </summary>
+    /// <param name="slotCount">The number of transforms in the buffer.</param>
+    /// <returns>The transform buffer.</returns>
+    static TransformBuffer createTransformBuffer( uint32_t slotCount );
+
+    /// <summary>
+    /// Create an attenuation curve from a set of points (see `Sound::setAttenuationCurve`).
+    /// </summary>
+    /// <param name="points">The points (distance, gain) of the curve. The points don't have to be sorted.</param>
+    /// <param name="count">The number of points.</param>
+    /// <param name="interpolation">(optional) How the gain is interpolated between the points. Default: Linear</param>
+    /// <returns>The attenuation curve.</returns>
+    static AttenuationCurve createAttenuationCurve( const AttenuationCurve::Point* points, size_t count, AttenuationCurve::Interpolation interpolation = AttenuationCurve::Interpolation::Linear );
+
+    /// <summary>
+    /// Load an attenuation curve from a text file. Each line of the file holds one point (the distance and the gain,
+    /// separated by whitespace or a comma). Empty lines and lines that start with `#` are skipped.
+    /// </summary>
+    /// <param name="filePath">The path to the curve file.</param>
+    /// <param name="interpolation">(optional) How the gain is interpolated between the points. Default: Linear</param>
+    /// <returns>The attenuation curve, or an empty curve if the file could not be loaded.</returns>
+    static AttenuationCurve loadAttenuationCurve( const std::filesystem::path& filePath, AttenuationCurve::Interpolation interpolation = AttenuationCurve::Interpolation::Linear );
+
+    /// <summary>
+    /// Create a filter effect.
+    /// </summary>
+    /// <param name="type">The function type for the filter.</param>
+    /// <param name="frequency">The cutoff (or center) frequency (in Hz) of the filter.</param>
+    /// <param name="q">The quality factor of the filter.</param>
+    /// <param name="gainDB">The gain (in dB) for the Peak, LowShelf, and HighShelf filters.</param>
+    /// <returns>The filter.</returns>
+    static Filter createFilter( Filter::Type type, float frequency, float q, float gainDB );
+
+    /// <summary>
+    /// Create a convolution reverb effect.
+    /// </summary>
+    /// <param name="impulseResponse">The path to the impulse response file.</param>
+    /// <returns>The convolution reverb.</returns>
+    static ConvolutionReverb createConvolutionReverb( const std::filesystem::path& impulseResponse );
+
+    /// <summary>
+    /// Create an algorithmic reverb effect.
+    /// </summary>
+    /// <param name="roomSize">The size of the room (in the range [0 .. 1]).</param>
+    /// <param name="decayTime">The time (in seconds) it takes the reverb to decay by 60 dB.</param>
+    /// <returns>The reverb.</returns>
+    static Reverb createReverb( float roomSize, float decayTime );
+
+    /// <summary>
+    /// Create a reverb zone that drives the sends to a shared reverb bus (see `ReverbZone` and `Bus::setZoneSends`).
+    /// The zone is a sphere with a radius of 0 until its shape is set.
+    /// </summary>
+    /// <param name="reverbBus">The reverb bus that the zone sends to.</param>
+    /// <param name="reverb">(optional) The reverb effect (on the reverb bus) whose parameters are set by the zone (see `ReverbZone::setReverb`).</param>
+    /// <returns>The reverb zone.</returns>
+    static ReverbZone createReverbZone( const Bus& reverbBus, const Reverb& reverb = {} );
+
+    /// <summary>
+    /// Create a box-shaped room for early reflections (see `Room` and `Bus::setRoom`).
+    /// </summary>
+    /// <param name="center">The center of the room.</param>
+    /// <param name="halfExtents">Half of the size of the room along each axis.</param>
+    /// <returns>The room.</returns>
+    static Room createRoom( const Vector& center, const Vector& halfExtents );
+
+    /// <summary>
+    /// Create a portal (like a doorway) between two rooms, or between a room and the outside (see `Portal`
+    /// and `Sound::setPortalPropagation`).
+    /// </summary>
+    /// <param name="roomA">The room on one side of the portal.</param>
+    /// <param name="roomB">The room on the other side of the portal (or an empty room for the outside).</param>
+    /// <param name="center">The center of the portal.</param>
+    /// <param name="halfExtents">Half of the size of the portal along each axis.</param>
+    /// <returns>The portal.</returns>
+    static Portal createPortal( const Room& roomA, const Room& roomB, const Vector& center, const Vector& halfExtents );
+
+    /// <summary>
+    /// Create a compressor effect.
+    /// </summary>
+    /// <param name="threshold">The level (in dB) above which the bus is compressed.</param>
+    /// <param name="ratio">The compression ratio.</param>
+    /// <returns>The compressor.</returns>
+    static Compressor createCompressor( float threshold, float ratio );
+
+    /// <summary>
+    /// Create a lookahead limiter effect.
+    /// </summary>
+    /// <param name="threshold">The maximum level (in dB) of the output.</param>
+    /// <param name="lookahead">The lookahead time (in seconds).</param>
+    /// <returns>The limiter.</returns>
+    static Limiter createLimiter( float threshold, float lookahead );
+
+    /// <summary>
+    /// Create a sidechain ducker effect.
+    /// </summary>
+    /// <param name="sidechain">The bus that drives the ducker.</param>
+    /// <param name="reduction">The gain (in dB) that is applied while the sidechain is playing.</param>
+    /// <returns>The ducker.</returns>
+    static Ducker createDucker( const Bus& sidechain, float reduction );
+
+    /// <summary>
+    /// Update the occlusion and obstruction of many sounds at once.
+    /// This is equivalent to calling `Sound::setOcclusion` for each sound, but avoids
+    /// the per-call overhead when thousands of sounds are updated every frame.
+    /// </summary>
+    /// <param name="sounds">The sounds to update.</param>
+    /// <param name="occlusion">The occlusion (in the range [0 .. 1]) of each sound.</param>
+    /// <param name="obstruction">The obstruction (in the range [0 .. 1]) of each sound (or `nullptr` for no obstruction).</param>
+    /// <param name="count">The number of sounds to update.</param>
+    static void setOcclusion( const Sound* sounds, const float* occlusion, const float* obstruction, size_t count );
+
+    /// <summary>
+    /// Set the callback that computes the occlusion of the sounds that have occlusion queries enabled
+    /// (see `Sound::setOcclusionQuery`). The queries of a batch are collected in `update`, and the callback
+    /// is called with the batch on a worker thread (the next batch is started when the callback returns).
+    /// Near and loud sounds are queried more often than far and quiet sounds. The results are smoothed
+    /// over about 0.1 seconds before they are applied to the sounds.
+    /// </summary>
+    /// <param name="callback">The batch raycast function, or `nullptr` to stop the queries.</param>
+    /// <param name="maxRate">The number of queries per second of the loudest sounds.</param>
+    /// <param name="minRate">The number of queries per second of the quietest sounds.</param>
+    static void setOcclusionCallback( OcclusionCallback callback, float maxRate = 30.0f, float minRate = 2.0f );
+
+    /// <summary>
+    /// Update the device. Call this once per frame (after the sounds and listeners have been moved)
+    /// to update the clusters of the buses that have clustering enabled, to select the sounds
+    /// that are rendered with the HRTF, to update the spatial grid for the sounds that are
+    /// attached to a transform buffer, to update the sends of the reverb zones, to find the
+    /// paths through the portals, and to start the occlusion queries.
+    /// </summary>
+    static void update();
+
+    /// <summary>
+    /// Find the 3D sounds around a listener, sorted by their estimated loudness (loudest first).
+    /// The positions of the sounds are kept in a spatial grid, so only the sounds that are close
+    /// to the listener are visited. Use this to decide which sounds to play (or to stop) when
+    /// there are more sounds than can be played at once.
+    /// </summary>
+    /// <remarks>
+    /// The loudness is estimated from the volume and the distance attenuation of each sound
+    /// (cones, occlusion, and the volume of the bus are ignored). Sounds that are attenuated to
+    /// silence, or that are pinned to another listener, are not returned. Sounds are returned
+    /// whether or not they are playing.
+    /// </remarks>
+    /// <param name="listenerIndex">The index of the listener.</param>
+    /// <param name="radius">The maximum distance between a sound and the listener.</param>
+    /// <param name="maxCount">The maximum number of sounds to return.</param>
+    /// <returns>The (at most `maxCount`) loudest sounds within `radius` of the listener.</returns>
+    static std::vector<Sound> getAudibleSounds( uint32_t listenerIndex, float radius, size_t maxCount );
+
+    /// <summary>
+    /// Set the size of the cells of the spatial grid that is used by `getAudibleSounds`.
+    /// For the best performance, the cell size should be about the same as the typical search radius.
+    /// </summary>
+    /// <param name="cellSize">The size of the cells (in world units). Default: 16</param>
+    static void setEmitterGridCellSize( float cellSize );
+
+    /// <summary>
+    /// Load a head-related transfer function (HRTF) for binaural rendering of 3D sounds
+    /// (see `Sound::setSpatialization`).
+    /// </summary>
+    /// <remarks>
+    /// The HRTF is loaded from a directory of stereo WAV files (one head-related impulse response
+    /// for the left and the right ear per file). The direction of each impulse response is encoded
+    /// in the file name as `e<elevation>a<azimuth>` (in degrees, the azimuth is clockwise from the
+    /// front), like the MIT KEMAR set (for example, `H-10e090a.wav`). If only one hemisphere is
+    /// measured, it is mirrored to the other hemisphere.
+    /// Loading another HRTF replaces the current HRTF on the next `Device::update`.
+    /// </remarks>
+    /// <param name="directory">The directory that contains the impulse responses.</param>
+    /// <returns>`true` if the HRTF was loaded, `false` otherwise.</returns>
+    static bool loadHrtf( const std::filesystem::path& directory );
+
+    /// <summary>
+    /// Set the maximum number of sounds that are rendered with the HRTF at the same time.
+    /// The loudest sounds are rendered with the HRTF, the other sounds fall back to panning.
+    /// </summary>
+    /// <param name="voiceLimit">The maximum number of HRTF voices. Default: 16</param>
+    static void setHrtfVoiceLimit( uint32_t voiceLimit );
+
+    /// <summary>
+    /// Set the speed of sound that is used to delay the sounds that have a propagation delay
+    /// (see `Sound::setPropagationDelay`).
+    /// </summary>
+    /// <param name="speedOfSound">The speed of sound (in world units per second). Default: 343.3 (meters per second in air)</param>
+    static void setSpeedOfSound( float speedOfSound );
+
+    /// <summary>
+    /// Get the speed of sound that is used to delay sounds.
+    /// </summary>
+    /// <returns>The speed of sound (in world units per second).</returns>
+    static float getSpeedOfSound();
+
     // Singleton class.
     Device()                           = delete;
     ~Device()                          = delete;
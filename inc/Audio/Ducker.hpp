@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Bus.hpp"
+#include "Config.hpp"
+#include "Effect.hpp"
+
+namespace Audio
+{
+/// <summary>
+/// A sidechain ducker.
+/// The ducker lowers the volume of the bus it is added to while another bus (the sidechain) is playing.
+/// For example, add a ducker to the music bus with the voice bus as the sidechain to lower the
+/// music while dialog is playing.
+/// </summary>
+/// <remarks>
+/// The level of the sidechain bus is measured on the audio thread, so the volume changes are
+/// sample accurate and free of zipper noise. The sidechain bus is still heard through its parent bus.
+/// The sidechain bus cannot be a bus that the ducked bus feeds into (for example, the master bus).
+/// </remarks>
+class AUDIO_API Ducker : public Effect
+{
+public:
+    /// <summary>
+    /// Create a ducker.
+    /// </summary>
+    /// <param name="sidechain">The bus that drives the ducker.</param>
+    /// <param name="reduction">(optional) The gain (in dB) that is applied while the sidechain is playing. Default: -12</param>
+    explicit Ducker( const Bus& sidechain, float reduction = -12.0f );
+
+    /// <summary>
+    /// Set the bus that drives the ducker.
+    /// </summary>
+    /// <param name="sidechain">The sidechain bus (or an empty bus to disable ducking).</param>
+    void setSidechain( const Bus& sidechain );
+
+    /// <summary>
+    /// Get the bus that drives the ducker.
+    /// </summary>
+    /// <returns>The sidechain bus.</returns>
+    Bus getSidechain() const;
+
+    /// <summary>
+    /// Set the level of the sidechain above which the bus is ducked.
+    /// </summary>
+    /// <param name="threshold">The threshold (in dB). Default: -40</param>
+    void setThreshold( float threshold );
+
+    /// <summary>
+    /// Get the level of the sidechain above which the bus is ducked.
+    /// </summary>
+    /// <returns>The threshold (in dB).</returns>
+    float getThreshold() const;
+
+    /// <summary>
+    /// Set the gain that is applied while the sidechain is playing.
+    /// </summary>
+    /// <param name="reduction">The gain reduction (in dB).</param>
+    void setReduction( float reduction );
+
+    /// <summary>
+    /// Get the gain that is applied while the sidechain is playing.
+    /// </summary>
+    /// <returns>The gain reduction (in dB).</returns>
+    float getReduction() const;
+
+    /// <summary>
+    /// Set the time it takes to lower the volume after the sidechain starts playing.
+    /// </summary>
+    /// <param name="attack">The attack time (in seconds). Default: 0.05</param>
+    void setAttack( float attack );
+
+    /// <summary>
+    /// Get the time it takes to lower the volume after the sidechain starts playing.
+    /// </summary>
+    /// <returns>The attack time (in seconds).</returns>
+    float getAttack() const;
+
+    /// <summary>
+    /// Set the time it takes to restore the volume after the sidechain stops playing.
+    /// </summary>
+    /// <param name="release">The release time (in seconds). Default: 0.5</param>
+    void setRelease( float release );
+
+    /// <summary>
+    /// Get the time it takes to restore the volume after the sidechain stops playing.
+    /// </summary>
+    /// <returns>The release time (in seconds).</returns>
+    float getRelease() const;
+
+    Ducker() = default;
+
+protected:
+    explicit Ducker( std::shared_ptr<EffectImpl> impl );
+};
+}  // namespace Audio
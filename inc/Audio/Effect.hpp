@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Config.hpp"
+
+#include <memory>
+
+namespace Audio
+{
+class EffectImpl;
+
+/// <summary>
+/// An effect processes the audio of a Bus.
+/// Effects are added to the effect chain of a bus using `Bus::addEffect`
+/// and are processed once for the mix of all sounds that play on that bus.
+/// </summary>
+/// <remarks>
+/// An effect can only be part of the effect chain of a single bus at a time.
+/// </remarks>
+class AUDIO_API Effect
+{
+public:
+    Effect();
+    virtual ~Effect();
+    Effect( const Effect& );
+    Effect( Effect&& ) noexcept;
+    Effect& operator=( const Effect& );
+    Effect& operator=( Effect&& ) noexcept;
+
+    /// <summary>
+    /// Allow nullptr assignment.
+    /// </summary>
+    /// <remarks>
+    /// Assigning `nullptr` will release the underlying implementation.
+    /// This is the same as using the `reset` function on this object.
+    /// </remarks>
+    Effect& operator=( nullptr_t ) noexcept;
+
+    /// <summary>
+    /// Allow for null checks.
+    /// </summary>
+    bool operator==( nullptr_t ) const noexcept;
+    bool operator!=( nullptr_t ) const noexcept;
+
+    /// <summary>
+    /// Explicit bool conversion allows to check for a valid object.
+    /// </summary>
+    /// <returns>`true` if this object contains a valid pointer to implementation. `false` otherwise.</returns>
+    explicit operator bool() const noexcept;
+
+    /// <summary>
+    /// Get a pointer to the implementation.
+    /// </summary>
+    /// <returns>A pointer to the Effect implementation.</returns>
+    std::shared_ptr<EffectImpl> get() const noexcept;
+
+    /// <summary>
+    /// Release the underlying pointer to implementation.
+    /// </summary>
+    void reset() noexcept;
+
+protected:
+    explicit Effect( std::shared_ptr<EffectImpl> impl );
+
+private:
+    std::shared_ptr<EffectImpl> impl;
+};
+}  // namespace Audio
+
+namespace std
+{
+// Export DLL API to suppress warnings.
+AUDIO_EXTERN template class AUDIO_API shared_ptr<Audio::EffectImpl>;
+}  // namespace std
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Effect.hpp"
+
+namespace Audio
+{
+/// <summary>
+/// A second-order (biquad) filter effect.
+/// Filters can be used to equalize a bus or to remove frequencies from a bus.
+/// </summary>
+class AUDIO_API Filter : public Effect
+{
+public:
+    /// <summary>
+    /// Filter function.
+    /// </summary>
+    enum class Type
+    {
+        LowPass,    ///< Remove frequencies above the cutoff frequency.
+        HighPass,   ///< Remove frequencies below the cutoff frequency.
+        BandPass,   ///< Only keep the frequencies around the center frequency.
+        Notch,      ///< Remove the frequencies around the center frequency.
+        Peak,       ///< Boost or cut the frequencies around the center frequency (parametric EQ).
+        LowShelf,   ///< Boost or cut the frequencies below the cutoff frequency.
+        HighShelf,  ///< Boost or cut the frequencies above the cutoff frequency.
+    };
+
+    /// <summary>
+    /// Construct a filter.
+    /// </summary>
+    /// <param name="type">The function type for the filter.</param>
+    /// <param name="frequency">The cutoff (or center) frequency (in Hz) of the filter.</param>
+    /// <param name="q">(optional) The quality factor of the filter. Default: 0.707</param>
+    /// <param name="gainDB">(optional) The gain (in dB) for the Peak, LowShelf, and HighShelf filters. Default: 0</param>
+    explicit Filter( Type type, float frequency, float q = 0.707f, float gainDB = 0.0f );
+
+    /// <summary>
+    /// Set the function type for the filter.
+    /// </summary>
+    /// <param name="type">The type of the filter.</param>
+    void setType( Type type );
+
+    /// <summary>
+    /// Get the function type for this filter.
+    /// </summary>
+    /// <returns>The filter type.</returns>
+    Type getType() const;
+
+    /// <summary>
+    /// Set the cutoff (or center) frequency (in Hz) of the filter.
+    /// </summary>
+    /// <param name="frequency">The cutoff frequency (in Hz).</param>
+    void setFrequency( float frequency );
+
+    /// <summary>
+    /// Get the cutoff (or center) frequency (in Hz) of the filter.
+    /// </summary>
+    /// <returns>The cutoff frequency (in Hz).</returns>
+    float getFrequency() const;
+
+    /// <summary>
+    /// Set the quality factor of the filter.
+    /// Higher values result in a narrower band or a more resonant cutoff.
+    /// </summary>
+    /// <param name="q">The quality factor of the filter.</param>
+    void setQ( float q );
+
+    /// <summary>
+    /// Get the quality factor of the filter.
+    /// </summary>
+    /// <returns>The quality factor of the filter.</returns>
+    float getQ() const;
+
+    /// <summary>
+    /// Set the gain (in dB) of the filter.
+    /// Only used by the Peak, LowShelf, and HighShelf filters.
+    /// </summary>
+    /// <param name="gainDB">The gain (in dB).</param>
+    void setGain( float gainDB );
+
+    /// <summary>
+    /// Get the gain (in dB) of the filter.
+    /// </summary>
+    /// <returns>The gain (in dB).</returns>
+    float getGain() const;
+
+    Filter() = default;
+
+protected:
+    explicit Filter( std::shared_ptr<EffectImpl> impl );
+};
+}  // namespace Audio
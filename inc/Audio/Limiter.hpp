@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Effect.hpp"
+
+namespace Audio
+{
+/// <summary>
+/// A lookahead brickwall limiter.
+/// The limiter guarantees that the level of the bus never exceeds the threshold.
+/// Add a limiter to the master bus to prevent the output from clipping.
+/// </summary>
+/// <remarks>
+/// The limiter delays the audio by the lookahead time, so the volume can be reduced
+/// smoothly before a peak arrives (instead of distorting the peak).
+/// </remarks>
+class AUDIO_API Limiter : public Effect
+{
+public:
+    /// <summary>
+    /// Create a limiter.
+    /// </summary>
+    /// <param name="threshold">The maximum level (in dB) of the output.</param>
+    /// <param name="lookahead">(optional) The lookahead time (in seconds, in the range [0.001 .. 0.05]). Default: 0.005</param>
+    explicit Limiter( float threshold, float lookahead = 0.005f );
+
+    /// <summary>
+    /// Set the maximum level of the output.
+    /// </summary>
+    /// <param name="threshold">The threshold (in dB).</param>
+    void setThreshold( float threshold );
+
+    /// <summary>
+    /// Get the maximum level of the output.
+    /// </summary>
+    /// <returns>The threshold (in dB).</returns>
+    float getThreshold() const;
+
+    /// <summary>
+    /// Set the time it takes the limiter to recover after a peak.
+    /// </summary>
+    /// <param name="release">The release time (in seconds). Default: 0.1</param>
+    void setRelease( float release );
+
+    /// <summary>
+    /// Get the time it takes the limiter to recover after a peak.
+    /// </summary>
+    /// <returns>The release time (in seconds).</returns>
+    float getRelease() const;
+
+    /// <summary>
+    /// Get the lookahead time of the limiter.
+    /// This is also the latency that is added by the limiter.
+    /// </summary>
+    /// <returns>The lookahead time (in seconds).</returns>
+    float getLookahead() const;
+
+    Limiter() = default;
+
+protected:
+    explicit Limiter( std::shared_ptr<EffectImpl> impl );
+};
+}  // namespace Audio
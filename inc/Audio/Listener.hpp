@@ -3,6 +3,7 @@
 #include "Config.hpp"
 #include "Vector.hpp"
 
+#include <chrono>
 #include <memory>
 
 namespace Audio
@@ -24,6 +25,42 @@ public:
     /// <returns>The position of the listener.</returns>
     Vector getPosition() const;
 
+    /// <summary>
+    /// Set the global (world) position of the listener at a point in time, and derive the velocity
+    /// of the listener (for the doppler effect) from the previous timestamped position.
+    /// </summary>
+    /// <remarks>
+    /// The timestamps can use any clock (for example, the simulation time of the game), as long as
+    /// they increase. Positions that are not newer than the previous position are ignored. The velocity
+    /// is zero for the first position, and after a gap of more than half a second.
+    /// </remarks>
+    /// <typeparam name="Rep">The representation of the duration.</typeparam>
+    /// <typeparam name="Period">The duration period.</typeparam>
+    /// <param name="pos">The position of the listener.</param>
+    /// <param name="time">The time of the position.</param>
+    template<class Rep, class Period = std::ratio<1>>
+    void setPosition( const Vector& pos, const std::chrono::duration<Rep, Period>& time );
+
+    /// <summary>
+    /// Set the global (world) position of the listener at a point in time, and derive the velocity
+    /// of the listener from the previous timestamped position.
+    /// </summary>
+    /// <param name="pos">The position of the listener.</param>
+    /// <param name="seconds">The time of the position (in seconds).</param>
+    void setPosition( const Vector& pos, double seconds );
+
+    /// <summary>
+    /// Set the velocity of the listener (for the doppler effect).
+    /// </summary>
+    /// <param name="vel">The velocity of the listener.</param>
+    void setVelocity( const Vector& vel );
+
+    /// <summary>
+    /// Get the velocity of the listener.
+    /// </summary>
+    /// <returns>The velocity of the listener.</returns>
+    Vector getVelocity() const;
+
     /// <summary>
     /// Set the forward direction vector of the listener.
     /// </summary>
@@ -116,6 +153,12 @@ protected:
 private:
     std::shared_ptr<ListenerImpl> impl;
 };
+
+template<class Rep, class Period>
+void Listener::setPosition( const Vector& pos, const std::chrono::duration<Rep, Period>& time )
+{
+    setPosition( pos, std::chrono::duration_cast<std::chrono::duration<double>>( time ).count() );
+}
 }  // namespace Audio
 
 namespace std
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Vector.hpp"
+
+#include <memory>
+
+namespace Audio
+{
+class PortalImpl;
+
+/// <summary>
+/// An opening (like a doorway or a window) that connects two rooms (or a room and the outside).
+/// Sounds that have portal propagation enabled (see `Sound::setPortalPropagation`) are heard through
+/// the portals when they are not in the same room as the listener.
+/// </summary>
+/// <remarks>
+/// The rooms and the portals form a graph. The shortest acoustic path from each listener to each sound
+/// is found on a worker thread (in `Device::update`), and the audio thread moves each sound to its
+/// apparent position: in the direction of the first portal on the path (as seen from the listener),
+/// at the length of the path. The sound is occluded by the portals that are (partially) closed, and
+/// obstructed by the bend of the path. Rooms are found by their box (the smallest room that contains a
+/// position), and positions that are not in a room are outside.
+/// </remarks>
+class AUDIO_API Portal
+{
+public:
+    /// <summary>
+    /// Set the bounds of the opening.
+    /// </summary>
+    /// <param name="center">The center of the portal.</param>
+    /// <param name="halfExtents">Half of the size of the portal along each axis.</param>
+    void setBox( const Vector& center, const Vector& halfExtents );
+
+    /// <summary>
+    /// Set how far this portal is open. A closed portal (like a closed door) still transmits sound,
+    /// but fully occludes it. Paths through open portals are preferred.
+    /// </summary>
+    /// <param name="openness">The openness (in the range [0 .. 1]). Default: 1</param>
+    void setOpenness( float openness );
+
+    /// <summary>
+    /// Get how far this portal is open.
+    /// </summary>
+    /// <returns>The openness (in the range [0 .. 1]).</returns>
+    float getOpenness() const;
+
+    Portal();
+    ~Portal();
+    Portal( const Portal& );
+    Portal( Portal&& ) noexcept;
+    Portal& operator=( const Portal& );
+    Portal& operator=( Portal&& ) noexcept;
+
+    /// <summary>
+    /// Allow nullptr assignment.
+    /// </summary>
+    /// <remarks>
+    /// Assigning `nullptr` will release the underlying implementation.
+    /// This is the same as using the `reset` function on this object.
+    /// </remarks>
+    Portal& operator=( nullptr_t ) noexcept;
+
+    /// <summary>
+    /// Allow for null checks.
+    /// </summary>
+    bool operator==( nullptr_t ) const noexcept;
+    bool operator!=( nullptr_t ) const noexcept;
+
+    /// <summary>
+    /// Explicit bool conversion allows to check for a valid object.
+    /// </summary>
+    /// <returns>`true` if this object contains a valid pointer to implementation. `false` otherwise.</returns>
+    explicit operator bool() const noexcept;
+
+    /// <summary>
+    /// Get the pointer to the implementation.
+    /// </summary>
+    /// <returns>The pointer to the portal implementation.</returns>
+    std::shared_ptr<PortalImpl> get() const noexcept;
+
+    /// <summary>
+    /// Release the underlying pointer to implementation. The portal is removed once all copies are released.
+    /// </summary>
+    void reset() noexcept;
+
+protected:
+    Portal( std::shared_ptr<PortalImpl> impl );
+
+private:
+    std::shared_ptr<PortalImpl> impl;
+};
+}  // namespace Audio
+
+namespace std
+{
+// Export DLL API to suppress warnings.
+AUDIO_EXTERN template class AUDIO_API shared_ptr<Audio::PortalImpl>;
+}  // namespace std
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Effect.hpp"
+
+namespace Audio
+{
+/// <summary>
+/// A lightweight algorithmic reverb (8-line feedback delay network).
+/// </summary>
+/// <remarks>
+/// The reverb is cheap enough to run on low-end hardware, but it is most efficient
+/// when used as a shared send effect: create a bus with a reverb (with the dry level set to 0)
+/// and use `Bus::setSend` to send other buses to it. All the sounds on those buses are
+/// then reverberated by a single reverb instance.
+/// </remarks>
+class AUDIO_API Reverb : public Effect
+{
+public:
+    /// <summary>
+    /// Create a reverb.
+    /// </summary>
+    /// <param name="roomSize">The size of the room (in the range [0 .. 1]).</param>
+    /// <param name="decayTime">(optional) The time (in seconds) it takes the reverb to decay by 60 dB. Default: 1.5</param>
+    explicit Reverb( float roomSize, float decayTime = 1.5f );
+
+    /// <summary>
+    /// Set the size of the room.
+    /// Larger rooms have longer delays between reflections.
+    /// </summary>
+    /// <param name="roomSize">The size of the room (in the range [0 .. 1]).</param>
+    void setRoomSize( float roomSize );
+
+    /// <summary>
+    /// Get the size of the room.
+    /// </summary>
+    /// <returns>The size of the room (in the range [0 .. 1]).</returns>
+    float getRoomSize() const;
+
+    /// <summary>
+    /// Set the time it takes the reverb to decay by 60 dB.
+    /// </summary>
+    /// <param name="decayTime">The decay time (in seconds).</param>
+    void setDecayTime( float decayTime );
+
+    /// <summary>
+    /// Get the time it takes the reverb to decay by 60 dB.
+    /// </summary>
+    /// <returns>The decay time (in seconds).</returns>
+    float getDecayTime() const;
+
+    /// <summary>
+    /// Set the damping of high frequencies.
+    /// Higher values make the reverb sound darker (like a room with soft surfaces).
+    /// </summary>
+    /// <param name="damping">The damping (in the range [0 .. 1]). Default: 0.5</param>
+    void setDamping( float damping );
+
+    /// <summary>
+    /// Get the damping of high frequencies.
+    /// </summary>
+    /// <returns>The damping (in the range [0 .. 1]).</returns>
+    float getDamping() const;
+
+    /// <summary>
+    /// Set the delay before the reverb starts.
+    /// </summary>
+    /// <param name="preDelay">The pre-delay (in seconds, at most 0.25 seconds). Default: 0.02</param>
+    void setPreDelay( float preDelay );
+
+    /// <summary>
+    /// Get the delay before the reverb starts.
+    /// </summary>
+    /// <returns>The pre-delay (in seconds).</returns>
+    float getPreDelay() const;
+
+    /// <summary>
+    /// Set the level of the reverberated signal.
+    /// </summary>
+    /// <param name="wet">The level of the reverberated signal. Default: 0.5</param>
+    void setWet( float wet );
+
+    /// <summary>
+    /// Get the level of the reverberated signal.
+    /// </summary>
+    /// <returns>The level of the reverberated signal.</returns>
+    float getWet() const;
+
+    /// <summary>
+    /// Set the level of the original (dry) signal.
+    /// Use 0 when the reverb is used on a bus that only receives sends.
+    /// </summary>
+    /// <param name="dry">The level of the original signal. Default: 1</param>
+    void setDry( float dry );
+
+    /// <summary>
+    /// Get the level of the original (dry) signal.
+    /// </summary>
+    /// <returns>The level of the original signal.</returns>
+    float getDry() const;
+
+    Reverb() = default;
+
+protected:
+    explicit Reverb( std::shared_ptr<EffectImpl> impl );
+};
+}  // namespace Audio
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Vector.hpp"
+
+#include <memory>
+
+namespace Audio
+{
+class ReverbZoneImpl;
+
+/// <summary>
+/// A volume (a box or a sphere) in the world that drives a shared reverb bus while a listener is inside of it.
+/// </summary>
+/// <remarks>
+/// Reverb zones are evaluated once per listener per frame (in `Device::update`), not per sound: the zones around
+/// each listener are found with a grid lookup, and the weight of each zone is 1 inside of the zone and fades to 0
+/// over the fade distance outside of the zone. The buses that have zone sends enabled (see `Bus::setZoneSends`)
+/// send to the reverb bus of each zone at the send level of the zone times its weight for the listener of the bus.
+/// If zones overlap, the reverb bus is sent to at the highest level of the zones that share the bus, and the
+/// parameters of the reverb (if set) are blended by the weights of those zones.
+/// </remarks>
+class AUDIO_API ReverbZone
+{
+public:
+    enum class Shape
+    {
+        Box,     ///< An axis-aligned box.
+        Sphere,  ///< A sphere.
+    };
+
+    /// <summary>
+    /// Make this zone an axis-aligned box.
+    /// </summary>
+    /// <param name="center">The center of the box.</param>
+    /// <param name="halfExtents">Half of the size of the box along each axis.</param>
+    void setBox( const Vector& center, const Vector& halfExtents );
+
+    /// <summary>
+    /// Make this zone a sphere.
+    /// </summary>
+    /// <param name="center">The center of the sphere.</param>
+    /// <param name="radius">The radius of the sphere.</param>
+    void setSphere( const Vector& center, float radius );
+
+    /// <summary>
+    /// Get the shape of this zone.
+    /// </summary>
+    /// <returns>The shape of this zone.</returns>
+    Shape getShape() const;
+
+    /// <summary>
+    /// Set the distance outside of the zone over which the zone fades out.
+    /// </summary>
+    /// <param name="fadeDistance">The fade distance (in world units). Default: 0</param>
+    void setFadeDistance( float fadeDistance );
+
+    /// <summary>
+    /// Get the fade distance of this zone.
+    /// </summary>
+    /// <returns>The fade distance (in world units).</returns>
+    float getFadeDistance() const;
+
+    /// <summary>
+    /// Set the level of the sends to the reverb bus while a listener is inside of this zone.
+    /// </summary>
+    /// <param name="level">The send level. Default: 1</param>
+    void setSendLevel( float level );
+
+    /// <summary>
+    /// Get the send level of this zone.
+    /// </summary>
+    /// <returns>The send level.</returns>
+    float getSendLevel() const;
+
+    /// <summary>
+    /// Set the parameters of the reverb effect of this zone (see `Device::createReverbZone`)
+    /// while a listener is inside of this zone.
+    /// </summary>
+    /// <param name="decayTime">The decay time (in seconds).</param>
+    /// <param name="damping">The damping of high frequencies (in the range [0 .. 1]).</param>
+    void setReverb( float decayTime, float damping );
+
+    /// <summary>
+    /// Get the weight of this zone at a position.
+    /// </summary>
+    /// <param name="position">The position (of a listener).</param>
+    /// <returns>1 inside of the zone, fading to 0 at the fade distance outside of the zone.</returns>
+    float getWeight( const Vector& position ) const;
+
+    ReverbZone();
+    ~ReverbZone();
+    ReverbZone( const ReverbZone& );
+    ReverbZone( ReverbZone&& ) noexcept;
+    ReverbZone& operator=( const ReverbZone& );
+    ReverbZone& operator=( ReverbZone&& ) noexcept;
+
+    /// <summary>
+    /// Allow nullptr assignment.
+    /// </summary>
+    /// <remarks>
+    /// Assigning `nullptr` will release the underlying implementation.
+    /// This is the same as using the `reset` function on this object.
+    /// </remarks>
+    ReverbZone& operator=( nullptr_t ) noexcept;
+
+    /// <summary>
+    /// Allow for null checks.
+    /// </summary>
+    bool operator==( nullptr_t ) const noexcept;
+    bool operator!=( nullptr_t ) const noexcept;
+
+    /// <summary>
+    /// Explicit bool conversion allows to check for a valid object.
+    /// </summary>
+    /// <returns>`true` if this object contains a valid pointer to implementation. `false` otherwise.</returns>
+    explicit operator bool() const noexcept;
+
+    /// <summary>
+    /// Get the pointer to the implementation.
+    /// </summary>
+    /// <returns>The pointer to the reverb zone implementation.</returns>
+    std::shared_ptr<ReverbZoneImpl> get() const noexcept;
+
+    /// <summary>
+    /// Release the underlying pointer to implementation. The zone is removed once all copies are released.
+    /// </summary>
+    void reset() noexcept;
+
+protected:
+    ReverbZone( std::shared_ptr<ReverbZoneImpl> impl );
+
+private:
+    std::shared_ptr<ReverbZoneImpl> impl;
+};
+}  // namespace Audio
+
+namespace std
+{
+// Export DLL API to suppress warnings.
+AUDIO_EXTERN template class AUDIO_API shared_ptr<Audio::ReverbZoneImpl>;
+}  // namespace std
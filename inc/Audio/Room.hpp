@@ -0,0 +1,143 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace Audio
+{
+class RoomImpl;
+
+/// <summary>
+/// A box-shaped (shoebox) room that adds early reflections to the 3D sounds of a bus (see `Bus::setRoom`).
+/// </summary>
+/// <remarks>
+/// The reflections are modeled with image sources: each wall mirrors the sound into an image source, which
+/// is heard after the extra distance it travels, attenuated by the absorption of the wall and by distance.
+/// First order reflections (one per wall) and second order reflections (off two walls) are supported.
+/// The reflections of all sounds of a bus are rendered through a single tapped delay line, and the image sources
+/// of a sound are only recomputed when the sound, the listener, or the room moves. Reflections are only rendered
+/// while both the sound and the listener are inside of the room. Use a reverb for the late reverberation.
+/// </remarks>
+class AUDIO_API Room
+{
+public:
+    /// <summary>
+    /// The walls of the room (by the axis they face).
+    /// </summary>
+    enum class Wall
+    {
+        NegativeX,  ///< The wall at the minimum X coordinate.
+        PositiveX,  ///< The wall at the maximum X coordinate.
+        NegativeY,  ///< The wall at the minimum Y coordinate (the floor).
+        PositiveY,  ///< The wall at the maximum Y coordinate (the ceiling).
+        NegativeZ,  ///< The wall at the minimum Z coordinate.
+        PositiveZ,  ///< The wall at the maximum Z coordinate.
+    };
+
+    /// <summary>
+    /// Set the bounds of the room.
+    /// </summary>
+    /// <param name="center">The center of the room.</param>
+    /// <param name="halfExtents">Half of the size of the room along each axis.</param>
+    void setBox( const Vector& center, const Vector& halfExtents );
+
+    /// <summary>
+    /// Set the absorption of all walls.
+    /// </summary>
+    /// <param name="absorption">The fraction of the energy that is absorbed by a reflection (in the range [0 .. 1]). Default: 0.3</param>
+    void setAbsorption( float absorption );
+
+    /// <summary>
+    /// Set the absorption of a single wall.
+    /// </summary>
+    /// <param name="wall">The wall.</param>
+    /// <param name="absorption">The fraction of the energy that is absorbed by a reflection (in the range [0 .. 1]).</param>
+    void setAbsorption( Wall wall, float absorption );
+
+    /// <summary>
+    /// Get the absorption of a wall.
+    /// </summary>
+    /// <param name="wall">The wall.</param>
+    /// <returns>The absorption of the wall.</returns>
+    float getAbsorption( Wall wall ) const;
+
+    /// <summary>
+    /// Set the order of the reflections: 1 for 6 reflections per sound (one per wall),
+    /// or 2 for 24 reflections per sound (one per wall, and one per pair of walls).
+    /// </summary>
+    /// <param name="order">The reflection order (1 or 2). Default: 2</param>
+    void setOrder( uint32_t order );
+
+    /// <summary>
+    /// Get the order of the reflections.
+    /// </summary>
+    /// <returns>The reflection order.</returns>
+    uint32_t getOrder() const;
+
+    /// <summary>
+    /// Set the level of the reflections (relative to the direct sound).
+    /// </summary>
+    /// <param name="level">The level of the reflections. Default: 1</param>
+    void setLevel( float level );
+
+    /// <summary>
+    /// Get the level of the reflections.
+    /// </summary>
+    /// <returns>The level of the reflections.</returns>
+    float getLevel() const;
+
+    Room();
+    ~Room();
+    Room( const Room& );
+    Room( Room&& ) noexcept;
+    Room& operator=( const Room& );
+    Room& operator=( Room&& ) noexcept;
+
+    /// <summary>
+    /// Allow nullptr assignment.
+    /// </summary>
+    /// <remarks>
+    /// Assigning `nullptr` will release the underlying implementation.
+    /// This is the same as using the `reset` function on this object.
+    /// </remarks>
+    Room& operator=( nullptr_t ) noexcept;
+
+    /// <summary>
+    /// Allow for null checks.
+    /// </summary>
+    bool operator==( nullptr_t ) const noexcept;
+    bool operator!=( nullptr_t ) const noexcept;
+
+    /// <summary>
+    /// Explicit bool conversion allows to check for a valid object.
+    /// </summary>
+    /// <returns>`true` if this object contains a valid pointer to implementation. `false` otherwise.</returns>
+    explicit operator bool() const noexcept;
+
+    /// <summary>
+    /// Get the pointer to the implementation.
+    /// </summary>
+    /// <returns>The pointer to the room implementation.</returns>
+    std::shared_ptr<RoomImpl> get() const noexcept;
+
+    /// <summary>
+    /// Release the underlying pointer to implementation.
+    /// </summary>
+    void reset() noexcept;
+
+protected:
+    Room( std::shared_ptr<RoomImpl> impl );
+
+private:
+    std::shared_ptr<RoomImpl> impl;
+};
+}  // namespace Audio
+
+namespace std
+{
+// Export DLL API to suppress warnings.
+AUDIO_EXTERN template class AUDIO_API shared_ptr<Audio::RoomImpl>;
+}  // namespace std
@@ -1,11 +1,15 @@
 #pragma once
 
+#include "AttenuationCurve.hpp"
+#include "Bus.hpp"
 #include "Config.hpp"
 #include "Listener.hpp"
+#include "TransformBuffer.hpp"
 #include "Vector.hpp"
 
 #include <chrono>
 #include <filesystem>
+#include <limits>
 #include <memory>
 
 namespace Audio
@@ -31,6 +35,27 @@ public:
         Exponential,  ///< Exponential attenuation. Equivalent to OpenAL's AL_EXPONENT_DISTANCE_CLAMPED.
     };
 
+    /// <summary>
+    /// The interpolation that is used to resample a sound when it is pitched
+    /// (or when the sample rate of the sound does not match the sample rate of the device).
+    /// </summary>
+    enum class ResampleQuality
+    {
+        Fast,    ///< Nearest sample. The cheapest, but aliasing is clearly audible. Use for distant or crowd sounds.
+        Linear,  ///< Linear interpolation. Cheap, but high frequencies are dampened and some aliasing is audible.
+        Sinc8,   ///< Windowed sinc interpolation (8 taps). Good quality for most sounds.
+        Sinc32,  ///< Windowed sinc interpolation (32 taps). Transparent, but the most expensive. Use for close or important sounds.
+    };
+
+    /// <summary>
+    /// How a 3D sound is rendered to the output channels.
+    /// </summary>
+    enum class Spatialization
+    {
+        Panning,  ///< Pan the sound between the speakers.
+        Hrtf,     ///< Binaural rendering with the HRTF loaded by `Device::loadHrtf` (for headphones).
+    };
+
     explicit Sound( const std::filesystem::path& filePath, Type type = Type::Sound );
 
     /// <summary>
@@ -131,6 +156,20 @@ public:
     /// <param name="listener">The listener to pin this sound to.</param>
     void setPinnedListener( const Listener& listener );
 
+    /// <summary>
+    /// Set the bus that this sound plays on.
+    /// Sounds loaded with `Device::loadSound` play on the `Bus::Type::Effects` bus
+    /// and sounds loaded with `Device::loadMusic` play on the `Bus::Type::Music` bus by default.
+    /// </summary>
+    /// <param name="bus">The bus to play this sound on.</param>
+    void setBus( const Bus& bus );
+
+    /// <summary>
+    /// Get the bus that this sound plays on.
+    /// </summary>
+    /// <returns>The bus that this sound plays on.</returns>
+    Bus getBus() const;
+
     /// <summary>
     /// Set the volume of this sound.
     /// </summary>
@@ -172,6 +211,62 @@ public:
     /// <returns>The current pitch of this sound.</returns>
     float getPitch() const;
 
+    /// <summary>
+    /// Set the interpolation that is used to resample this sound when it is pitched.
+    /// Use a higher quality for close or important sounds and the cheaper interpolation for
+    /// distant or crowd sounds. Default: `ResampleQuality::Linear`
+    /// </summary>
+    /// <remarks>
+    /// Sounds that are not pitched (and that match the sample rate of the device) are
+    /// not interpolated, regardless of the resample quality.
+    /// </remarks>
+    /// <param name="quality">The resample quality for this sound.</param>
+    void setResampleQuality( ResampleQuality quality );
+
+    /// <summary>
+    /// Get the interpolation that is used to resample this sound.
+    /// </summary>
+    /// <returns>The resample quality for this sound.</returns>
+    ResampleQuality getResampleQuality() const;
+
+    /// <summary>
+    /// Set the distances (from the listener) at which this sound switches to a cheaper level of detail.
+    /// Beyond `monoDistance` the sound is downmixed to mono before it is resampled. Beyond `halfRateDistance`
+    /// (or `quarterRateDistance`) the sound is resampled at half (or a quarter) of the device sample rate and
+    /// upsampled to the device sample rate, which also removes the high frequencies of distant sounds.
+    /// Only spatialized sounds have a level of detail. By default, all distances are infinite (disabled).
+    /// </summary>
+    /// <param name="monoDistance">The distance beyond which the sound is processed in mono.</param>
+    /// <param name="halfRateDistance">The distance beyond which the sound is processed at half rate.</param>
+    /// <param name="quarterRateDistance">(optional) The distance beyond which the sound is processed at a quarter rate. Default: infinity</param>
+    void setLodDistances( float monoDistance, float halfRateDistance, float quarterRateDistance = std::numeric_limits<float>::infinity() );
+
+    /// <summary>
+    /// Get the level of detail distances of this sound.
+    /// </summary>
+    /// <param name="monoDistance">A reference to the distance beyond which the sound is processed in mono.</param>
+    /// <param name="halfRateDistance">A reference to the distance beyond which the sound is processed at half rate.</param>
+    /// <param name="quarterRateDistance">A reference to the distance beyond which the sound is processed at a quarter rate.</param>
+    void getLodDistances( float& monoDistance, float& halfRateDistance, float& quarterRateDistance ) const;
+
+    /// <summary>
+    /// Set how this sound is rendered to the output channels. Default: `Spatialization::Panning`
+    /// </summary>
+    /// <remarks>
+    /// HRTF rendering is expensive, so only the loudest sounds (up to `Device::setHrtfVoiceLimit`)
+    /// are rendered with the HRTF. The other sounds fall back to panning. The rendering is updated
+    /// by `Device::update`. HRTF rendering requires a stereo device and an HRTF loaded with
+    /// `Device::loadHrtf`. Sounds in a cluster (see `Bus::setClustering`) are always panned.
+    /// </remarks>
+    /// <param name="spatialization">The spatialization of this sound.</param>
+    void setSpatialization( Spatialization spatialization );
+
+    /// <summary>
+    /// Get how this sound is rendered to the output channels.
+    /// </summary>
+    /// <returns>The spatialization of this sound.</returns>
+    Spatialization getSpatialization() const;
+
     /// <summary>
     /// Set the position of this spatialized sounds.
     /// </summary>
@@ -184,6 +279,53 @@ public:
     /// <returns>The position of this sound in world space.</returns>
     Vector getPosition() const;
 
+    /// <summary>
+    /// Set the position of this spatialized sound at a point in time, and derive the velocity of
+    /// this sound (for the doppler effect) from the previous timestamped position. This replaces
+    /// calling `setVelocity` for moving sounds.
+    /// </summary>
+    /// <remarks>
+    /// The timestamps can use any clock (for example, the simulation time of the game), as long as
+    /// they increase. Positions that are not newer than the previous position are ignored. The velocity
+    /// is zero for the first position, and after a gap of more than half a second. Setting the position
+    /// without a timestamp starts over (for example, to teleport a sound).
+    /// </remarks>
+    /// <typeparam name="Rep">The representation of the duration.</typeparam>
+    /// <typeparam name="Period">The duration period.</typeparam>
+    /// <param name="position">The position to set this sound to.</param>
+    /// <param name="time">The time of the position.</param>
+    template<class Rep, class Period = std::ratio<1>>
+    void setPosition( const Vector& position, const std::chrono::duration<Rep, Period>& time );
+
+    /// <summary>
+    /// Set the position of this spatialized sound at a point in time, and derive the velocity of
+    /// this sound from the previous timestamped position.
+    /// </summary>
+    /// <param name="position">The position to set this sound to.</param>
+    /// <param name="seconds">The time of the position (in seconds).</param>
+    void setPosition( const Vector& position, double seconds );
+
+    /// <summary>
+    /// Smooth the motion of this sound between timestamped positions (see `setPosition`).
+    /// When the positions are updated less often than the audio is rendered (for example, by a
+    /// simulation that ticks at 20 Hz), the sound moves in steps, and the panning and the doppler
+    /// effect zipper. With interpolation, the audio thread moves the sound from the position that
+    /// is rendered to the new position over the time between the last two timestamps, and keeps
+    /// moving the sound with its velocity if the next position is late.
+    /// </summary>
+    /// <remarks>
+    /// The interpolated motion lags one update behind the positions that are set. Positions that
+    /// are set without a timestamp are applied immediately.
+    /// </remarks>
+    /// <param name="enabled">`true` to interpolate the positions of this sound, `false` to apply them immediately.</param>
+    void setPositionInterpolation( bool enabled );
+
+    /// <summary>
+    /// Check if the positions of this sound are interpolated.
+    /// </summary>
+    /// <returns>`true` if the positions are interpolated, `false` otherwise.</returns>
+    bool getPositionInterpolation() const;
+
     /// <summary>
     /// Set the forward direction of this spatialized sounds.
     /// </summary>
@@ -208,6 +350,20 @@ public:
     /// <returns>The velocity of this sound.</returns>
     Vector getVelocity() const;
 
+    /// <summary>
+    /// Attach this sound to a slot of a transform buffer. The position, direction, and velocity of
+    /// the sound are read from the slot by the audio thread at the start of every audio period
+    /// (see `TransformBuffer`), so they don't have to be set every frame.
+    /// </summary>
+    /// <remarks>
+    /// While the sound is attached, the transform in the slot overrides `setPosition`, `setDirection`,
+    /// and `setVelocity`. The position of the sound in the spatial grid (see `Device::getAudibleSounds`)
+    /// is updated by `Device::update`.
+    /// </remarks>
+    /// <param name="buffer">The transform buffer, or an empty buffer to detach this sound.</param>
+    /// <param name="slot">The slot of this sound in the buffer.</param>
+    void setTransform( const TransformBuffer& buffer, uint32_t slot );
+
     /// <summary>
     /// Set the cone used to control attenuation of this sound.
     /// </summary>
@@ -236,6 +392,14 @@ public:
     /// <returns>The attenuation model for this sound.</returns>
     AttenuationModel getAttenuationModel() const;
 
+    /// <summary>
+    /// Attenuate this sound with a custom attenuation curve instead of the attenuation model.
+    /// While a curve is set, the attenuation model, the roll off, and the min and max distance
+    /// of the sound are not used (they are restored when the curve is removed).
+    /// </summary>
+    /// <param name="curve">The attenuation curve, or an empty curve to use the attenuation model again.</param>
+    void setAttenuationCurve( const AttenuationCurve& curve );
+
     /// <summary>
     /// Set the roll off factor for this sound.
     /// Roll off controls how quickly the sound attenuates as it moves away from the listener.
@@ -309,6 +473,85 @@ public:
     /// <returns>The doppler effect factor.</returns>
     float getDopplerFactor() const;
 
+    /// <summary>
+    /// Delay this sound by the time it takes to travel to the listener (see `Device::setSpeedOfSound`),
+    /// so that distant sounds (like explosions) are heard after they are played. Changes of the distance
+    /// resample the delayed sound, which replaces the (pitch-based) doppler effect of this sound with a
+    /// physically correct doppler effect.
+    /// </summary>
+    /// <remarks>
+    /// The delay is at most 2 seconds. The delayed sound keeps playing after the sound stops, but the sound
+    /// is reported as stopped. Each delayed sound needs a delay line of about 2 seconds of audio, so only
+    /// enable the delay for sounds that can be heard from far away.
+    /// </remarks>
+    /// <param name="enabled">`true` to delay this sound, `false` to play it without delay.</param>
+    void setPropagationDelay( bool enabled );
+
+    /// <summary>
+    /// Check if this sound is delayed by its distance to the listener.
+    /// </summary>
+    /// <returns>`true` if this sound is delayed, `false` otherwise.</returns>
+    bool getPropagationDelay() const;
+
+    /// <summary>
+    /// Hear this sound through the portals (see `Portal` and `Device::createPortal`) when it is not in the
+    /// same room as the listener. The sound is moved to its apparent position (in the direction of the
+    /// first portal on the path to the sound, at the length of the path), and occluded by closed portals.
+    /// </summary>
+    /// <remarks>
+    /// `getPosition` still returns the position that was set. The occlusion that is set with `setOcclusion`
+    /// is combined with the occlusion of the path, and `getOcclusion` returns the combined occlusion.
+    /// Sounds that are not spatialized are not affected.
+    /// </remarks>
+    /// <param name="enabled">`true` to hear this sound through the portals, `false` to hear it directly.</param>
+    void setPortalPropagation( bool enabled );
+
+    /// <summary>
+    /// Check if this sound is heard through the portals.
+    /// </summary>
+    /// <returns>`true` if this sound is heard through the portals, `false` otherwise.</returns>
+    bool getPortalPropagation() const;
+
+    /// <summary>
+    /// Query the occlusion of this sound with the occlusion callback of the device (see `Device::setOcclusionCallback`).
+    /// The results are smoothed and applied as if they were set with `setOcclusion`, which overrides
+    /// the occlusion that is set by the game. Sounds that are not spatialized are not affected.
+    /// </summary>
+    /// <param name="enabled">`true` to query the occlusion of this sound, `false` to stop the queries.</param>
+    void setOcclusionQuery( bool enabled );
+
+    /// <summary>
+    /// Check if the occlusion of this sound is queried with the occlusion callback of the device.
+    /// </summary>
+    /// <returns>`true` if the occlusion of this sound is queried, `false` otherwise.</returns>
+    bool getOcclusionQuery() const;
+
+    /// <summary>
+    /// Set the occlusion and obstruction of this sound.
+    /// Occlusion (the sound is behind a wall) muffles and attenuates the sound.
+    /// Obstruction (the direct path to the sound is blocked, but the sound can still reach
+    /// the listener around the obstacle) muffles the sound with only a small attenuation.
+    /// Changes are smoothed on the audio thread.
+    /// </summary>
+    /// <remarks>
+    /// Use `Device::setOcclusion` to update the occlusion of many sounds at once.
+    /// </remarks>
+    /// <param name="occlusion">The occlusion (in the range [0 .. 1]).</param>
+    /// <param name="obstruction">(optional) The obstruction (in the range [0 .. 1]). Default: 0</param>
+    void setOcclusion( float occlusion, float obstruction = 0.0f );
+
+    /// <summary>
+    /// Get the occlusion of this sound.
+    /// </summary>
+    /// <returns>The occlusion (in the range [0 .. 1]).</returns>
+    float getOcclusion() const;
+
+    /// <summary>
+    /// Get the obstruction of this sound.
+    /// </summary>
+    /// <returns>The obstruction (in the range [0 .. 1]).</returns>
+    float getObstruction() const;
+
     /// <summary>
     /// Fade this sound in or out over a period of time.
     /// </summary>
@@ -403,6 +646,9 @@ protected:
     explicit Sound( std::shared_ptr<SoundImpl> impl );
 
 private:
+    // Allow batched updates (Device::setOcclusion) without copying the shared pointer.
+    friend class Device;
+
     std::shared_ptr<SoundImpl> impl;
 };
 
@@ -412,6 +658,12 @@ void Sound::seek( const std::chrono::duration<Rep, Period>& duration )
     seek( std::chrono::duration_cast<std::chrono::milliseconds>( duration ).count() );
 }
 
+template<class Rep, class Period>
+void Sound::setPosition( const Vector& position, const std::chrono::duration<Rep, Period>& time )
+{
+    setPosition( position, std::chrono::duration_cast<std::chrono::duration<double>>( time ).count() );
+}
+
 template<class Rep, class Period>
 void Sound::setFade( float endVolume, const std::chrono::duration<Rep, Period>& duration )
 {
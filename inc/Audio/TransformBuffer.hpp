@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace Audio
+{
+class TransformBufferImpl;
+
+/// <summary>
+/// The transform of a sound in a `TransformBuffer`.
+/// </summary>
+struct Transform
+{
+    Vector position { 0.0f, 0.0f, 0.0f };
+    Vector direction { 0.0f, 0.0f, -1.0f };
+    Vector velocity { 0.0f, 0.0f, 0.0f };
+};
+
+/// <summary>
+/// A buffer of transforms that is owned by the game and read by the audio thread.
+/// Instead of setting the position, direction, and velocity of every moving sound every frame,
+/// attach the sounds to the slots of a transform buffer (see `Sound::setTransform`), write the
+/// transforms of the slots, and `publish` the buffer once per frame. The audio thread applies
+/// the last published transforms to the attached sounds at the start of every audio period.
+/// </summary>
+/// <remarks>
+/// The buffer is triple buffered: the game writes one copy of the transforms while the audio
+/// thread reads another copy, and publishing swaps a pointer, so neither side waits for the other.
+/// After publishing, the written transforms are carried over, so only the slots that changed
+/// have to be written. Write and publish the buffer from one thread at a time.
+/// </remarks>
+class AUDIO_API TransformBuffer
+{
+public:
+    /// <summary>
+    /// Get the number of slots in this buffer.
+    /// </summary>
+    /// <returns>The number of slots.</returns>
+    uint32_t getSlotCount() const;
+
+    /// <summary>
+    /// Get the transforms to write (one per slot). The transforms are not seen by the
+    /// audio thread until the buffer is published.
+    /// </summary>
+    /// <returns>The `getSlotCount()` transforms of this buffer.</returns>
+    Transform* getTransforms();
+
+    /// <summary>
+    /// Publish the written transforms to the audio thread.
+    /// </summary>
+    void publish();
+
+    TransformBuffer();
+    ~TransformBuffer();
+    TransformBuffer( const TransformBuffer& );
+    TransformBuffer( TransformBuffer&& ) noexcept;
+    TransformBuffer& operator=( const TransformBuffer& );
+    TransformBuffer& operator=( TransformBuffer&& ) noexcept;
+
+    /// <summary>
+    /// Allow nullptr assignment.
+    /// </summary>
+    /// <remarks>
+    /// Assigning `nullptr` will release the underlying implementation.
+    /// This is the same as using the `reset` function on this object.
+    /// </remarks>
+    TransformBuffer& operator=( nullptr_t ) noexcept;
+
+    /// <summary>
+    /// Allow for null checks.
+    /// </summary>
+    bool operator==( nullptr_t ) const noexcept;
+    bool operator!=( nullptr_t ) const noexcept;
+
+    /// <summary>
+    /// Explicit bool conversion allows to check for a valid object.
+    /// </summary>
+    /// <returns>`true` if this object contains a valid pointer to implementation. `false` otherwise.</returns>
+    explicit operator bool() const noexcept;
+
+    /// <summary>
+    /// Get the pointer to the implementation.
+    /// </summary>
+    /// <returns>The pointer to the transform buffer implementation.</returns>
+    std::shared_ptr<TransformBufferImpl> get() const noexcept;
+
+    /// <summary>
+    /// Release the underlying pointer to implementation.
+    /// </summary>
+    void reset() noexcept;
+
+protected:
+    TransformBuffer( std::shared_ptr<TransformBufferImpl> impl );
+
+private:
+    std::shared_ptr<TransformBufferImpl> impl;
+};
+}  // namespace Audio
+
+namespace std
+{
+// Export DLL API to suppress warnings.
+AUDIO_EXTERN template class AUDIO_API shared_ptr<Audio::TransformBufferImpl>;
+}  // namespace std
@@ -0,0 +1,741 @@
+#include "Ambisonics.hpp"
+#include "Hrtf.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace Audio;
+
+static constexpr float Pi = 3.14159265358979323846f;
+
+// The decoding matrix (or filters) is updated when the listener turns by more than 1 degree.
+static const float MinOrientationChange = std::cos( Pi / 180.0f );
+
+namespace
+{
+ma_vec3f Normalize( const ma_vec3f& v, const ma_vec3f& fallback )
+{
+    const float length = std::sqrt( v.x * v.x + v.y * v.y + v.z * v.z );
+    if ( length < 1e-6f )
+        return fallback;
+
+    return { v.x / length, v.y / length, v.z / length };
+}
+
+ma_vec3f Cross( const ma_vec3f& a, const ma_vec3f& b )
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+float Dot( const ma_vec3f& a, const ma_vec3f& b )
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Transform a direction from listener space to world space.
+ma_vec3f ToWorld( const ma_vec3f& v, const ma_vec3f& right, const ma_vec3f& up, const ma_vec3f& back )
+{
+    return { v.x * right.x + v.y * up.x + v.z * back.x, v.x * right.y + v.y * up.y + v.z * back.y, v.x * right.z + v.y * up.z + v.z * back.z };
+}
+
+// The direction of a speaker in listener space (or zero for speakers without a direction, like the LFE).
+ma_vec3f GetChannelDirection( ma_channel channel )
+{
+    constexpr float d = 0.70710678f;
+
+    switch ( channel )
+    {
+    case MA_CHANNEL_MONO:
+    case MA_CHANNEL_FRONT_CENTER:
+        return { 0.0f, 0.0f, -1.0f };
+    case MA_CHANNEL_FRONT_LEFT:
+        return { -d, 0.0f, -d };
+    case MA_CHANNEL_FRONT_RIGHT:
+        return { d, 0.0f, -d };
+    case MA_CHANNEL_FRONT_LEFT_CENTER:
+        return { -0.38268343f, 0.0f, -0.92387953f };
+    case MA_CHANNEL_FRONT_RIGHT_CENTER:
+        return { 0.38268343f, 0.0f, -0.92387953f };
+    case MA_CHANNEL_BACK_LEFT:
+        return { -d, 0.0f, d };
+    case MA_CHANNEL_BACK_RIGHT:
+        return { d, 0.0f, d };
+    case MA_CHANNEL_BACK_CENTER:
+        return { 0.0f, 0.0f, 1.0f };
+    case MA_CHANNEL_SIDE_LEFT:
+        return { -1.0f, 0.0f, 0.0f };
+    case MA_CHANNEL_SIDE_RIGHT:
+        return { 1.0f, 0.0f, 0.0f };
+    case MA_CHANNEL_TOP_CENTER:
+        return { 0.0f, 1.0f, 0.0f };
+    case MA_CHANNEL_TOP_FRONT_LEFT:
+        return { -0.5f, d, -0.5f };
+    case MA_CHANNEL_TOP_FRONT_CENTER:
+        return { 0.0f, d, -d };
+    case MA_CHANNEL_TOP_FRONT_RIGHT:
+        return { 0.5f, d, -0.5f };
+    case MA_CHANNEL_TOP_BACK_LEFT:
+        return { -0.5f, d, 0.5f };
+    case MA_CHANNEL_TOP_BACK_CENTER:
+        return { 0.0f, d, d };
+    case MA_CHANNEL_TOP_BACK_RIGHT:
+        return { 0.5f, d, 0.5f };
+    default:
+        return { 0.0f, 0.0f, 0.0f };
+    }
+}
+
+// The ambisonic order of an ambisonic channel (in ACN order).
+ma_uint32 GetChannelOrder( ma_uint32 channel )
+{
+    ma_uint32 l = 0;
+    while ( ( l + 1 ) * ( l + 1 ) <= channel )
+        ++l;
+
+    return l;
+}
+
+// Add a sound to the sound field (and interpolate the gains to the target gains over the frames).
+template<ma_uint32 Channels>
+void Encode( const float* in, ma_uint32 inputChannels, float* gains, const float* targetGains, float* field, ma_uint32 frameCount )
+{
+    if ( frameCount == 0 )
+        return;
+
+    float delta[Channels];
+    bool  moved = false;
+    for ( ma_uint32 n = 0; n < Channels; ++n )
+    {
+        delta[n] = ( targetGains[n] - gains[n] ) / static_cast<float>( frameCount );
+        moved |= delta[n] != 0.0f;
+    }
+
+    // The spatializer does not pan the sound, so the sound is downmixed to mono.
+    const float downmix = 1.0f / static_cast<float>( inputChannels );
+
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        float sample = 0.0f;
+        for ( ma_uint32 c = 0; c < inputChannels; ++c )
+            sample += in[f * inputChannels + c];
+        sample *= downmix;
+
+        float* frame = field + f * Channels;
+
+        if ( moved )
+        {
+            for ( ma_uint32 n = 0; n < Channels; ++n )
+                frame[n] += ( gains[n] + static_cast<float>( f + 1 ) * delta[n] ) * sample;
+        }
+        else
+        {
+            for ( ma_uint32 n = 0; n < Channels; ++n )
+                frame[n] += gains[n] * sample;
+        }
+    }
+
+    std::copy_n( targetGains, Channels, gains );
+}
+}  // namespace
+
+AmbisonicDecoder::AmbisonicDecoder( ma_engine* pEngine, ma_uint32 _order, bool _binaural, ma_uint32 _listenerIndex )
+: engine { pEngine }
+, order { _order >= 3 ? 3u : 1u }
+, ambisonicChannels { ( order + 1 ) * ( order + 1 ) }
+, outputChannels { ma_engine_get_channels( pEngine ) }
+, listenerIndex { _listenerIndex }
+, binaural { _binaural }
+, partitionCount { ( Hrtf::MaxLength + BlockSize - 1 ) / BlockSize }
+, binCount { BlockSize + 1 }
+, fft { BlockSize * 2 }
+{
+    // Virtual speakers on a Fibonacci sphere (enough to sample the sound field evenly).
+    const size_t speakerCount = order == 1 ? 24 : 36;
+    const float  goldenAngle  = Pi * ( 3.0f - std::sqrt( 5.0f ) );
+
+    for ( size_t i = 0; i < speakerCount; ++i )
+    {
+        const float y = 1.0f - 2.0f * ( static_cast<float>( i ) + 0.5f ) / static_cast<float>( speakerCount );
+        const float r = std::sqrt( std::max( 0.0f, 1.0f - y * y ) );
+        const float a = goldenAngle * static_cast<float>( i );
+
+        virtualSpeakers.push_back( { r * std::cos( a ), y, r * std::sin( a ) } );
+    }
+
+    // Max-rE weights (narrower virtual speaker lobes), scaled to preserve the energy of the sound field.
+    orderWeights = order == 1 ? std::vector<float> { 1.0f, 0.5774f } : std::vector<float> { 1.0f, 0.8611f, 0.6123f, 0.3046f };
+
+    float energy = 0.0f;
+    for ( size_t l = 0; l < orderWeights.size(); ++l )
+        energy += static_cast<float>( 2 * l + 1 ) * orderWeights[l] * orderWeights[l];
+
+    const float scale = std::sqrt( static_cast<float>( speakerCount ) / energy );
+    for ( size_t l = 0; l < orderWeights.size(); ++l )
+        orderWeights[l] *= scale * static_cast<float>( 2 * l + 1 ) / static_cast<float>( speakerCount );
+
+    virtualDecoder.resize( speakerCount * ambisonicChannels );
+
+    // Pan each virtual speaker to the closest output channels (with constant power).
+    ma_channel channelMap[MA_MAX_CHANNELS];
+    ma_channel_map_init_standard( ma_standard_channel_map_default, channelMap, MA_MAX_CHANNELS, outputChannels );
+
+    panning.resize( outputChannels * speakerCount );
+    for ( size_t v = 0; v < speakerCount; ++v )
+    {
+        float power = 0.0f;
+        for ( ma_uint32 c = 0; c < outputChannels; ++c )
+        {
+            const ma_vec3f direction = GetChannelDirection( channelMap[c] );
+            if ( Dot( direction, direction ) == 0.0f )
+                continue;
+
+            const float gain = 0.5f * ( 1.0f + Dot( direction, virtualSpeakers[v] ) );
+
+            panning[c * speakerCount + v] = gain * gain;
+            power += gain * gain * gain * gain;
+        }
+
+        if ( power > 0.0f )
+        {
+            for ( ma_uint32 c = 0; c < outputChannels; ++c )
+                panning[c * speakerCount + v] /= std::sqrt( power );
+        }
+    }
+
+    matrix.resize( outputChannels * ambisonicChannels );
+    targetMatrix.resize( outputChannels * ambisonicChannels );
+
+    if ( binaural && outputChannels == 2 )
+    {
+        const size_t filterSize = ambisonicChannels * 2 * partitionCount * binCount;
+        for ( size_t set = 0; set < 2; ++set )
+        {
+            filterRe[set].resize( filterSize );
+            filterIm[set].resize( filterSize );
+        }
+
+        speakerHrirs.resize( speakerCount * 2 * Hrtf::MaxLength );
+        inputRe.resize( ambisonicChannels * partitionCount * binCount );
+        inputIm.resize( ambisonicChannels * partitionCount * binCount );
+        window.resize( ambisonicChannels * BlockSize * 2 );
+        input.resize( ambisonicChannels * BlockSize );
+        output.resize( BlockSize * 2 );
+        hrirs.resize( ambisonicChannels * 2 * Hrtf::MaxLength );
+        padded.resize( BlockSize * 2 );
+        accRe.resize( binCount );
+        accIm.resize( binCount );
+        result.resize( BlockSize * 2 );
+        block.resize( BlockSize );
+        faded.resize( BlockSize );
+    }
+
+    // The encoders are attached to the (mono) input, but add their output to the sound field directly.
+    // The decoder is processed continuously, so the binaural output is flushed when the sounds stop.
+    vtable.onProcess      = &AmbisonicDecoder::onProcess;
+    vtable.inputBusCount  = 1;
+    vtable.outputBusCount = 1;
+    vtable.flags          = MA_NODE_FLAG_CONTINUOUS_PROCESSING | MA_NODE_FLAG_ALLOW_NULL_INPUT;
+
+    const ma_uint32 inputChannels = 1;
+
+    ma_node_config config  = ma_node_config_init();
+    config.vtable          = &vtable;
+    config.pInputChannels  = &inputChannels;
+    config.pOutputChannels = &outputChannels;
+
+    node.decoder = this;
+
+    if ( ma_node_init( ma_engine_get_node_graph( pEngine ), &config, nullptr, &node.base ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize ambisonic decoder node." << std::endl;
+        return;
+    }
+
+    // The node never reads (or processes) more frames at a time than fit in its cache.
+    fieldCapacity = node.base.cachedDataCapInFramesPerBus;
+    field.resize( static_cast<size_t>( fieldCapacity ) * ambisonicChannels );
+
+    initialized = true;
+}
+
+AmbisonicDecoder::~AmbisonicDecoder()
+{
+    if ( initialized )
+    {
+        ma_node_uninit( &node.base, nullptr );
+    }
+}
+
+void AmbisonicDecoder::encode( const ma_vec3f& direction, ma_uint32 order, float* gains ) noexcept
+{
+    // Convert to the ambisonic coordinate system (+X is front, +Y is left, +Z is up).
+    const float x = -direction.z;
+    const float y = -direction.x;
+    const float z = direction.y;
+
+    gains[0] = 1.0f;
+    gains[1] = y;
+    gains[2] = z;
+    gains[3] = x;
+
+    if ( order < 2 )
+        return;
+
+    const float sqrt3 = 1.7320508f;
+
+    gains[4] = sqrt3 * x * y;
+    gains[5] = sqrt3 * y * z;
+    gains[6] = 0.5f * ( 3.0f * z * z - 1.0f );
+    gains[7] = sqrt3 * x * z;
+    gains[8] = 0.5f * sqrt3 * ( x * x - y * y );
+
+    if ( order < 3 )
+        return;
+
+    const float sqrt5_8 = 0.7905694f;
+    const float sqrt15  = 3.8729833f;
+    const float sqrt3_8 = 0.6123724f;
+
+    gains[9]  = sqrt5_8 * y * ( 3.0f * x * x - y * y );
+    gains[10] = sqrt15 * x * y * z;
+    gains[11] = sqrt3_8 * y * ( 5.0f * z * z - 1.0f );
+    gains[12] = 0.5f * z * ( 5.0f * z * z - 3.0f );
+    gains[13] = sqrt3_8 * x * ( 5.0f * z * z - 1.0f );
+    gains[14] = 0.5f * sqrt15 * z * ( x * x - y * y );
+    gains[15] = sqrt5_8 * x * ( x * x - 3.0f * y * y );
+}
+
+void AmbisonicDecoder::getListenerBasis( ma_vec3f& right, ma_vec3f& up, ma_vec3f& back ) const
+{
+    const ma_vec3f forward = Normalize( ma_engine_listener_get_direction( engine, listenerIndex ), { 0.0f, 0.0f, -1.0f } );
+    const ma_vec3f worldUp = ma_engine_listener_get_world_up( engine, listenerIndex );
+
+    right = Normalize( Cross( forward, worldUp ), { 1.0f, 0.0f, 0.0f } );
+    up    = Cross( right, forward );
+    back  = { -forward.x, -forward.y, -forward.z };
+}
+
+bool AmbisonicDecoder::updateOrientation()
+{
+    ma_vec3f right, up, back;
+    getListenerBasis( right, up, back );
+
+    if ( hasOrientation && Dot( right, listenerRight ) >= MinOrientationChange && Dot( up, listenerUp ) >= MinOrientationChange )
+        return false;
+
+    listenerRight  = right;
+    listenerUp     = up;
+    hasOrientation = true;
+
+    computeVirtualDecoder();
+
+    return true;
+}
+
+void AmbisonicDecoder::computeVirtualDecoder()
+{
+    const ma_vec3f back = Cross( listenerRight, listenerUp );
+
+    float gains[16];
+    for ( size_t v = 0; v < virtualSpeakers.size(); ++v )
+    {
+        encode( ToWorld( virtualSpeakers[v], listenerRight, listenerUp, back ), order, gains );
+
+        for ( ma_uint32 n = 0; n < ambisonicChannels; ++n )
+            virtualDecoder[v * ambisonicChannels + n] = orderWeights[GetChannelOrder( n )] * gains[n];
+    }
+}
+
+void AmbisonicDecoder::onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut )
+{
+    (void)ppFramesIn;
+
+    auto* decoder = static_cast<Node*>( pNode )->decoder;
+
+    // Input and output are processed at the same rate.
+    const ma_uint32 frameCount = std::min( { *pFrameCountIn, *pFrameCountOut, decoder->fieldCapacity - decoder->consumed } );
+
+    float* in = decoder->field.data() + static_cast<size_t>( decoder->consumed ) * decoder->ambisonicChannels;
+
+    // Fall back to the speakers until an HRTF is loaded.
+    if ( decoder->binaural && decoder->outputChannels == 2 && Hrtf::getCurrent() )
+        decoder->processBinaural( in, ppFramesOut[0], frameCount );
+    else
+        decoder->processSpeakers( in, ppFramesOut[0], frameCount );
+
+    std::fill_n( in, static_cast<size_t>( frameCount ) * decoder->ambisonicChannels, 0.0f );
+
+    // The input is read again (and the encoders are processed again) once all of it is consumed.
+    if ( frameCount == *pFrameCountIn )
+    {
+        decoder->consumed = 0;
+        decoder->round++;
+    }
+    else
+    {
+        decoder->consumed += frameCount;
+    }
+
+    *pFrameCountIn  = frameCount;
+    *pFrameCountOut = frameCount;
+}
+
+float AmbisonicDecoder::getNormalization( const float* gains, size_t rows, size_t columns, float power ) const
+{
+    // The spherical harmonics are orthogonal: the average of Y_n^2 over the sphere is 1 / (2l + 1) (with SN3D normalization).
+    float average = 0.0f;
+    for ( size_t r = 0; r < rows; ++r )
+    {
+        for ( size_t n = 0; n < ambisonicChannels; ++n )
+        {
+            const float* row = gains + ( r * ambisonicChannels + n ) * columns;
+
+            float sum = 0.0f;
+            for ( size_t i = 0; i < columns; ++i )
+                sum += row[i] * row[i];
+
+            average += sum / static_cast<float>( 2 * GetChannelOrder( static_cast<ma_uint32>( n ) ) + 1 );
+        }
+    }
+
+    return average > 0.0f ? std::sqrt( power / average ) : 1.0f;
+}
+
+void AmbisonicDecoder::processSpeakers( const float* in, float* out, ma_uint32 frameCount )
+{
+    const bool   turned       = updateOrientation();
+    const size_t speakerCount = virtualSpeakers.size();
+
+    if ( turned )
+    {
+        for ( ma_uint32 c = 0; c < outputChannels; ++c )
+        {
+            for ( ma_uint32 n = 0; n < ambisonicChannels; ++n )
+            {
+                float gain = 0.0f;
+                for ( size_t v = 0; v < speakerCount; ++v )
+                    gain += panning[c * speakerCount + v] * virtualDecoder[v * ambisonicChannels + n];
+
+                targetMatrix[c * ambisonicChannels + n] = gain;
+            }
+        }
+
+        // Preserve the power of the sounds (on average).
+        const float scale = getNormalization( targetMatrix.data(), outputChannels, 1, 1.0f );
+        for ( float& gain: targetMatrix )
+            gain *= scale;
+    }
+
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        const float  t     = static_cast<float>( f + 1 ) / static_cast<float>( frameCount );
+        const float* frame = in + f * ambisonicChannels;
+
+        for ( ma_uint32 c = 0; c < outputChannels; ++c )
+        {
+            const float* from = matrix.data() + c * ambisonicChannels;
+            const float* to   = targetMatrix.data() + c * ambisonicChannels;
+
+            float sample = 0.0f;
+            for ( ma_uint32 n = 0; n < ambisonicChannels; ++n )
+                sample += ( from[n] + t * ( to[n] - from[n] ) ) * frame[n];
+
+            out[f * outputChannels + c] = sample;
+        }
+    }
+
+    matrix = targetMatrix;
+}
+
+void AmbisonicDecoder::processBinaural( const float* in, float* out, ma_uint32 frameCount )
+{
+    ma_uint32 frame = 0;
+    while ( frame < frameCount )
+    {
+        const auto count = std::min( frameCount - frame, static_cast<ma_uint32>( BlockSize - position ) );
+
+        for ( ma_uint32 i = 0; i < count; ++i )
+        {
+            const ma_uint32 f = frame + i;
+
+            for ( ma_uint32 n = 0; n < ambisonicChannels; ++n )
+                input[n * BlockSize + position + i] = in[f * ambisonicChannels + n];
+
+            out[f * 2 + 0] = output[( position + i ) * 2 + 0];
+            out[f * 2 + 1] = output[( position + i ) * 2 + 1];
+        }
+
+        position += count;
+        frame += count;
+
+        if ( position == BlockSize )
+        {
+            processBlock();
+            position = 0;
+        }
+    }
+}
+
+void AmbisonicDecoder::processBlock()
+{
+    // Slide the input window of each ambisonic channel and add its spectrum to the delay line.
+    for ( ma_uint32 n = 0; n < ambisonicChannels; ++n )
+    {
+        float* w = window.data() + n * BlockSize * 2;
+        std::copy( w + BlockSize, w + BlockSize * 2, w );
+        std::copy_n( input.data() + n * BlockSize, BlockSize, w + BlockSize );
+
+        const size_t spectrum = ( n * partitionCount + current ) * binCount;
+        fft.forward( w, inputRe.data() + spectrum, inputIm.data() + spectrum );
+    }
+
+    // The HRIRs of the virtual speakers only change with the HRTF.
+    const Hrtf* newHrtf = Hrtf::getCurrent();
+    const bool  changed = newHrtf != hrtf;
+    if ( changed )
+    {
+        hrtf = newHrtf;
+
+        // Shorter HRIRs are zero-padded.
+        for ( size_t v = 0; v < virtualSpeakers.size(); ++v )
+        {
+            float* left = speakerHrirs.data() + v * 2 * Hrtf::MaxLength;
+            std::fill_n( left, 2 * Hrtf::MaxLength, 0.0f );
+            hrtf->interpolate( virtualSpeakers[v], left, left + Hrtf::MaxLength );
+        }
+    }
+
+    bool fade = false;
+    if ( updateOrientation() || changed || !hasFilters )
+    {
+        if ( hasFilters )
+        {
+            computeFilters( 1 - active );
+            fade = true;
+        }
+        else
+        {
+            computeFilters( active );
+            hasFilters = true;
+        }
+    }
+
+    for ( size_t ear = 0; ear < 2; ++ear )
+    {
+        convolve( active, ear, block.data() );
+
+        if ( fade )
+        {
+            // Crossfade from the previous filters to the next filters over the block.
+            convolve( 1 - active, ear, faded.data() );
+
+            for ( size_t i = 0; i < BlockSize; ++i )
+            {
+                const float t = ( static_cast<float>( i ) + 0.5f ) / static_cast<float>( BlockSize );
+                block[i] += t * ( faded[i] - block[i] );
+            }
+        }
+
+        for ( size_t i = 0; i < BlockSize; ++i )
+            output[i * 2 + ear] = block[i];
+    }
+
+    if ( fade )
+        active = 1 - active;
+
+    current = ( current + 1 ) % partitionCount;
+}
+
+void AmbisonicDecoder::computeFilters( size_t set )
+{
+    const size_t speakerCount = virtualSpeakers.size();
+
+    // The filter of an ambisonic channel is the sum of the HRIRs of the virtual speakers, weighted by their decoding gains.
+    std::fill( hrirs.begin(), hrirs.end(), 0.0f );
+    for ( ma_uint32 n = 0; n < ambisonicChannels; ++n )
+    {
+        for ( size_t ear = 0; ear < 2; ++ear )
+        {
+            float* hrir = hrirs.data() + ( ear * ambisonicChannels + n ) * Hrtf::MaxLength;
+
+            for ( size_t v = 0; v < speakerCount; ++v )
+            {
+                const float  gain = virtualDecoder[v * ambisonicChannels + n];
+                const float* h    = speakerHrirs.data() + ( v * 2 + ear ) * Hrtf::MaxLength;
+
+                for ( size_t i = 0; i < Hrtf::MaxLength; ++i )
+                    hrir[i] += gain * h[i];
+            }
+        }
+    }
+
+    // Match the power of sounds that are rendered with the HRTF individually (unit power for each ear).
+    const float scale = getNormalization( hrirs.data(), 2, Hrtf::MaxLength, 2.0f );
+
+    for ( ma_uint32 n = 0; n < ambisonicChannels; ++n )
+    {
+        for ( size_t ear = 0; ear < 2; ++ear )
+        {
+            const float* hrir = hrirs.data() + ( ear * ambisonicChannels + n ) * Hrtf::MaxLength;
+
+            // Each partition is zero-padded to twice the block size.
+            for ( size_t p = 0; p < partitionCount; ++p )
+            {
+                std::fill( padded.begin(), padded.end(), 0.0f );
+                for ( size_t i = 0; i < BlockSize; ++i )
+                    padded[i] = scale * hrir[p * BlockSize + i];
+
+                const size_t spectrum = ( ( n * 2 + ear ) * partitionCount + p ) * binCount;
+                fft.forward( padded.data(), filterRe[set].data() + spectrum, filterIm[set].data() + spectrum );
+            }
+        }
+    }
+}
+
+void AmbisonicDecoder::convolve( size_t set, size_t ear, float* out )
+{
+    std::fill( accRe.begin(), accRe.end(), 0.0f );
+    std::fill( accIm.begin(), accIm.end(), 0.0f );
+
+    // The spectra of all ambisonic channels are accumulated, so each ear only needs one inverse transform.
+    for ( ma_uint32 n = 0; n < ambisonicChannels; ++n )
+    {
+        size_t spectrum = current;
+        for ( size_t p = 0; p < partitionCount; ++p )
+        {
+            const size_t in     = ( n * partitionCount + spectrum ) * binCount;
+            const size_t filter = ( ( n * 2 + ear ) * partitionCount + p ) * binCount;
+
+            FFT::multiplyAccumulate( inputRe.data() + in, inputIm.data() + in,
+                                     filterRe[set].data() + filter, filterIm[set].data() + filter,
+                                     accRe.data(), accIm.data(), binCount );
+
+            spectrum = spectrum == 0 ? partitionCount - 1 : spectrum - 1;
+        }
+    }
+
+    fft.inverse( accRe.data(), accIm.data(), result.data() );
+
+    // The first half of the result is aliased (overlap-save), the second half is the output.
+    std::copy_n( result.begin() + BlockSize, BlockSize, out );
+}
+
+AmbisonicEncoder::AmbisonicEncoder( AmbisonicDecoder* _decoder, ma_sound* pSound )
+: decoder { _decoder }
+, sound { pSound }
+, inputChannels { ma_engine_get_channels( _decoder->getEngine() ) }
+, ambisonicChannels { _decoder->getChannelCount() }
+{
+    gains.resize( ambisonicChannels );
+    targetGains.resize( ambisonicChannels );
+
+    // The output is silent: the encoder adds its output to the sound field of the decoder.
+    vtable.onProcess      = &AmbisonicEncoder::onProcess;
+    vtable.inputBusCount  = 1;
+    vtable.outputBusCount = 1;
+    vtable.flags          = MA_NODE_FLAG_SILENT_OUTPUT;
+
+    const ma_uint32 outputChannels = 1;
+
+    ma_node_config config  = ma_node_config_init();
+    config.vtable          = &vtable;
+    config.pInputChannels  = &inputChannels;
+    config.pOutputChannels = &outputChannels;
+
+    node.encoder = this;
+
+    if ( ma_node_init( ma_engine_get_node_graph( decoder->getEngine() ), &config, nullptr, &node.base ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize ambisonic encoder node." << std::endl;
+        return;
+    }
+
+    ma_node_attach_output_bus( &node.base, 0, decoder->getNode(), 0 );
+
+    initialized = true;
+}
+
+AmbisonicEncoder::~AmbisonicEncoder()
+{
+    if ( initialized )
+    {
+        ma_node_uninit( &node.base, nullptr );
+    }
+}
+
+void AmbisonicEncoder::onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut )
+{
+    auto* encoder = static_cast<Node*>( pNode )->encoder;
+
+    // Input and output are processed at the same rate.
+    const ma_uint32 frameCount = std::min( *pFrameCountIn, *pFrameCountOut );
+
+    encoder->process( ppFramesIn[0], ppFramesOut[0], frameCount );
+
+    *pFrameCountIn  = frameCount;
+    *pFrameCountOut = frameCount;
+}
+
+ma_vec3f AmbisonicEncoder::getDirection() const
+{
+    ma_engine* engine   = decoder->getEngine();
+    ma_vec3f   position = ma_sound_get_position( sound );
+
+    if ( ma_sound_get_positioning( sound ) == ma_positioning_relative )
+    {
+        // The position is relative to the listener, but the sound field is encoded in world space.
+        ma_vec3f right, up, back;
+        decoder->getListenerBasis( right, up, back );
+        position = ToWorld( position, right, up, back );
+    }
+    else
+    {
+        const ma_vec3f listener = ma_engine_listener_get_position( engine, decoder->getListenerIndex() );
+        position                = { position.x - listener.x, position.y - listener.y, position.z - listener.z };
+    }
+
+    return position;
+}
+
+void AmbisonicEncoder::process( const float* in, float* out, ma_uint32 frameCount )
+{
+    const ma_vec3f direction = getDirection();
+
+    // A sound on top of the listener is omnidirectional.
+    if ( Dot( direction, direction ) < 1e-6f )
+    {
+        std::fill( targetGains.begin(), targetGains.end(), 0.0f );
+        targetGains[0] = 1.0f;
+    }
+    else
+    {
+        AmbisonicDecoder::encode( Normalize( direction, { 0.0f, 0.0f, -1.0f } ), decoder->getOrder(), targetGains.data() );
+    }
+
+    if ( !hasGains )
+    {
+        gains    = targetGains;
+        hasGains = true;
+    }
+
+    // The encoder may be processed more than once per round (if the decoder reads more frames than the encoder processes at a time).
+    if ( round != decoder->round )
+    {
+        round  = decoder->round;
+        offset = 0;
+    }
+
+    const ma_uint32 count = std::min( frameCount, decoder->fieldCapacity - offset );
+    float*          field = decoder->field.data() + static_cast<size_t>( offset ) * ambisonicChannels;
+
+    // The channel count is a compile-time constant, so the inner loops are vectorized.
+    if ( ambisonicChannels == 16 )
+        Encode<16>( in, inputChannels, gains.data(), targetGains.data(), field, count );
+    else
+        Encode<4>( in, inputChannels, gains.data(), targetGains.data(), field, count );
+
+    offset += count;
+
+    std::fill_n( out, frameCount, 0.0f );
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "FFT.hpp"
+
+#include "miniaudio.h"
+
+#include <vector>
+
+namespace Audio
+{
+class Hrtf;
+
+/// <summary>
+/// Decodes the ambisonic mix of a bus to the output channels of the engine (or binaurally).
+/// </summary>
+/// <remarks>
+/// Sounds are encoded in world space (ACN channel order, SN3D normalization) by `AmbisonicEncoder`.
+/// The encoders add their output directly to the sound field of the decoder: the node graph would
+/// mix the (up to 16 channel) output of each encoder in small chunks, which costs more than the
+/// encoding itself. The encoders are inputs of the decoder (with a silent output), so they are
+/// processed before the decoder.
+/// The sound field is decoded to a set of virtual speakers that are fixed relative to the listener,
+/// so the rotation of the listener is applied once per bus (by rotating the virtual speakers into
+/// world space) instead of once per sound. The virtual speakers are folded into a single decoding
+/// matrix (for speakers) or a pair of filters per ambisonic channel (for binaural output).
+/// </remarks>
+class AmbisonicDecoder
+{
+public:
+    /// <summary>
+    /// Create a decoder.
+    /// </summary>
+    /// <param name="pEngine">The engine.</param>
+    /// <param name="order">The ambisonic order (1 or 3).</param>
+    /// <param name="binaural">`true` to decode with the current HRTF (stereo output only), `false` to decode to the speakers.</param>
+    /// <param name="listenerIndex">The listener the mix is decoded for.</param>
+    AmbisonicDecoder( ma_engine* pEngine, ma_uint32 order, bool binaural, ma_uint32 listenerIndex = 0 );
+    ~AmbisonicDecoder();
+
+    ma_node* getNode() noexcept
+    {
+        return &node.base;
+    }
+
+    ma_engine* getEngine() const noexcept
+    {
+        return engine;
+    }
+
+    ma_uint32 getOrder() const noexcept
+    {
+        return order;
+    }
+
+    /// <summary>
+    /// The number of ambisonic channels: (order + 1)^2.
+    /// </summary>
+    ma_uint32 getChannelCount() const noexcept
+    {
+        return ambisonicChannels;
+    }
+
+    ma_uint32 getListenerIndex() const noexcept
+    {
+        return listenerIndex;
+    }
+
+    bool isBinaural() const noexcept
+    {
+        return binaural;
+    }
+
+    /// <summary>
+    /// Evaluate the (SN3D normalized) spherical harmonics up to `order` for a (unit) direction in world space.
+    /// </summary>
+    static void encode( const ma_vec3f& direction, ma_uint32 order, float* gains ) noexcept;
+
+    /// <summary>
+    /// Get the world space directions of the right, up, and back axes of the listener.
+    /// </summary>
+    void getListenerBasis( ma_vec3f& right, ma_vec3f& up, ma_vec3f& back ) const;
+
+    // The number of frames that are convolved at a time (for binaural output).
+    static constexpr size_t BlockSize = 128;
+
+    AmbisonicDecoder( const AmbisonicDecoder& )            = delete;
+    AmbisonicDecoder( AmbisonicDecoder&& )                 = delete;
+    AmbisonicDecoder& operator=( const AmbisonicDecoder& ) = delete;
+    AmbisonicDecoder& operator=( AmbisonicDecoder&& )      = delete;
+
+private:
+    static void onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut );
+
+    void processSpeakers( const float* in, float* out, ma_uint32 frameCount );
+    void processBinaural( const float* in, float* out, ma_uint32 frameCount );
+    void processBlock();
+
+    // Get the scale of the decoding matrix (or filters) that makes the average power over all directions `power`.
+    // The gains are (row x ambisonic channel x column).
+    // The decoding is the same for all sounds on the bus, so it has to be normalized for all directions at once.
+    float getNormalization( const float* gains, size_t rows, size_t columns, float power ) const;
+
+    // Check if the listener has turned since the virtual decoder was computed (and recompute it).
+    bool updateOrientation();
+
+    // Compute the gains of each ambisonic channel for each virtual speaker (for the orientation of the listener).
+    void computeVirtualDecoder();
+
+    // Compute the spectra of the binaural filters of each ambisonic channel.
+    void computeFilters( size_t set );
+
+    // Convolve the delay lines with one ear of a filter set. Writes `BlockSize` samples.
+    void convolve( size_t set, size_t ear, float* out );
+
+    friend class AmbisonicEncoder;
+
+    struct Node
+    {
+        ma_node_base      base;
+        AmbisonicDecoder* decoder;
+    };
+
+    ma_node_vtable vtable {};
+    Node           node {};
+    bool           initialized = false;
+
+    ma_engine* engine = nullptr;
+    ma_uint32  order  = 1;
+    ma_uint32  ambisonicChannels;
+    ma_uint32  outputChannels;
+    ma_uint32  listenerIndex;
+    bool       binaural;
+
+    // The sound field that the encoders add to (frame x ambisonic channel). The field is read in rounds:
+    // the encoders are processed once per round, and the decoder consumes the round in one or more calls.
+    std::vector<float> field;
+    ma_uint32          fieldCapacity = 0;
+    ma_uint32          round         = 0;
+    ma_uint32          consumed      = 0;
+
+    // The virtual speakers (in listener space) and the decoding weight of each order.
+    std::vector<ma_vec3f> virtualSpeakers;
+    std::vector<float>    orderWeights;
+
+    // The gains (virtual speaker x ambisonic channel) for the current orientation of the listener.
+    std::vector<float> virtualDecoder;
+
+    // The orientation the virtual decoder was computed for.
+    ma_vec3f listenerRight {};
+    ma_vec3f listenerUp {};
+    bool     hasOrientation = false;
+
+    // Speaker output: the gains from each virtual speaker to each output channel (output channel x virtual speaker),
+    // and the previous and the current decoding matrix (output channel x ambisonic channel).
+    std::vector<float> panning;
+    std::vector<float> matrix;
+    std::vector<float> targetMatrix;
+
+    // Binaural output: uniformly partitioned convolution of each ambisonic channel.
+    // The buffers are sized for the longest HRIRs, so changing the HRTF does not allocate.
+    const Hrtf* hrtf           = nullptr;
+    size_t      partitionCount = 0;
+    size_t      binCount       = 0;
+    FFT         fft;
+
+    // The HRIRs of the virtual speakers (virtual speaker x ear).
+    std::vector<float> speakerHrirs;
+
+    // The current filter set and the filter set that is faded in (ambisonic channel x ear x partition spectra).
+    std::vector<float> filterRe[2];
+    std::vector<float> filterIm[2];
+    size_t             active     = 0;
+    bool               hasFilters = false;
+
+    // Frequency-domain delay line of each ambisonic channel.
+    std::vector<float> inputRe;
+    std::vector<float> inputIm;
+    size_t             current = 0;
+
+    // The last two blocks of input of each ambisonic channel (overlap-save).
+    std::vector<float> window;
+
+    // The input of the current block (ambisonic channel x frame) and the (stereo) output of the previous block.
+    std::vector<float> input;
+    std::vector<float> output;
+    size_t             position = 0;
+
+    // Scratch buffers.
+    std::vector<float> hrirs;
+    std::vector<float> padded;
+    std::vector<float> accRe;
+    std::vector<float> accIm;
+    std::vector<float> result;
+    std::vector<float> block;
+    std::vector<float> faded;
+};
+
+/// <summary>
+/// Encodes a sound into the sound field of an ambisonic bus. The encoder is inserted between the sound
+/// and the decoder of the bus, and the panning of the sound is disabled (the sound is still attenuated
+/// by its spatializer). Encoding costs one multiply-add per ambisonic channel per frame.
+/// </summary>
+class AmbisonicEncoder
+{
+public:
+    AmbisonicEncoder( AmbisonicDecoder* decoder, ma_sound* pSound );
+    ~AmbisonicEncoder();
+
+    ma_node* getNode() noexcept
+    {
+        return &node.base;
+    }
+
+    AmbisonicDecoder* getDecoder() const noexcept
+    {
+        return decoder;
+    }
+
+    AmbisonicEncoder( const AmbisonicEncoder& )            = delete;
+    AmbisonicEncoder( AmbisonicEncoder&& )                 = delete;
+    AmbisonicEncoder& operator=( const AmbisonicEncoder& ) = delete;
+    AmbisonicEncoder& operator=( AmbisonicEncoder&& )      = delete;
+
+private:
+    static void onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut );
+
+    void process( const float* in, float* out, ma_uint32 frameCount );
+
+    // Get the direction of the sound (from the listener) in world space.
+    ma_vec3f getDirection() const;
+
+    struct Node
+    {
+        ma_node_base      base;
+        AmbisonicEncoder* encoder;
+    };
+
+    ma_node_vtable vtable {};
+    Node           node {};
+    bool           initialized = false;
+
+    AmbisonicDecoder* decoder = nullptr;
+    ma_sound*         sound   = nullptr;
+    ma_uint32         inputChannels     = 0;
+    ma_uint32         ambisonicChannels = 0;
+
+    // The gains of the previous block (the gains are interpolated over each block).
+    std::vector<float> gains;
+    std::vector<float> targetGains;
+    bool               hasGains = false;
+
+    // The round of the decoder this encoder last wrote to, and the number of frames written in that round.
+    ma_uint32 round  = 0;
+    ma_uint32 offset = 0;
+};
+}  // namespace Audio
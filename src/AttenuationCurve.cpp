@@ -0,0 +1,57 @@
+#include <Audio/AttenuationCurve.hpp>
+
+#include "AttenuationCurveImpl.hpp"
+
+using namespace Audio;
+
+AttenuationCurve::AttenuationCurve( std::shared_ptr<AttenuationCurveImpl> impl )
+: impl { std::move( impl ) }
+{}
+
+AttenuationCurve::AttenuationCurve()                                         = default;
+AttenuationCurve::~AttenuationCurve()                                        = default;
+AttenuationCurve::AttenuationCurve( const AttenuationCurve& )                = default;
+AttenuationCurve::AttenuationCurve( AttenuationCurve&& ) noexcept            = default;
+AttenuationCurve& AttenuationCurve::operator=( const AttenuationCurve& )     = default;
+AttenuationCurve& AttenuationCurve::operator=( AttenuationCurve&& ) noexcept = default;
+
+AttenuationCurve& AttenuationCurve::operator=( nullptr_t ) noexcept
+{
+    impl = nullptr;
+    return *this;
+}
+
+bool AttenuationCurve::operator==( nullptr_t ) const noexcept
+{
+    return impl == nullptr;
+}
+
+bool AttenuationCurve::operator!=( nullptr_t ) const noexcept
+{
+    return impl != nullptr;
+}
+
+float AttenuationCurve::getGain( float distance ) const
+{
+    return impl->getGain( distance );
+}
+
+float AttenuationCurve::getMaxDistance() const
+{
+    return impl->getMaxDistance();
+}
+
+AttenuationCurve::operator bool() const noexcept
+{
+    return impl != nullptr;
+}
+
+std::shared_ptr<AttenuationCurveImpl> AttenuationCurve::get() const noexcept
+{
+    return impl;
+}
+
+void AttenuationCurve::reset() noexcept
+{
+    impl.reset();
+}
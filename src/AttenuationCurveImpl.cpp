@@ -0,0 +1,322 @@
+#include "AttenuationCurveImpl.hpp"
+#include "DeviceImpl.hpp"
+#include "SoundImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define AUDIO_CURVE_SSE
+#elif defined( __ARM_NEON ) || defined( _M_ARM64 )
+    #include <arm_neon.h>
+    #define AUDIO_CURVE_NEON
+#endif
+
+using namespace Audio;
+
+namespace
+{
+// The attenuation is fitted at no less than this distance (the fit divides by the distance).
+constexpr float MinFitDistance = 0.01f;
+
+// The number of sounds whose gains are looked up at once (the distances and gains are kept on the stack of the audio thread).
+constexpr size_t ChunkSize = 64;
+
+// Get the tangents of a monotone cubic curve through the points (Fritsch-Carlson).
+std::vector<float> GetTangents( const std::vector<AttenuationCurve::Point>& points )
+{
+    const size_t       count = points.size();
+    std::vector<float> slopes( count - 1 );
+    std::vector<float> tangents( count );
+
+    for ( size_t i = 0; i + 1 < count; ++i )
+        slopes[i] = ( points[i + 1].gain - points[i].gain ) / ( points[i + 1].distance - points[i].distance );
+
+    tangents[0]         = slopes[0];
+    tangents[count - 1] = slopes[count - 2];
+    for ( size_t i = 1; i + 1 < count; ++i )
+        tangents[i] = slopes[i - 1] * slopes[i] > 0.0f ? 0.5f * ( slopes[i - 1] + slopes[i] ) : 0.0f;
+
+    // Limit the tangents so the curve is monotone between the points.
+    for ( size_t i = 0; i + 1 < count; ++i )
+    {
+        if ( slopes[i] == 0.0f )
+        {
+            tangents[i]     = 0.0f;
+            tangents[i + 1] = 0.0f;
+            continue;
+        }
+
+        const float a = tangents[i] / slopes[i];
+        const float b = tangents[i + 1] / slopes[i];
+        const float s = a * a + b * b;
+        if ( s > 9.0f )
+        {
+            const float tau = 3.0f / std::sqrt( s );
+            tangents[i]     = tau * a * slopes[i];
+            tangents[i + 1] = tau * b * slopes[i];
+        }
+    }
+
+    return tangents;
+}
+
+// Evaluate the curve through the (sorted) points at a distance.
+float Evaluate( const std::vector<AttenuationCurve::Point>& points, const std::vector<float>& tangents, float distance )
+{
+    if ( distance <= points.front().distance )
+        return points.front().gain;
+    if ( distance >= points.back().distance )
+        return points.back().gain;
+
+    const auto   next = std::upper_bound( points.begin(), points.end(), distance, []( float d, const auto& p ) { return d < p.distance; } );
+    const size_t i    = static_cast<size_t>( next - points.begin() ) - 1;
+
+    const float width = points[i + 1].distance - points[i].distance;
+    const float t     = ( distance - points[i].distance ) / width;
+
+    if ( tangents.empty() )
+        return points[i].gain + t * ( points[i + 1].gain - points[i].gain );
+
+    // Cubic Hermite segment.
+    const float t2 = t * t;
+    const float t3 = t2 * t;
+    return ( 2.0f * t3 - 3.0f * t2 + 1.0f ) * points[i].gain + ( t3 - 2.0f * t2 + t ) * width * tangents[i] +
+           ( -2.0f * t3 + 3.0f * t2 ) * points[i + 1].gain + ( t3 - t2 ) * width * tangents[i + 1];
+}
+}  // namespace
+
+AttenuationCurveImpl::AttenuationCurveImpl( std::shared_ptr<DeviceImpl> _device, const AttenuationCurve::Point* _points, size_t count, AttenuationCurve::Interpolation interpolation )
+: device { std::move( _device ) }
+, sounds { device->getRenderEpoch() }
+{
+    std::vector<AttenuationCurve::Point> points;
+    for ( size_t i = 0; i < count; ++i )
+    {
+        if ( std::isfinite( _points[i].distance ) && std::isfinite( _points[i].gain ) )
+            points.push_back( { std::max( _points[i].distance, 0.0f ), std::max( _points[i].gain, 0.0f ) } );
+    }
+
+    // Sort the points by distance (and keep the last point of each distance).
+    std::stable_sort( points.begin(), points.end(), []( const auto& a, const auto& b ) { return a.distance < b.distance; } );
+    const auto last = std::unique( points.rbegin(), points.rend(), []( const auto& a, const auto& b ) { return a.distance == b.distance; } );
+    points.erase( points.begin(), last.base() );
+
+    // Without points there is no attenuation.
+    if ( points.empty() )
+        points.push_back( { 0.0f, 1.0f } );
+
+    std::vector<float> tangents;
+    if ( interpolation == AttenuationCurve::Interpolation::Smooth && points.size() > 2 )
+        tangents = GetTangents( points );
+
+    maxDistance = points.back().distance;
+    scale       = maxDistance > 0.0f ? static_cast<float>( TableSize ) / maxDistance : 0.0f;
+
+    table.resize( TableSize + 1 );
+    for ( size_t i = 0; i <= TableSize; ++i )
+        table[i] = Evaluate( points, tangents, maxDistance * static_cast<float>( i ) / static_cast<float>( TableSize ) );
+}
+
+AttenuationCurveImpl::~AttenuationCurveImpl()
+{
+    device->getAttenuationCurves().remove( this );
+}
+
+std::shared_ptr<AttenuationCurveImpl> AttenuationCurveImpl::load( std::shared_ptr<DeviceImpl> device, const std::filesystem::path& filePath, AttenuationCurve::Interpolation interpolation )
+{
+    std::ifstream file { filePath };
+    if ( !file )
+    {
+        std::cerr << "Failed to load attenuation curve: " << filePath.string() << std::endl;
+        return nullptr;
+    }
+
+    std::vector<AttenuationCurve::Point> points;
+    std::string                          line;
+    while ( std::getline( file, line ) )
+    {
+        const auto first = line.find_first_not_of( " \t\r" );
+        if ( first == std::string::npos || line[first] == '#' )
+            continue;
+
+        std::replace( line.begin(), line.end(), ',', ' ' );
+
+        std::istringstream      stream { line };
+        AttenuationCurve::Point point {};
+        if ( stream >> point.distance >> point.gain )
+            points.push_back( point );
+    }
+
+    if ( points.empty() )
+    {
+        std::cerr << "Attenuation curve has no points: " << filePath.string() << std::endl;
+        return nullptr;
+    }
+
+    return std::make_shared<AttenuationCurveImpl>( std::move( device ), points.data(), points.size(), interpolation );
+}
+
+float AttenuationCurveImpl::getGain( float distance ) const noexcept
+{
+    float gain;
+    getGains( &distance, &gain, 1 );
+    return gain;
+}
+
+void AttenuationCurveImpl::getGains( const float* _distances, float* _gains, size_t count ) const noexcept
+{
+    const float*    lut  = table.data();
+    constexpr float end  = static_cast<float>( TableSize );
+    constexpr float last = static_cast<float>( TableSize - 1 );
+
+    // The position in the table is clamped to [0 .. TableSize], and the index to [0 .. TableSize - 1]
+    // (so the end of the table is interpolated with a fraction of 1).
+    size_t i = 0;
+
+#if defined( AUDIO_CURVE_SSE )
+    const __m128 scale4 = _mm_set1_ps( scale );
+    const __m128 zero4  = _mm_setzero_ps();
+    const __m128 end4   = _mm_set1_ps( end );
+    const __m128 last4  = _mm_set1_ps( last );
+
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        const __m128  x     = _mm_min_ps( _mm_max_ps( _mm_mul_ps( _mm_loadu_ps( _distances + i ), scale4 ), zero4 ), end4 );
+        const __m128i index = _mm_cvttps_epi32( _mm_min_ps( x, last4 ) );
+        const __m128  t     = _mm_sub_ps( x, _mm_cvtepi32_ps( index ) );
+
+        // SSE2 has no gather, so the table entries are loaded one at a time.
+        alignas( 16 ) int32_t indices[4];
+        _mm_store_si128( reinterpret_cast<__m128i*>( indices ), index );
+
+        const __m128 a = _mm_setr_ps( lut[indices[0]], lut[indices[1]], lut[indices[2]], lut[indices[3]] );
+        const __m128 b = _mm_setr_ps( lut[indices[0] + 1], lut[indices[1] + 1], lut[indices[2] + 1], lut[indices[3] + 1] );
+
+        _mm_storeu_ps( _gains + i, _mm_add_ps( a, _mm_mul_ps( t, _mm_sub_ps( b, a ) ) ) );
+    }
+#elif defined( AUDIO_CURVE_NEON )
+    const float32x4_t scale4 = vdupq_n_f32( scale );
+    const float32x4_t zero4  = vdupq_n_f32( 0.0f );
+    const float32x4_t end4   = vdupq_n_f32( end );
+    const float32x4_t last4  = vdupq_n_f32( last );
+
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        const float32x4_t x     = vminq_f32( vmaxq_f32( vmulq_f32( vld1q_f32( _distances + i ), scale4 ), zero4 ), end4 );
+        const int32x4_t   index = vcvtq_s32_f32( vminq_f32( x, last4 ) );
+        const float32x4_t t     = vsubq_f32( x, vcvtq_f32_s32( index ) );
+
+        int32_t indices[4];
+        vst1q_s32( indices, index );
+
+        const float       lo[4] { lut[indices[0]], lut[indices[1]], lut[indices[2]], lut[indices[3]] };
+        const float       hi[4] { lut[indices[0] + 1], lut[indices[1] + 1], lut[indices[2] + 1], lut[indices[3] + 1] };
+        const float32x4_t a = vld1q_f32( lo );
+        const float32x4_t b = vld1q_f32( hi );
+
+        vst1q_f32( _gains + i, vmlaq_f32( a, t, vsubq_f32( b, a ) ) );
+    }
+#endif
+
+    // The remaining distances.
+    for ( ; i < count; ++i )
+    {
+        const float  x     = std::min( std::max( 0.0f, _distances[i] * scale ), end );
+        const size_t index = static_cast<size_t>( std::min( x, last ) );
+        const float  t     = x - static_cast<float>( index );
+
+        _gains[i] = lut[index] + t * ( lut[index + 1] - lut[index] );
+    }
+}
+
+void AttenuationCurveImpl::attach( SoundImpl* sound )
+{
+    ma_sound* pSound = sound->getSound();
+
+    // The spatializer attenuates linearly from the listener, and the slope is fitted by the audio thread.
+    ma_sound_set_attenuation_model( pSound, ma_attenuation_model_linear );
+    ma_sound_set_min_distance( pSound, 0.0f );
+    ma_sound_set_max_distance( pSound, 1.0f );
+    ma_sound_set_rolloff( pSound, 1.0f - table[0] );
+
+    const auto& attached = sounds.items();
+    if ( std::find( attached.begin(), attached.end(), sound ) != attached.end() )
+        return;
+
+    if ( attached.empty() )
+        device->getAttenuationCurves().add( this );
+
+    sounds.add( sound );
+}
+
+void AttenuationCurveImpl::detach( SoundImpl* sound )
+{
+    sounds.remove( sound );
+
+    if ( sounds.items().empty() )
+        device->getAttenuationCurves().remove( this );
+}
+
+void AttenuationCurveImpl::applyAll( const RealtimeList<AttenuationCurveImpl*>& curves, ma_engine* pEngine )
+{
+    for ( AttenuationCurveImpl* curve: curves.acquire() )
+        curve->apply( pEngine );
+}
+
+void AttenuationCurveImpl::apply( ma_engine* pEngine )
+{
+    const auto& attached = sounds.acquire();
+
+    float distances[ChunkSize];
+    float gains[ChunkSize];
+
+    for ( size_t first = 0; first < attached.size(); first += ChunkSize )
+    {
+        SoundImpl* const* chunk = attached.data() + first;
+        const size_t      count = std::min( attached.size() - first, ChunkSize );
+
+        // Gather the distances from the listeners, look up all gains at once, and fit the attenuation to the gains.
+        for ( size_t i = 0; i < count; ++i )
+        {
+            ma_sound* sound = chunk[i]->getSound();
+            ma_vec3f  relativePosition;
+
+            if ( ma_sound_get_engine( sound ) != pEngine )
+                relativePosition = { 0.0f, 0.0f, 0.0f };
+            else if ( ma_sound_get_positioning( sound ) == ma_positioning_relative )
+            {
+                relativePosition = ma_sound_get_position( sound );
+            }
+            else
+            {
+                const ma_uint32 listener = ma_sound_get_listener_index( sound );
+                ma_spatializer_get_relative_position_and_direction( &sound->engineNode.spatializer, &pEngine->listeners[listener], &relativePosition, nullptr );
+            }
+
+            distances[i] = std::sqrt( relativePosition.x * relativePosition.x + relativePosition.y * relativePosition.y + relativePosition.z * relativePosition.z );
+        }
+
+        getGains( distances, gains, count );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            ma_sound* sound = chunk[i]->getSound();
+            if ( ma_sound_get_engine( sound ) != pEngine )
+                continue;
+
+            // The linear attenuation from 0 to `range` passes through the gain at the current distance.
+            const float distance = std::max( distances[i], MinFitDistance );
+            const float range    = 2.0f * distance + 1.0f;
+
+            ma_sound_set_max_distance( sound, range );
+            ma_sound_set_rolloff( sound, ( 1.0f - gains[i] ) * range / distance );
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Audio/AttenuationCurve.hpp>
+
+#include "Realtime.hpp"
+
+#include "miniaudio.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Audio
+{
+class DeviceImpl;
+class SoundImpl;
+
+/// <summary>
+/// An attenuation curve that is baked into a lookup table.
+/// </summary>
+/// <remarks>
+/// The spatializer of the sounds still computes the gain (so the cone, the gain limits, and the smoothing
+/// of the gain are unchanged), but with a linear attenuation model that is fitted to the gain of the curve
+/// at the current distance of each sound. The fit is exact at the distance it was made for, and it is
+/// updated by the audio thread before each chunk is rendered.
+/// </remarks>
+class AttenuationCurveImpl
+{
+public:
+    AttenuationCurveImpl( std::shared_ptr<DeviceImpl> device, const AttenuationCurve::Point* points, size_t count, AttenuationCurve::Interpolation interpolation );
+    ~AttenuationCurveImpl();
+
+    /// <summary>
+    /// Load the points of a curve from a text file: one point (distance and gain) per line,
+    /// separated by whitespace or a comma. Empty lines and lines that start with `#` are skipped.
+    /// </summary>
+    /// <returns>The curve, or `nullptr` if the file can't be read or contains no points.</returns>
+    static std::shared_ptr<AttenuationCurveImpl> load( std::shared_ptr<DeviceImpl> device, const std::filesystem::path& filePath, AttenuationCurve::Interpolation interpolation );
+
+    float getGain( float distance ) const noexcept;
+
+    /// <summary>
+    /// Look up the gains of many distances at once.
+    /// </summary>
+    void getGains( const float* distances, float* gains, size_t count ) const noexcept;
+
+    float getMaxDistance() const noexcept
+    {
+        return maxDistance;
+    }
+
+    /// <summary>
+    /// Attach a sound to this curve (or detach it). The attenuation model of the sound is replaced by the curve while it is attached.
+    /// </summary>
+    void attach( SoundImpl* sound );
+    void detach( SoundImpl* sound );
+
+    /// <summary>
+    /// Fit the attenuation of all sounds of an engine that are attached to a curve to the gain of the curve (on the audio thread).
+    /// </summary>
+    /// <param name="curves">The curves of the device that have sounds attached.</param>
+    /// <param name="pEngine">The engine.</param>
+    static void applyAll( const RealtimeList<AttenuationCurveImpl*>& curves, ma_engine* pEngine );
+
+    // The number of intervals of the lookup table.
+    static constexpr size_t TableSize = 256;
+
+    AttenuationCurveImpl( const AttenuationCurveImpl& )            = delete;
+    AttenuationCurveImpl( AttenuationCurveImpl&& )                 = delete;
+    AttenuationCurveImpl& operator=( const AttenuationCurveImpl& ) = delete;
+    AttenuationCurveImpl& operator=( AttenuationCurveImpl&& )      = delete;
+
+private:
+    void apply( ma_engine* pEngine );
+
+    // The device that owns the list of the curves that have sounds attached.
+    std::shared_ptr<DeviceImpl> device;
+
+    // The gains at `TableSize + 1` equally spaced distances from 0 to `maxDistance`.
+    std::vector<float> table;
+    float              maxDistance = 0.0f;
+    float              scale       = 0.0f;
+
+    // The attached sounds (read by the audio thread).
+    RealtimeList<SoundImpl*> sounds;
+};
+}  // namespace Audio
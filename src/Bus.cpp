@@ -0,0 +1,189 @@
+#include <Audio/Bus.hpp>
+#include <Audio/Device.hpp>
+
+#include "BusImpl.hpp"
+#include "ListenerImpl.hpp"
+#include "RoomImpl.hpp"
+
+using namespace Audio;
+
+struct MakeBus : Bus
+{
+    MakeBus( std::shared_ptr<BusImpl> impl )
+    : Bus( std::move( impl ) )
+    {}
+};
+
+Bus::Bus()                            = default;
+Bus::~Bus()                           = default;
+Bus::Bus( const Bus& )                = default;
+Bus::Bus( Bus&& ) noexcept            = default;
+Bus& Bus::operator=( const Bus& )     = default;
+Bus& Bus::operator=( Bus&& ) noexcept = default;
+
+Bus& Bus::operator=( nullptr_t ) noexcept
+{
+    impl = nullptr;
+    return *this;
+}
+
+bool Bus::operator==( nullptr_t ) const noexcept
+{
+    return impl == nullptr;
+}
+
+bool Bus::operator!=( nullptr_t ) const noexcept
+{
+    return impl != nullptr;
+}
+
+Bus::operator bool() const noexcept
+{
+    return impl != nullptr;
+}
+
+std::shared_ptr<BusImpl> Bus::get() const noexcept
+{
+    return impl;
+}
+
+void Bus::reset() noexcept
+{
+    impl.reset();
+}
+
+Bus::Bus( std::shared_ptr<BusImpl> impl )
+: impl { std::move( impl ) }
+{}
+
+Bus::Bus( Type type )
+{
+    *this = Device::getBus( type );
+}
+
+void Bus::setVolume( float volume )
+{
+    impl->setVolume( volume );
+}
+
+float Bus::getVolume() const
+{
+    return impl->getVolume();
+}
+
+void Bus::setPitch( float pitch )
+{
+    impl->setPitch( pitch );
+}
+
+float Bus::getPitch() const
+{
+    return impl->getPitch();
+}
+
+void Bus::setMuted( bool muted )
+{
+    impl->setMuted( muted );
+}
+
+bool Bus::isMuted() const
+{
+    return impl->isMuted();
+}
+
+void Bus::setParallel( bool parallel )
+{
+    impl->setParallel( parallel );
+}
+
+bool Bus::isParallel() const
+{
+    return impl->isParallel();
+}
+
+void Bus::setClustering( float clusterSize )
+{
+    impl->setClustering( clusterSize );
+}
+
+float Bus::getClustering() const
+{
+    return impl->getClustering();
+}
+
+void Bus::setZoneSends( bool enabled )
+{
+    impl->setZoneSends( enabled );
+}
+
+bool Bus::getZoneSends() const
+{
+    return impl->getZoneSends();
+}
+
+void Bus::setAmbisonics( Ambisonics ambisonics, bool binaural )
+{
+    impl->setAmbisonics( ambisonics, binaural );
+}
+
+Bus::Ambisonics Bus::getAmbisonics() const
+{
+    return impl->getAmbisonics();
+}
+
+void Bus::setRoom( const Room& room )
+{
+    impl->setRoom( room.get() );
+}
+
+void Bus::setListener( const Listener& listener )
+{
+    const auto listenerImpl = listener.get();
+    impl->setListener( listenerImpl ? listenerImpl->getIndex() : MA_LISTENER_INDEX_CLOSEST );
+}
+
+Listener Bus::getListener() const
+{
+    const ma_uint32 listenerIndex = impl->getListener();
+    return listenerIndex != MA_LISTENER_INDEX_CLOSEST ? Device::getListener( listenerIndex ) : Listener {};
+}
+
+void Bus::setOutputChannels( uint32_t firstChannel, uint32_t channelCount )
+{
+    impl->setOutputChannels( firstChannel, channelCount );
+}
+
+Bus Bus::getParent() const
+{
+    return MakeBus( impl->getParent() );
+}
+
+void Bus::addEffect( const Effect& effect )
+{
+    impl->addEffect( effect.get() );
+}
+
+void Bus::removeEffect( const Effect& effect )
+{
+    impl->removeEffect( effect.get() );
+}
+
+void Bus::clearEffects()
+{
+    impl->clearEffects();
+}
+
+void Bus::setSend( const Bus& target, float level )
+{
+    impl->setSend( target.get(), level );
+}
+
+float Bus::getSend( const Bus& target ) const
+{
+    return impl->getSend( target.get() );
+}
+
+void Bus::removeSend( const Bus& target )
+{
+    impl->removeSend( target.get() );
+}
@@ -0,0 +1,553 @@
+#include "BusImpl.hpp"
+#include "Ambisonics.hpp"
+#include "ChannelRouter.hpp"
+#include "Clusterer.hpp"
+#include "EarlyReflections.hpp"
+#include "EffectImpl.hpp"
+#include "ParallelMixer.hpp"
+#include "ReverbZoneImpl.hpp"
+#include "SoundImpl.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Audio;
+
+namespace
+{
+// The buses that have clustering enabled.
+std::mutex& getClusteringMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<BusImpl*>& getClusteringBuses()
+{
+    static std::vector<BusImpl*> buses;
+    return buses;
+}
+}  // namespace
+
+BusImpl::BusImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, std::shared_ptr<BusImpl> parent, ParallelMixer* mixer )
+: device { std::move( device ) }
+, engine { pEngine }
+, parent { std::move( parent ) }
+, mixer { this->parent ? this->parent->mixer : mixer }
+{
+    ma_sound_group* parentGroup = this->parent ? &this->parent->group : nullptr;
+
+    if ( ma_sound_group_init( engine, MA_SOUND_FLAG_NO_SPATIALIZATION, parentGroup, &group ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize bus." << std::endl;
+    }
+}
+
+BusImpl::~BusImpl()
+{
+    setClustering( 0.0f );
+    decoder.reset();
+    reflections.reset();
+
+    if ( zoneSends )
+        ReverbZoneImpl::removeSource( this );
+
+    // Detach the effects before they are destroyed.
+    for ( auto& effect: effects )
+    {
+        ma_node_detach_output_bus( effect->getNode(), 0 );
+        effect->setBus( nullptr );
+    }
+
+    sends.clear();
+
+    if ( submix )
+    {
+        mixer->remove( submix.get() );
+        submix.reset();
+    }
+
+    ma_sound_group_uninit( &group );
+}
+
+void BusImpl::setVolume( float _volume )
+{
+    volume = _volume;
+
+    if ( !muted )
+    {
+        ma_sound_group_set_volume( &group, volume );
+    }
+}
+
+float BusImpl::getVolume() const noexcept
+{
+    return volume;
+}
+
+void BusImpl::setPitch( float pitch )
+{
+    ma_sound_group_set_pitch( &group, pitch );
+}
+
+float BusImpl::getPitch() const
+{
+    return ma_sound_group_get_pitch( &group );
+}
+
+void BusImpl::setMuted( bool _muted )
+{
+    muted = _muted;
+    ma_sound_group_set_volume( &group, muted ? 0.0f : volume );
+}
+
+bool BusImpl::isMuted() const noexcept
+{
+    return muted;
+}
+
+void BusImpl::setParallel( bool parallel )
+{
+    if ( parallel == isParallel() )
+        return;
+
+    if ( parallel )
+    {
+        if ( !mixer || !parent )
+        {
+            std::cerr << "Failed to make bus parallel: the master bus is always rendered on the audio thread." << std::endl;
+            return;
+        }
+
+        auto newSubmix = std::make_unique<ParallelSubmix>( engine );
+        if ( !newSubmix->isInitialized() )
+            return;
+
+        submix = std::move( newSubmix );
+        connect();
+        mixer->add( submix.get() );
+    }
+    else
+    {
+        // Make sure the submix is no longer rendered (or read) before it is destroyed.
+        ma_node_detach_output_bus( submix->getOutputNode(), 0 );
+        mixer->remove( submix.get() );
+
+        auto oldSubmix = std::move( submix );
+        connect();
+    }
+}
+
+bool BusImpl::isParallel() const noexcept
+{
+    return submix != nullptr;
+}
+
+void BusImpl::addEffect( std::shared_ptr<EffectImpl> effect )
+{
+    if ( !effect )
+        return;
+
+    if ( effect->getBus() )
+    {
+        std::cerr << "Failed to add effect: the effect is already in the effect chain of a bus." << std::endl;
+        return;
+    }
+
+    const auto sidechain = effect->getSidechain();
+    if ( sidechain && feeds( sidechain.get() ) )
+    {
+        std::cerr << "Failed to add effect: this bus feeds into the sidechain of the effect." << std::endl;
+        return;
+    }
+
+    if ( sidechain && sidechain->getOutputParallelRoot() != getParallelRoot() )
+    {
+        std::cerr << "Failed to add effect: the sidechain of the effect is rendered by another parallel bus." << std::endl;
+        return;
+    }
+
+    effect->setBus( this );
+    effects.push_back( std::move( effect ) );
+
+    connect();
+}
+
+void BusImpl::removeEffect( const std::shared_ptr<EffectImpl>& effect )
+{
+    const auto iter = std::find( effects.begin(), effects.end(), effect );
+    if ( iter == effects.end() )
+        return;
+
+    ma_node_detach_output_bus( effect->getNode(), 0 );
+    effect->setBus( nullptr );
+    effects.erase( iter );
+
+    connect();
+}
+
+void BusImpl::clearEffects()
+{
+    for ( auto& effect: effects )
+    {
+        ma_node_detach_output_bus( effect->getNode(), 0 );
+        effect->setBus( nullptr );
+    }
+    effects.clear();
+
+    connect();
+}
+
+BusImpl::Send::Send( std::shared_ptr<BusImpl> _target, float _level, ma_engine* pEngine )
+: target { std::move( _target ) }
+, level { _level }
+{
+    // Note: miniaudio does not support more than 2 output buses per splitter, so every send has its own splitter.
+    const ma_splitter_node_config config = ma_splitter_node_config_init( ma_engine_get_channels( pEngine ) );
+
+    if ( ma_splitter_node_init( ma_engine_get_node_graph( pEngine ), &config, nullptr, &splitter ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize bus send." << std::endl;
+        return;
+    }
+
+    attach( target->getInputNode(), 0 );
+}
+
+BusImpl::Send::Send( std::shared_ptr<EffectImpl> _sidechain, ma_engine* pEngine )
+: sidechain { std::move( _sidechain ) }
+{
+    const ma_splitter_node_config config = ma_splitter_node_config_init( ma_engine_get_channels( pEngine ) );
+
+    if ( ma_splitter_node_init( ma_engine_get_node_graph( pEngine ), &config, nullptr, &splitter ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize bus sidechain." << std::endl;
+        return;
+    }
+
+    attach( sidechain->getNode(), 1 );
+}
+
+void BusImpl::Send::attach( ma_node* node, ma_uint32 inputBus )
+{
+    ma_node_attach_output_bus( &splitter, 1, node, inputBus );
+    ma_node_set_output_bus_volume( &splitter, 1, level );
+}
+
+BusImpl::Send::~Send()
+{
+    ma_splitter_node_uninit( &splitter, nullptr );
+}
+
+void BusImpl::setSend( std::shared_ptr<BusImpl> target, float level )
+{
+    if ( !target )
+        return;
+
+    const auto iter = std::find_if( sends.begin(), sends.end(), [&target]( const auto& send ) { return send->target == target; } );
+    if ( iter != sends.end() )
+    {
+        ( *iter )->level = level;
+        ma_node_set_output_bus_volume( &( *iter )->splitter, 1, level );
+        return;
+    }
+
+    if ( target->feeds( this ) )
+    {
+        std::cerr << "Failed to add send: the target bus feeds into this bus." << std::endl;
+        return;
+    }
+
+    if ( getOutputParallelRoot() != target->getParallelRoot() )
+    {
+        std::cerr << "Failed to add send: the target bus is rendered by another parallel bus." << std::endl;
+        return;
+    }
+
+    sends.push_back( std::make_unique<Send>( std::move( target ), level, engine ) );
+
+    connect();
+}
+
+float BusImpl::getSend( const std::shared_ptr<BusImpl>& target ) const noexcept
+{
+    const auto iter = std::find_if( sends.begin(), sends.end(), [&target]( const auto& send ) { return send->target == target; } );
+    return iter != sends.end() ? ( *iter )->level : 0.0f;
+}
+
+void BusImpl::removeSend( const std::shared_ptr<BusImpl>& target )
+{
+    const auto iter = std::find_if( sends.begin(), sends.end(), [&target]( const auto& send ) { return send->target == target; } );
+    if ( iter == sends.end() )
+        return;
+
+    sends.erase( iter );
+
+    connect();
+}
+
+bool BusImpl::addSidechain( std::shared_ptr<EffectImpl> effect )
+{
+    if ( !effect )
+        return false;
+
+    const BusImpl* effectBus = effect->getBus();
+    if ( effectBus && effectBus->feeds( this ) )
+    {
+        std::cerr << "Failed to add sidechain: the bus of the effect feeds into this bus." << std::endl;
+        return false;
+    }
+
+    if ( effectBus && getOutputParallelRoot() != effectBus->getParallelRoot() )
+    {
+        std::cerr << "Failed to add sidechain: the effect is rendered by another parallel bus." << std::endl;
+        return false;
+    }
+
+    sends.push_back( std::make_unique<Send>( std::move( effect ), engine ) );
+
+    connect();
+
+    return true;
+}
+
+void BusImpl::removeSidechain( const EffectImpl* effect )
+{
+    const auto iter = std::find_if( sends.begin(), sends.end(), [effect]( const auto& send ) { return send->sidechain.get() == effect; } );
+    if ( iter == sends.end() )
+        return;
+
+    sends.erase( iter );
+
+    connect();
+}
+
+bool BusImpl::feeds( const BusImpl* bus ) const noexcept
+{
+    if ( this == bus )
+        return true;
+
+    if ( parent && parent->feeds( bus ) )
+        return true;
+
+    return std::any_of( sends.begin(), sends.end(), [bus]( const auto& send ) {
+        const BusImpl* target = send->target ? send->target.get() : send->sidechain->getBus();
+        return target && target->feeds( bus );
+    } );
+}
+
+const BusImpl* BusImpl::getParallelRoot() const noexcept
+{
+    for ( const BusImpl* bus = this; bus; bus = bus->parent.get() )
+    {
+        if ( bus->submix )
+            return bus;
+    }
+
+    return nullptr;
+}
+
+const BusImpl* BusImpl::getOutputParallelRoot() const noexcept
+{
+    if ( !submix )
+        return getParallelRoot();
+
+    return parent ? parent->getParallelRoot() : nullptr;
+}
+
+void BusImpl::connect()
+{
+    ma_node* output = parent ? parent->getInputNode() : ma_engine_get_endpoint( engine );
+    ma_node* node   = &group;
+
+    // Chain the effects and sends: group -> effect[0] -> ... -> effect[n-1] -> send[0] -> ... -> send[m-1] -> parent.
+    for ( auto& effect: effects )
+    {
+        ma_node_attach_output_bus( node, 0, effect->getNode(), 0 );
+        node = effect->getNode();
+    }
+
+    // Parallel buses: the group and effect chain are rendered into the submix (on a worker thread),
+    // and the sends and the parent are fed from the output of the submix.
+    if ( submix )
+    {
+        ma_node_attach_output_bus( node, 0, submix->getInputNode(), 0 );
+        node = submix->getOutputNode();
+    }
+
+    for ( auto& send: sends )
+    {
+        ma_node_attach_output_bus( node, 0, &send->splitter, 0 );
+        node = &send->splitter;
+    }
+
+    // The sends get the full mix, only the output to the parent is routed.
+    if ( router )
+    {
+        ma_node_attach_output_bus( node, 0, router->getNode(), 0 );
+        node = router->getNode();
+    }
+
+    ma_node_attach_output_bus( node, 0, output, 0 );
+}
+
+void BusImpl::addSound( SoundImpl* sound )
+{
+    std::lock_guard lock { soundsMutex };
+    sounds.push_back( sound );
+}
+
+void BusImpl::removeSound( SoundImpl* sound )
+{
+    std::lock_guard lock { soundsMutex };
+
+    if ( clusterer )
+        clusterer->remove( sound );
+
+    const auto iter = std::find( sounds.begin(), sounds.end(), sound );
+    if ( iter != sounds.end() )
+        sounds.erase( iter );
+}
+
+void BusImpl::setClustering( float size )
+{
+    {
+        std::lock_guard lock { soundsMutex };
+
+        if ( size > 0.0f && clusterer )
+        {
+            clusterer->setSize( size );
+            return;
+        }
+
+        if ( size <= 0.0f && !clusterer )
+            return;
+
+        // Destroying the clusterer spatializes the sounds individually again.
+        clusterer = size > 0.0f ? std::make_unique<Clusterer>( engine, &group, size ) : nullptr;
+    }
+
+    std::lock_guard lock { getClusteringMutex() };
+    auto&           buses = getClusteringBuses();
+
+    if ( size > 0.0f )
+        buses.push_back( this );
+    else
+        buses.erase( std::remove( buses.begin(), buses.end(), this ), buses.end() );
+}
+
+float BusImpl::getClustering() const noexcept
+{
+    std::lock_guard lock { soundsMutex };
+    return clusterer ? clusterer->getSize() : 0.0f;
+}
+
+void BusImpl::updateClusters()
+{
+    std::lock_guard lock { getClusteringMutex() };
+
+    for ( BusImpl* bus: getClusteringBuses() )
+    {
+        std::lock_guard soundsLock { bus->soundsMutex };
+        bus->clusterer->update( bus->sounds );
+    }
+}
+
+void BusImpl::setZoneSends( bool enabled )
+{
+    if ( enabled == zoneSends )
+        return;
+
+    zoneSends = enabled;
+
+    if ( zoneSends )
+    {
+        ReverbZoneImpl::addSource( this );
+    }
+    else
+    {
+        ReverbZoneImpl::removeSource( this );
+
+        for ( const auto& target: ReverbZoneImpl::getTargets() )
+            removeSend( target );
+    }
+}
+
+void BusImpl::setAmbisonics( Bus::Ambisonics ambisonics, bool binaural )
+{
+    // The sound field is rendered for the listener of the bus (or the first listener).
+    const ma_uint32 listener = listenerIndex == MA_LISTENER_INDEX_CLOSEST ? 0 : listenerIndex;
+
+    if ( ambisonics == getAmbisonics() && ( !decoder || ( decoder->isBinaural() == binaural && decoder->getListenerIndex() == listener ) ) )
+        return;
+
+    const ma_uint32 order = ambisonics == Bus::Ambisonics::ThirdOrder ? 3 : 1;
+
+    auto previous = std::move( decoder );
+    if ( ambisonics != Bus::Ambisonics::None )
+    {
+        decoder = std::make_unique<AmbisonicDecoder>( engine, order, binaural, listener );
+        ma_node_attach_output_bus( decoder->getNode(), 0, &group, 0 );
+    }
+
+    // Move the sounds to the new decoder before the previous decoder is destroyed.
+    std::lock_guard lock { soundsMutex };
+    for ( SoundImpl* sound: sounds )
+        sound->updateAmbisonics();
+}
+
+Bus::Ambisonics BusImpl::getAmbisonics() const noexcept
+{
+    if ( !decoder )
+        return Bus::Ambisonics::None;
+
+    return decoder->getOrder() == 3 ? Bus::Ambisonics::ThirdOrder : Bus::Ambisonics::FirstOrder;
+}
+
+void BusImpl::setRoom( std::shared_ptr<RoomImpl> room )
+{
+    if ( ( reflections ? reflections->getRoom() : nullptr ) == room )
+        return;
+
+    auto previous = std::move( reflections );
+    if ( room )
+    {
+        reflections = std::make_unique<EarlyReflections>( engine, std::move( room ) );
+        ma_node_attach_output_bus( reflections->getNode(), 0, &group, 0 );
+    }
+
+    // Move the sounds to the new delay line before the previous delay line is destroyed.
+    std::lock_guard lock { soundsMutex };
+    for ( SoundImpl* sound: sounds )
+        sound->updateReflections();
+}
+
+void BusImpl::setListener( ma_uint32 _listenerIndex )
+{
+    if ( listenerIndex == _listenerIndex )
+        return;
+
+    listenerIndex = _listenerIndex;
+
+    {
+        std::lock_guard lock { soundsMutex };
+        for ( SoundImpl* sound: sounds )
+            sound->updateListener();
+    }
+
+    // Render the sound field for the new listener.
+    if ( decoder )
+        setAmbisonics( getAmbisonics(), decoder->isBinaural() );
+}
+
+void BusImpl::setOutputChannels( ma_uint32 firstChannel, ma_uint32 channelCount )
+{
+    if ( router ? router->getFirstChannel() == firstChannel && router->getChannelCount() == channelCount : channelCount == 0 )
+        return;
+
+    // Reconnect to the new router before the previous router is destroyed.
+    auto previous = std::move( router );
+    router        = channelCount > 0 ? std::make_unique<ChannelRouter>( engine, firstChannel, channelCount ) : nullptr;
+
+    connect();
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <Audio/Bus.hpp>
+
+#include "miniaudio.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Audio
+{
+class AmbisonicDecoder;
+class ChannelRouter;
+class Clusterer;
+class DeviceImpl;
+class EarlyReflections;
+class EffectImpl;
+class ParallelMixer;
+class ParallelSubmix;
+class RoomImpl;
+class SoundImpl;
+
+class BusImpl
+{
+public:
+    /// <summary>
+    /// Create a bus.
+    /// </summary>
+    /// <param name="device">The device that owns the engine.</param>
+    /// <param name="pEngine">The engine.</param>
+    /// <param name="parent">The parent bus (or `nullptr` for the master bus).</param>
+    /// <param name="mixer">(optional) The mixer that renders parallel buses. Child buses use the mixer of their parent.</param>
+    BusImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, std::shared_ptr<BusImpl> parent, ParallelMixer* mixer = nullptr );
+    ~BusImpl();
+
+    void  setVolume( float volume );
+    float getVolume() const noexcept;
+
+    void  setPitch( float pitch );
+    float getPitch() const;
+
+    void setMuted( bool muted );
+    bool isMuted() const noexcept;
+
+    void setParallel( bool parallel );
+    bool isParallel() const noexcept;
+
+    const std::shared_ptr<BusImpl>& getParent() const noexcept
+    {
+        return parent;
+    }
+
+    void addEffect( std::shared_ptr<EffectImpl> effect );
+    void removeEffect( const std::shared_ptr<EffectImpl>& effect );
+    void clearEffects();
+
+    void  setSend( std::shared_ptr<BusImpl> target, float level );
+    float getSend( const std::shared_ptr<BusImpl>& target ) const noexcept;
+    void  removeSend( const std::shared_ptr<BusImpl>& target );
+
+    /// <summary>
+    /// Send the output of this bus to the sidechain input (input bus 1) of an effect.
+    /// </summary>
+    bool addSidechain( std::shared_ptr<EffectImpl> effect );
+    void removeSidechain( const EffectImpl* effect );
+
+    /// <summary>
+    /// Check if the output of this bus reaches the given bus (through parents, sends, or sidechains).
+    /// </summary>
+    bool feeds( const BusImpl* bus ) const noexcept;
+
+    /// <summary>
+    /// Get the closest parallel bus that this bus is part of (this bus, or one of its ancestors).
+    /// All nodes of a parallel bus are rendered by a single thread, so nodes can only be
+    /// connected to nodes that are rendered by the same thread.
+    /// </summary>
+    const BusImpl* getParallelRoot() const noexcept;
+
+    /// <summary>
+    /// Get the parallel bus that the output of this bus (after the effect chain) is part of.
+    /// </summary>
+    const BusImpl* getOutputParallelRoot() const noexcept;
+
+    /// <summary>
+    /// Register a sound that plays on this bus (for clustering).
+    /// </summary>
+    void addSound( SoundImpl* sound );
+    void removeSound( SoundImpl* sound );
+
+    /// <summary>
+    /// Cluster the spatialized sounds of this bus.
+    /// </summary>
+    /// <param name="size">The cluster size (relative to the distance to the listener), or 0 to disable clustering.</param>
+    void  setClustering( float size );
+    float getClustering() const noexcept;
+
+    /// <summary>
+    /// Update the clusters of all buses that have clustering enabled.
+    /// </summary>
+    static void updateClusters();
+
+    /// <summary>
+    /// Let the reverb zones drive the sends of this bus.
+    /// </summary>
+    void setZoneSends( bool enabled );
+    bool getZoneSends() const noexcept
+    {
+        return zoneSends;
+    }
+
+    /// <summary>
+    /// Mix the spatialized sounds of this bus into an ambisonic sound field, which is decoded once
+    /// for the whole bus (to the speakers, or binaurally with the current HRTF).
+    /// </summary>
+    void              setAmbisonics( Bus::Ambisonics ambisonics, bool binaural );
+    Bus::Ambisonics   getAmbisonics() const noexcept;
+    AmbisonicDecoder* getAmbisonicDecoder() const noexcept
+    {
+        return decoder.get();
+    }
+
+    /// <summary>
+    /// Render the early reflections of the 3D sounds of this bus in a room (or `nullptr` to remove the reflections).
+    /// </summary>
+    void              setRoom( std::shared_ptr<RoomImpl> room );
+    EarlyReflections* getEarlyReflections() const noexcept
+    {
+        return reflections.get();
+    }
+
+    /// <summary>
+    /// Pin the 3D sounds of this bus to a listener (or `MA_LISTENER_INDEX_CLOSEST` to spatialize them for the closest listener).
+    /// </summary>
+    void      setListener( ma_uint32 listenerIndex );
+    ma_uint32 getListener() const noexcept
+    {
+        return listenerIndex;
+    }
+
+    /// <summary>
+    /// Route the output of this bus to `channelCount` output channels, starting at `firstChannel`
+    /// (or to all output channels if `channelCount` is 0).
+    /// </summary>
+    void setOutputChannels( ma_uint32 firstChannel, ma_uint32 channelCount );
+
+    /// <summary>
+    /// Get the node that sounds and child buses should attach to.
+    /// </summary>
+    ma_node* getInputNode() noexcept
+    {
+        return &group;
+    }
+
+    BusImpl( const BusImpl& )            = delete;
+    BusImpl( BusImpl&& )                 = delete;
+    BusImpl& operator=( const BusImpl& ) = delete;
+    BusImpl& operator=( BusImpl&& )      = delete;
+
+private:
+    // Connect the group and effect chain to the parent bus (and the send targets).
+    void connect();
+
+    std::shared_ptr<DeviceImpl> device;
+    ma_engine*                  engine = nullptr;
+    std::shared_ptr<BusImpl>    parent;
+    ParallelMixer*              mixer = nullptr;
+
+    float volume = 1.0f;
+    bool  muted  = false;
+
+    std::vector<std::shared_ptr<EffectImpl>> effects;
+
+    struct Send
+    {
+        Send( std::shared_ptr<BusImpl> target, float level, ma_engine* pEngine );
+        Send( std::shared_ptr<EffectImpl> sidechain, ma_engine* pEngine );
+        ~Send();
+
+        // Attach output bus 1 of the splitter to the given input bus of a node.
+        void attach( ma_node* node, ma_uint32 inputBus );
+
+        // Either the target bus or the effect with a sidechain input is set.
+        std::shared_ptr<BusImpl>    target;
+        std::shared_ptr<EffectImpl> sidechain;
+        float                       level = 1.0f;
+        // Output bus 0 of the splitter continues to the next send (or the parent), output bus 1 goes to the target.
+        ma_splitter_node splitter {};
+    };
+
+    std::vector<std::unique_ptr<Send>> sends;
+
+    // Only set for parallel buses: the group and the effect chain are rendered by the submix on a worker thread.
+    std::unique_ptr<ParallelSubmix> submix;
+
+    // The sounds that play on this bus, and the clusterer (only set if clustering is enabled).
+    mutable std::mutex         soundsMutex;
+    std::vector<SoundImpl*>    sounds;
+    std::unique_ptr<Clusterer> clusterer;
+
+    // The sends to the reverb buses of the reverb zones are set by the zones.
+    bool zoneSends = false;
+
+    // The decoder of the ambisonic mix (only set if ambisonics are enabled).
+    std::unique_ptr<AmbisonicDecoder> decoder;
+
+    // The delay line of the early reflections (only set if the bus has a room).
+    std::unique_ptr<EarlyReflections> reflections;
+
+    // The listener the 3D sounds of this bus are pinned to.
+    ma_uint32 listenerIndex = MA_LISTENER_INDEX_CLOSEST;
+
+    // Routes the output to a range of output channels (only set if the output is routed).
+    std::unique_ptr<ChannelRouter> router;
+
+    ma_sound_group group {};
+};
+}  // namespace Audio
@@ -0,0 +1,162 @@
+#include "ChannelMixer.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Audio;
+
+// -3 dB, for channels that are folded into two channels.
+static constexpr float Half = 0.70710678f;
+
+namespace
+{
+// Add an input channel to the matrix, at the position of the channel or folded into the nearest channels.
+void Route( std::vector<float>& matrix, const std::vector<ma_channel>& outputMap, ma_uint32 inputChannels, ma_uint32 input, ma_channel position, float gain )
+{
+    const auto iter = std::find( outputMap.begin(), outputMap.end(), position );
+    if ( iter != outputMap.end() )
+    {
+        matrix[static_cast<size_t>( iter - outputMap.begin() ) * inputChannels + input] += gain;
+        return;
+    }
+
+    const auto has = [&outputMap]( ma_channel channel ) { return std::find( outputMap.begin(), outputMap.end(), channel ) != outputMap.end(); };
+
+    switch ( position )
+    {
+    case MA_CHANNEL_MONO:
+        // Same as the engine does for stereo.
+        if ( has( MA_CHANNEL_FRONT_LEFT ) )
+        {
+            Route( matrix, outputMap, inputChannels, input, MA_CHANNEL_FRONT_LEFT, gain );
+            Route( matrix, outputMap, inputChannels, input, MA_CHANNEL_FRONT_RIGHT, gain );
+        }
+        else
+        {
+            Route( matrix, outputMap, inputChannels, input, MA_CHANNEL_FRONT_CENTER, gain );
+        }
+        break;
+    case MA_CHANNEL_FRONT_LEFT:
+    case MA_CHANNEL_FRONT_RIGHT:
+        // A mono output is the average of the left and the right channel.
+        if ( has( MA_CHANNEL_MONO ) )
+            Route( matrix, outputMap, inputChannels, input, MA_CHANNEL_MONO, gain * 0.5f );
+        break;
+    case MA_CHANNEL_FRONT_CENTER:
+    case MA_CHANNEL_BACK_CENTER:
+        Route( matrix, outputMap, inputChannels, input, position == MA_CHANNEL_FRONT_CENTER ? MA_CHANNEL_FRONT_LEFT : MA_CHANNEL_BACK_LEFT, gain * Half );
+        Route( matrix, outputMap, inputChannels, input, position == MA_CHANNEL_FRONT_CENTER ? MA_CHANNEL_FRONT_RIGHT : MA_CHANNEL_BACK_RIGHT, gain * Half );
+        break;
+    case MA_CHANNEL_FRONT_LEFT_CENTER:
+        Route( matrix, outputMap, inputChannels, input, MA_CHANNEL_FRONT_LEFT, gain );
+        break;
+    case MA_CHANNEL_FRONT_RIGHT_CENTER:
+        Route( matrix, outputMap, inputChannels, input, MA_CHANNEL_FRONT_RIGHT, gain );
+        break;
+    case MA_CHANNEL_SIDE_LEFT:
+    case MA_CHANNEL_BACK_LEFT:
+    {
+        // Side and back channels are interchangeable, otherwise they are folded into the front.
+        const ma_channel other = position == MA_CHANNEL_SIDE_LEFT ? MA_CHANNEL_BACK_LEFT : MA_CHANNEL_SIDE_LEFT;
+        if ( has( other ) )
+            Route( matrix, outputMap, inputChannels, input, other, gain );
+        else
+            Route( matrix, outputMap, inputChannels, input, MA_CHANNEL_FRONT_LEFT, gain * Half );
+        break;
+    }
+    case MA_CHANNEL_SIDE_RIGHT:
+    case MA_CHANNEL_BACK_RIGHT:
+    {
+        const ma_channel other = position == MA_CHANNEL_SIDE_RIGHT ? MA_CHANNEL_BACK_RIGHT : MA_CHANNEL_SIDE_RIGHT;
+        if ( has( other ) )
+            Route( matrix, outputMap, inputChannels, input, other, gain );
+        else
+            Route( matrix, outputMap, inputChannels, input, MA_CHANNEL_FRONT_RIGHT, gain * Half );
+        break;
+    }
+    default:
+        // The LFE (and channels without a position) are dropped.
+        break;
+    }
+}
+}  // namespace
+
+ChannelMixer::ChannelMixer( ma_engine* pEngine, ma_uint32 _inputChannels )
+: inputChannels { _inputChannels }
+, outputChannels { ma_engine_get_channels( pEngine ) }
+, matrix { computeMatrix( _inputChannels, outputChannels ) }
+{
+    vtable.onProcess      = &ChannelMixer::onProcess;
+    vtable.inputBusCount  = 1;
+    vtable.outputBusCount = 1;
+
+    ma_node_config config  = ma_node_config_init();
+    config.vtable          = &vtable;
+    config.pInputChannels  = &inputChannels;
+    config.pOutputChannels = &outputChannels;
+
+    node.mixer = this;
+
+    if ( ma_node_init( ma_engine_get_node_graph( pEngine ), &config, nullptr, &node.base ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize channel mixer node." << std::endl;
+        return;
+    }
+
+    initialized = true;
+}
+
+ChannelMixer::~ChannelMixer()
+{
+    if ( initialized )
+    {
+        ma_node_uninit( &node.base, nullptr );
+    }
+}
+
+std::vector<float> ChannelMixer::computeMatrix( ma_uint32 _inputChannels, ma_uint32 _outputChannels )
+{
+    std::vector<ma_channel> inputMap( _inputChannels );
+    std::vector<ma_channel> outputMap( _outputChannels );
+    ma_channel_map_init_standard( ma_standard_channel_map_default, inputMap.data(), inputMap.size(), _inputChannels );
+    ma_channel_map_init_standard( ma_standard_channel_map_default, outputMap.data(), outputMap.size(), _outputChannels );
+
+    std::vector<float> result( static_cast<size_t>( _inputChannels ) * _outputChannels, 0.0f );
+    for ( ma_uint32 input = 0; input < _inputChannels; ++input )
+        Route( result, outputMap, _inputChannels, input, inputMap[input], 1.0f );
+
+    return result;
+}
+
+void ChannelMixer::onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut )
+{
+    auto* mixer = static_cast<Node*>( pNode )->mixer;
+
+    // Input and output are processed at the same rate.
+    const ma_uint32 frameCount = std::min( *pFrameCountIn, *pFrameCountOut );
+
+    mixer->process( ppFramesIn[0], ppFramesOut[0], frameCount );
+
+    *pFrameCountIn  = frameCount;
+    *pFrameCountOut = frameCount;
+}
+
+void ChannelMixer::process( const float* in, float* out, ma_uint32 frameCount )
+{
+    for ( ma_uint32 frame = 0; frame < frameCount; ++frame )
+    {
+        const float* src = in + static_cast<size_t>( frame ) * inputChannels;
+        float*       dst = out + static_cast<size_t>( frame ) * outputChannels;
+
+        for ( ma_uint32 output = 0; output < outputChannels; ++output )
+        {
+            const float* gains = matrix.data() + static_cast<size_t>( output ) * inputChannels;
+
+            float sum = 0.0f;
+            for ( ma_uint32 input = 0; input < inputChannels; ++input )
+                sum += gains[input] * src[input];
+
+            dst[output] = sum;
+        }
+    }
+}
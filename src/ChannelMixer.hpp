@@ -0,0 +1,66 @@
+#pragma once
+
+#include "miniaudio.h"
+
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// Up- or downmixes the output of a 2D sound from the channels of the sound to the channels of the engine with
+/// a matrix that is computed once (with the standard channel maps). Channels that are missing on the output are
+/// folded into the nearest channels (the center and the surround channels at -3 dB), and the LFE channel is dropped
+/// when the output has no LFE channel. Stereo content is not spread to the center and the surround channels.
+/// </summary>
+class ChannelMixer
+{
+public:
+    ChannelMixer( ma_engine* pEngine, ma_uint32 inputChannels );
+    ~ChannelMixer();
+
+    /// <summary>
+    /// Check if a sound needs a mixer: the engine only duplicates mono sounds to all channels,
+    /// and drops (or silences) the other channels of sounds that don't match the engine.
+    /// </summary>
+    static bool isNeeded( ma_uint32 inputChannels, ma_uint32 outputChannels ) noexcept
+    {
+        return inputChannels != outputChannels && !( inputChannels == 1 && outputChannels == 2 );
+    }
+
+    /// <summary>
+    /// Compute the mix matrix (the gain of each input channel for each output channel).
+    /// </summary>
+    static std::vector<float> computeMatrix( ma_uint32 inputChannels, ma_uint32 outputChannels );
+
+    ma_node* getNode() noexcept
+    {
+        return &node.base;
+    }
+
+    ChannelMixer( const ChannelMixer& )            = delete;
+    ChannelMixer( ChannelMixer&& )                 = delete;
+    ChannelMixer& operator=( const ChannelMixer& ) = delete;
+    ChannelMixer& operator=( ChannelMixer&& )      = delete;
+
+private:
+    static void onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut );
+
+    void process( const float* in, float* out, ma_uint32 frameCount );
+
+    struct Node
+    {
+        ma_node_base  base;
+        ChannelMixer* mixer;
+    };
+
+    ma_node_vtable vtable {};
+    Node           node {};
+    bool           initialized = false;
+
+    ma_uint32 inputChannels;
+    ma_uint32 outputChannels;
+
+    // The gain of each input channel (columns) for each output channel (rows).
+    std::vector<float> matrix;
+};
+}  // namespace Audio
@@ -0,0 +1,86 @@
+#include "ChannelRouter.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Audio;
+
+ChannelRouter::ChannelRouter( ma_engine* pEngine, ma_uint32 _firstChannel, ma_uint32 _channelCount )
+: channels { ma_engine_get_channels( pEngine ) }
+, firstChannel { std::min( _firstChannel, channels - 1 ) }
+, channelCount { std::clamp( _channelCount, 1u, channels - firstChannel ) }
+{
+    // Downmix (or upmix) from the channels of the engine to the channels of the range.
+    const ma_channel_converter_config converterConfig = ma_channel_converter_config_init( ma_format_f32, channels, nullptr, channelCount, nullptr, ma_channel_mix_mode_default );
+    if ( ma_channel_converter_init( &converterConfig, nullptr, &converter ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize channel converter." << std::endl;
+        return;
+    }
+    converterInitialized = true;
+
+    block.resize( static_cast<size_t>( BlockSize ) * channelCount );
+
+    vtable.onProcess      = &ChannelRouter::onProcess;
+    vtable.inputBusCount  = 1;
+    vtable.outputBusCount = 1;
+
+    ma_node_config config  = ma_node_config_init();
+    config.vtable          = &vtable;
+    config.pInputChannels  = &channels;
+    config.pOutputChannels = &channels;
+
+    node.router = this;
+
+    if ( ma_node_init( ma_engine_get_node_graph( pEngine ), &config, nullptr, &node.base ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize channel router node." << std::endl;
+        return;
+    }
+
+    initialized = true;
+}
+
+ChannelRouter::~ChannelRouter()
+{
+    if ( initialized )
+    {
+        ma_node_uninit( &node.base, nullptr );
+    }
+
+    if ( converterInitialized )
+    {
+        ma_channel_converter_uninit( &converter, nullptr );
+    }
+}
+
+void ChannelRouter::onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut )
+{
+    auto* router = static_cast<Node*>( pNode )->router;
+
+    // Input and output are processed at the same rate.
+    const ma_uint32 frameCount = std::min( *pFrameCountIn, *pFrameCountOut );
+
+    router->process( ppFramesIn[0], ppFramesOut[0], frameCount );
+
+    *pFrameCountIn  = frameCount;
+    *pFrameCountOut = frameCount;
+}
+
+void ChannelRouter::process( const float* in, float* out, ma_uint32 frameCount )
+{
+    std::fill_n( out, static_cast<size_t>( frameCount ) * channels, 0.0f );
+
+    for ( ma_uint32 frame = 0; frame < frameCount; frame += BlockSize )
+    {
+        const ma_uint32 count = std::min( frameCount - frame, BlockSize );
+
+        ma_channel_converter_process_pcm_frames( &converter, block.data(), in + static_cast<size_t>( frame ) * channels, count );
+
+        for ( ma_uint32 i = 0; i < count; ++i )
+        {
+            float* dst = out + static_cast<size_t>( frame + i ) * channels + firstChannel;
+            std::copy_n( block.data() + static_cast<size_t>( i ) * channelCount, channelCount, dst );
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "miniaudio.h"
+
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// Routes the output of a bus to a range of output channels: the mix is converted to `channelCount`
+/// channels (with the standard channel maps) and written to the channels starting at `firstChannel`.
+/// The other channels are silent. This is used to send the submixes of different listeners to
+/// different outputs (for example, a headphone pair per player on a multichannel device).
+/// </summary>
+class ChannelRouter
+{
+public:
+    ChannelRouter( ma_engine* pEngine, ma_uint32 firstChannel, ma_uint32 channelCount );
+    ~ChannelRouter();
+
+    ma_node* getNode() noexcept
+    {
+        return &node.base;
+    }
+
+    ma_uint32 getFirstChannel() const noexcept
+    {
+        return firstChannel;
+    }
+
+    ma_uint32 getChannelCount() const noexcept
+    {
+        return channelCount;
+    }
+
+    ChannelRouter( const ChannelRouter& )            = delete;
+    ChannelRouter( ChannelRouter&& )                 = delete;
+    ChannelRouter& operator=( const ChannelRouter& ) = delete;
+    ChannelRouter& operator=( ChannelRouter&& )      = delete;
+
+private:
+    static void onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut );
+
+    void process( const float* in, float* out, ma_uint32 frameCount );
+
+    struct Node
+    {
+        ma_node_base   base;
+        ChannelRouter* router;
+    };
+
+    ma_node_vtable       vtable {};
+    Node                 node {};
+    bool                 initialized = false;
+    ma_channel_converter converter {};
+    bool                 converterInitialized = false;
+
+    ma_uint32 channels;
+    ma_uint32 firstChannel;
+    ma_uint32 channelCount;
+
+    // The converted frames (before they are written to the output channels).
+    static constexpr ma_uint32 BlockSize = 256;
+
+    std::vector<float> block;
+};
+}  // namespace Audio
@@ -0,0 +1,235 @@
+#include "Clusterer.hpp"
+#include "SoundImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace Audio;
+
+namespace
+{
+float distance( const ma_vec3f& a, const ma_vec3f& b ) noexcept
+{
+    const float x = a.x - b.x;
+    const float y = a.y - b.y;
+    const float z = a.z - b.z;
+    return std::sqrt( x * x + y * y + z * z );
+}
+}  // namespace
+
+Clusterer::Clusterer( ma_engine* pEngine, ma_node* _output, float _size )
+: engine { pEngine }
+, output { _output }
+, size { _size }
+{}
+
+Clusterer::~Clusterer()
+{
+    while ( !clusters.empty() )
+        dissolve( clusters.back().get() );
+}
+
+void Clusterer::update( const std::vector<SoundImpl*>& sounds )
+{
+    candidates.clear();
+    for ( auto& cluster: clusters )
+        cluster->members.clear();
+
+    // Sounds stay in their cluster while they are within the cluster size (of the previous update).
+    for ( SoundImpl* sound: sounds )
+    {
+        Cluster* cluster = nullptr;
+        for ( auto& c: clusters )
+        {
+            if ( sound->getCluster() == &c->group )
+            {
+                cluster = c.get();
+                break;
+            }
+        }
+
+        if ( !sound->isClusterable() )
+        {
+            if ( cluster )
+                sound->setCluster( nullptr );
+            continue;
+        }
+
+        const Vector position = sound->getPosition();
+        Candidate    candidate { sound, { position.x, position.y, position.z }, ma_sound_get_listener_index( sound->getSound() ), cluster };
+
+        if ( cluster && ( candidate.listener != cluster->listener || distance( candidate.position, cluster->centroid ) > getRadius( cluster->centroid, cluster->listener ) ) )
+        {
+            sound->setCluster( nullptr );
+            candidate.cluster = nullptr;
+        }
+
+        if ( candidate.cluster )
+            candidate.cluster->members.push_back( sound );
+
+        candidates.push_back( candidate );
+    }
+
+    // Move the clusters to the centroid of their remaining members.
+    for ( auto& cluster: clusters )
+        cluster->centroid = { 0.0f, 0.0f, 0.0f };
+
+    for ( const auto& candidate: candidates )
+    {
+        if ( Cluster* cluster = candidate.cluster )
+        {
+            const float weight = 1.0f / static_cast<float>( cluster->members.size() );
+            cluster->centroid.x += candidate.position.x * weight;
+            cluster->centroid.y += candidate.position.y * weight;
+            cluster->centroid.z += candidate.position.z * weight;
+        }
+    }
+
+    // Add the sounds that are not part of a cluster to the closest cluster that is close enough.
+    for ( auto& candidate: candidates )
+    {
+        if ( candidate.cluster )
+            continue;
+
+        Cluster* closest         = nullptr;
+        float    closestDistance = 0.0f;
+        for ( auto& cluster: clusters )
+        {
+            if ( cluster->members.empty() || cluster->listener != candidate.listener )
+                continue;
+
+            const float d = distance( candidate.position, cluster->centroid );
+            if ( d <= getRadius( cluster->centroid, cluster->listener ) && ( !closest || d < closestDistance ) )
+            {
+                closest         = cluster.get();
+                closestDistance = d;
+            }
+        }
+
+        if ( closest )
+            join( closest, candidate );
+    }
+
+    // Create new clusters for the remaining sounds that are close together.
+    for ( size_t i = 0; i < candidates.size(); ++i )
+    {
+        if ( candidates[i].cluster )
+            continue;
+
+        const float radius  = getRadius( candidates[i].position, candidates[i].listener );
+        Cluster*    cluster = nullptr;
+
+        for ( size_t j = i + 1; j < candidates.size(); ++j )
+        {
+            Candidate& other = candidates[j];
+            if ( other.cluster || other.listener != candidates[i].listener || distance( candidates[i].position, other.position ) > radius )
+                continue;
+
+            if ( !cluster )
+            {
+                cluster = createCluster( candidates[i] );
+                if ( !cluster )
+                    break;
+            }
+
+            join( cluster, other );
+        }
+    }
+
+    // A cluster of a single sound is not cheaper than spatializing the sound itself.
+    for ( size_t i = clusters.size(); i-- > 0; )
+    {
+        if ( clusters[i]->members.size() < 2 )
+            dissolve( clusters[i].get() );
+    }
+
+    for ( auto& cluster: clusters )
+        ma_sound_group_set_position( &cluster->group, cluster->centroid.x, cluster->centroid.y, cluster->centroid.z );
+}
+
+void Clusterer::remove( SoundImpl* sound )
+{
+    for ( auto& cluster: clusters )
+    {
+        const auto iter = std::find( cluster->members.begin(), cluster->members.end(), sound );
+        if ( iter != cluster->members.end() )
+        {
+            cluster->members.erase( iter );
+            sound->setCluster( nullptr );
+            return;
+        }
+    }
+}
+
+float Clusterer::getRadius( const ma_vec3f& position, ma_uint32 listener ) const
+{
+    return size * distance( position, ma_engine_listener_get_position( engine, listener ) );
+}
+
+Clusterer::Cluster* Clusterer::createCluster( Candidate& first )
+{
+    auto cluster = std::make_unique<Cluster>();
+
+    // The cluster only needs to be spatialized (the sounds are pitched by their resamplers).
+    if ( ma_sound_group_init( engine, MA_SOUND_FLAG_NO_PITCH, nullptr, &cluster->group ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize sound cluster." << std::endl;
+        return nullptr;
+    }
+    ma_node_attach_output_bus( &cluster->group, 0, output, 0 );
+
+    // Sound groups are not spatialized by default.
+    ma_sound_group_set_spatialization_enabled( &cluster->group, MA_TRUE );
+
+    // The cluster is attenuated like the sound that started it.
+    const ma_sound* sound = first.sound->getSound();
+    ma_sound_group_set_attenuation_model( &cluster->group, ma_sound_get_attenuation_model( sound ) );
+    ma_sound_group_set_rolloff( &cluster->group, ma_sound_get_rolloff( sound ) );
+    ma_sound_group_set_min_gain( &cluster->group, ma_sound_get_min_gain( sound ) );
+    ma_sound_group_set_max_gain( &cluster->group, ma_sound_get_max_gain( sound ) );
+    ma_sound_group_set_min_distance( &cluster->group, ma_sound_get_min_distance( sound ) );
+    ma_sound_group_set_max_distance( &cluster->group, ma_sound_get_max_distance( sound ) );
+    ma_sound_group_set_pinned_listener_index( &cluster->group, ma_sound_get_pinned_listener_index( sound ) );
+
+    cluster->listener = first.listener;
+    cluster->centroid = first.position;
+
+    Cluster* result = cluster.get();
+    clusters.push_back( std::move( cluster ) );
+
+    join( result, first );
+
+    return result;
+}
+
+void Clusterer::join( Cluster* cluster, Candidate& candidate )
+{
+    cluster->members.push_back( candidate.sound );
+    candidate.cluster = cluster;
+    candidate.sound->setCluster( &cluster->group );
+
+    // Move the centroid towards the new member.
+    const float weight = 1.0f / static_cast<float>( cluster->members.size() );
+    cluster->centroid.x += ( candidate.position.x - cluster->centroid.x ) * weight;
+    cluster->centroid.y += ( candidate.position.y - cluster->centroid.y ) * weight;
+    cluster->centroid.z += ( candidate.position.z - cluster->centroid.z ) * weight;
+}
+
+void Clusterer::dissolve( Cluster* cluster )
+{
+    // Spatialize the members individually again (before the group is destroyed).
+    for ( SoundImpl* sound: cluster->members )
+        sound->setCluster( nullptr );
+
+    for ( auto& candidate: candidates )
+    {
+        if ( candidate.cluster == cluster )
+            candidate.cluster = nullptr;
+    }
+
+    ma_sound_group_uninit( &cluster->group );
+
+    const auto iter = std::find_if( clusters.begin(), clusters.end(), [cluster]( const auto& c ) { return c.get() == cluster; } );
+    clusters.erase( iter );
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "miniaudio.h"
+
+#include <memory>
+#include <vector>
+
+namespace Audio
+{
+class SoundImpl;
+
+/// <summary>
+/// Clusters the spatialized sounds of a bus that are close together (relative to their
+/// distance from the listener). The sounds of a cluster are not spatialized individually:
+/// they are mixed into a single spatialized group at the centroid of the cluster.
+/// </summary>
+/// <remarks>
+/// Clustering is incremental: sounds stay in their cluster while they are within the cluster
+/// size, and only the sounds that left their cluster (or that were not clustered) are matched
+/// against the clusters (and each other) on every update.
+/// </remarks>
+class Clusterer
+{
+public:
+    /// <summary>
+    /// Create a clusterer.
+    /// </summary>
+    /// <param name="pEngine">The engine.</param>
+    /// <param name="output">The node that the clusters are attached to (the input of the bus).</param>
+    /// <param name="size">The maximum distance between a sound and the centroid of its cluster, relative to the distance between the centroid and the listener.</param>
+    Clusterer( ma_engine* pEngine, ma_node* output, float size );
+    ~Clusterer();
+
+    void setSize( float _size ) noexcept
+    {
+        size = _size;
+    }
+
+    float getSize() const noexcept
+    {
+        return size;
+    }
+
+    /// <summary>
+    /// Update the clusters with the current positions of the sounds.
+    /// </summary>
+    /// <param name="sounds">All of the sounds that play on the bus.</param>
+    void update( const std::vector<SoundImpl*>& sounds );
+
+    /// <summary>
+    /// Remove a sound from its cluster (if it is part of one).
+    /// The sound is spatialized individually again.
+    /// </summary>
+    void remove( SoundImpl* sound );
+
+    /// <summary>
+    /// Get the number of clusters.
+    /// </summary>
+    size_t getClusterCount() const noexcept
+    {
+        return clusters.size();
+    }
+
+    Clusterer( const Clusterer& )            = delete;
+    Clusterer( Clusterer&& )                 = delete;
+    Clusterer& operator=( const Clusterer& ) = delete;
+    Clusterer& operator=( Clusterer&& )      = delete;
+
+private:
+    struct Cluster
+    {
+        ma_sound_group          group {};
+        std::vector<SoundImpl*> members;
+        ma_vec3f                centroid {};
+        ma_uint32               listener = 0;
+    };
+
+    struct Candidate
+    {
+        SoundImpl* sound;
+        ma_vec3f   position;
+        ma_uint32  listener;
+        Cluster*   cluster;
+    };
+
+    // The maximum distance between a sound and the centroid of a cluster at the given position.
+    float getRadius( const ma_vec3f& position, ma_uint32 listener ) const;
+
+    Cluster* createCluster( Candidate& first );
+    void     join( Cluster* cluster, Candidate& candidate );
+    void     dissolve( Cluster* cluster );
+
+    ma_engine* engine = nullptr;
+    ma_node*   output = nullptr;
+    float      size   = 0.0f;
+
+    std::vector<std::unique_ptr<Cluster>> clusters;
+    std::vector<Candidate>                candidates;
+};
+}  // namespace Audio
@@ -0,0 +1,75 @@
+#include <Audio/Compressor.hpp>
+#include <Audio/Device.hpp>
+
+#include "CompressorImpl.hpp"
+
+using namespace Audio;
+
+Compressor::Compressor( float threshold, float ratio )
+{
+    *this = Device::createCompressor( threshold, ratio );
+}
+
+Compressor::Compressor( std::shared_ptr<EffectImpl> impl )
+: Effect( std::move( impl ) )
+{}
+
+void Compressor::setThreshold( float threshold )
+{
+    std::static_pointer_cast<CompressorImpl>( get() )->setThreshold( threshold );
+}
+
+float Compressor::getThreshold() const
+{
+    return std::static_pointer_cast<CompressorImpl>( get() )->getThreshold();
+}
+
+void Compressor::setRatio( float ratio )
+{
+    std::static_pointer_cast<CompressorImpl>( get() )->setRatio( ratio );
+}
+
+float Compressor::getRatio() const
+{
+    return std::static_pointer_cast<CompressorImpl>( get() )->getRatio();
+}
+
+void Compressor::setAttack( float attack )
+{
+    std::static_pointer_cast<CompressorImpl>( get() )->setAttack( attack );
+}
+
+float Compressor::getAttack() const
+{
+    return std::static_pointer_cast<CompressorImpl>( get() )->getAttack();
+}
+
+void Compressor::setRelease( float release )
+{
+    std::static_pointer_cast<CompressorImpl>( get() )->setRelease( release );
+}
+
+float Compressor::getRelease() const
+{
+    return std::static_pointer_cast<CompressorImpl>( get() )->getRelease();
+}
+
+void Compressor::setKnee( float knee )
+{
+    std::static_pointer_cast<CompressorImpl>( get() )->setKnee( knee );
+}
+
+float Compressor::getKnee() const
+{
+    return std::static_pointer_cast<CompressorImpl>( get() )->getKnee();
+}
+
+void Compressor::setMakeupGain( float makeupGain )
+{
+    std::static_pointer_cast<CompressorImpl>( get() )->setMakeupGain( makeupGain );
+}
+
+float Compressor::getMakeupGain() const
+{
+    return std::static_pointer_cast<CompressorImpl>( get() )->getMakeupGain();
+}
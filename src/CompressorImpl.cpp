@@ -0,0 +1,144 @@
+#include "CompressorImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+CompressorImpl::CompressorImpl( std::shared_ptr<DeviceImpl> device, float _threshold, float _ratio, ma_engine* pEngine )
+: CustomEffectImpl( std::move( device ), pEngine )
+, threshold { _threshold }
+, ratio { std::max( _ratio, 1.0f ) }
+{}
+
+CompressorImpl::~CompressorImpl()
+{
+    uninit();
+}
+
+void CompressorImpl::setThreshold( float _threshold ) noexcept
+{
+    threshold.store( _threshold, std::memory_order_relaxed );
+}
+
+float CompressorImpl::getThreshold() const noexcept
+{
+    return threshold.load( std::memory_order_relaxed );
+}
+
+void CompressorImpl::setRatio( float _ratio ) noexcept
+{
+    ratio.store( std::max( _ratio, 1.0f ), std::memory_order_relaxed );
+}
+
+float CompressorImpl::getRatio() const noexcept
+{
+    return ratio.load( std::memory_order_relaxed );
+}
+
+void CompressorImpl::setAttack( float _attack ) noexcept
+{
+    attack.store( std::max( _attack, 0.0f ), std::memory_order_relaxed );
+}
+
+float CompressorImpl::getAttack() const noexcept
+{
+    return attack.load( std::memory_order_relaxed );
+}
+
+void CompressorImpl::setRelease( float _release ) noexcept
+{
+    release.store( std::max( _release, 0.0f ), std::memory_order_relaxed );
+}
+
+float CompressorImpl::getRelease() const noexcept
+{
+    return release.load( std::memory_order_relaxed );
+}
+
+void CompressorImpl::setKnee( float _knee ) noexcept
+{
+    knee.store( std::max( _knee, 0.0f ), std::memory_order_relaxed );
+}
+
+float CompressorImpl::getKnee() const noexcept
+{
+    return knee.load( std::memory_order_relaxed );
+}
+
+void CompressorImpl::setMakeupGain( float _makeupGain ) noexcept
+{
+    makeupGain.store( _makeupGain, std::memory_order_relaxed );
+}
+
+float CompressorImpl::getMakeupGain() const noexcept
+{
+    return makeupGain.load( std::memory_order_relaxed );
+}
+
+void CompressorImpl::process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount )
+{
+    const float* in = ppFramesIn[0];
+
+    for ( ma_uint32 f = 0; f < frameCount; f += blockSize )
+    {
+        const ma_uint32 count = std::min( blockSize, frameCount - f );
+        processBlock( in + f * channels, pFramesOut + f * channels, count );
+    }
+}
+
+void CompressorImpl::processBlock( const float* in, float* out, ma_uint32 frameCount )
+{
+    const float t      = threshold.load( std::memory_order_relaxed );
+    const float slope  = 1.0f / ratio.load( std::memory_order_relaxed ) - 1.0f;
+    const float w      = knee.load( std::memory_order_relaxed );
+    const float makeup = makeupGain.load( std::memory_order_relaxed );
+    const float rate   = static_cast<float>( sampleRate );
+
+    // One-pole smoothing coefficients (0 for instant response).
+    const float attackTime   = attack.load( std::memory_order_relaxed );
+    const float releaseTime  = release.load( std::memory_order_relaxed );
+    const float attackCoeff  = attackTime > 0.0f ? std::exp( -1.0f / ( attackTime * rate ) ) : 0.0f;
+    const float releaseCoeff = releaseTime > 0.0f ? std::exp( -1.0f / ( releaseTime * rate ) ) : 0.0f;
+
+    // Detector: the peak level of each frame (linked across channels).
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        float peak = 0.0f;
+        for ( ma_uint32 c = 0; c < channels; ++c )
+            peak = std::max( peak, std::abs( in[f * channels + c] ) );
+
+        level[f] = peak;
+    }
+
+    // Gain computer (with a quadratic soft knee): the gain reduction (in dB) for each frame.
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        const float over = 20.0f * std::log10( std::max( level[f], 1e-9f ) ) - t;
+
+        if ( 2.0f * over <= -w )
+            level[f] = 0.0f;
+        else if ( 2.0f * over < w )
+            level[f] = slope * ( over + w * 0.5f ) * ( over + w * 0.5f ) / ( 2.0f * w );
+        else
+            level[f] = slope * over;
+    }
+
+    // Envelope follower (the only sequential part).
+    float env = envelope;
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        const float coeff = level[f] < env ? attackCoeff : releaseCoeff;
+        env               = level[f] + coeff * ( env - level[f] );
+        level[f]          = env;
+    }
+    envelope = env;
+
+    // Apply the gain.
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        const float gain = std::pow( 10.0f, ( level[f] + makeup ) * 0.05f );
+        for ( ma_uint32 c = 0; c < channels; ++c )
+            out[f * channels + c] = in[f * channels + c] * gain;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "EffectImpl.hpp"
+
+#include <atomic>
+
+namespace Audio
+{
+class CompressorImpl : public CustomEffectImpl
+{
+public:
+    CompressorImpl( std::shared_ptr<DeviceImpl> device, float threshold, float ratio, ma_engine* pEngine );
+    ~CompressorImpl() override;
+
+    void  setThreshold( float threshold ) noexcept;
+    float getThreshold() const noexcept;
+
+    void  setRatio( float ratio ) noexcept;
+    float getRatio() const noexcept;
+
+    void  setAttack( float attack ) noexcept;
+    float getAttack() const noexcept;
+
+    void  setRelease( float release ) noexcept;
+    float getRelease() const noexcept;
+
+    void  setKnee( float knee ) noexcept;
+    float getKnee() const noexcept;
+
+    void  setMakeupGain( float makeupGain ) noexcept;
+    float getMakeupGain() const noexcept;
+
+protected:
+    void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) override;
+
+private:
+    // Frames are processed in blocks so the detector and gain stages run as simple (vectorizable) loops.
+    static constexpr ma_uint32 blockSize = 256;
+
+    void processBlock( const float* in, float* out, ma_uint32 frameCount );
+
+    std::atomic<float> threshold;
+    std::atomic<float> ratio;
+    std::atomic<float> attack { 0.01f };
+    std::atomic<float> release { 0.1f };
+    std::atomic<float> knee { 6.0f };
+    std::atomic<float> makeupGain { 0.0f };
+
+    // The smoothed gain reduction (in dB).
+    float envelope = 0.0f;
+
+    // Scratch buffer for the level (and gain) of each frame in a block.
+    float level[blockSize] {};
+};
+}  // namespace Audio
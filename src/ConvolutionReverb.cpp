@@ -0,0 +1,35 @@
+#include <Audio/ConvolutionReverb.hpp>
+#include <Audio/Device.hpp>
+
+#include "ConvolutionReverbImpl.hpp"
+
+using namespace Audio;
+
+ConvolutionReverb::ConvolutionReverb( const std::filesystem::path& impulseResponse )
+{
+    *this = Device::createConvolutionReverb( impulseResponse );
+}
+
+ConvolutionReverb::ConvolutionReverb( std::shared_ptr<EffectImpl> impl )
+: Effect( std::move( impl ) )
+{}
+
+void ConvolutionReverb::setWet( float wet )
+{
+    std::static_pointer_cast<ConvolutionReverbImpl>( get() )->setWet( wet );
+}
+
+float ConvolutionReverb::getWet() const
+{
+    return std::static_pointer_cast<ConvolutionReverbImpl>( get() )->getWet();
+}
+
+void ConvolutionReverb::setDry( float dry )
+{
+    std::static_pointer_cast<ConvolutionReverbImpl>( get() )->setDry( dry );
+}
+
+float ConvolutionReverb::getDry() const
+{
+    return std::static_pointer_cast<ConvolutionReverbImpl>( get() )->getDry();
+}
@@ -0,0 +1,245 @@
+#include "ConvolutionReverbImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+
+using namespace Audio;
+
+/// <summary>
+/// Decode an impulse response file into (deinterleaved) channels at the given sample rate.
+/// </summary>
+static std::vector<std::vector<float>> LoadImpulseResponse( const std::filesystem::path& filePath, ma_uint32 sampleRate )
+{
+    std::vector<std::vector<float>> ir;
+
+    const ma_decoder_config config = ma_decoder_config_init( ma_format_f32, 0, sampleRate );
+    ma_decoder              decoder;
+
+    if ( ma_decoder_init_file_w( filePath.wstring().c_str(), &config, &decoder ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to load impulse response: " << filePath.string() << std::endl;
+        return ir;
+    }
+
+    const ma_uint32 channels = decoder.outputChannels;
+    ir.resize( channels );
+
+    float     buffer[4096];
+    ma_uint64 framesRead = 0;
+    do
+    {
+        ma_decoder_read_pcm_frames( &decoder, buffer, std::size( buffer ) / channels, &framesRead );
+        for ( ma_uint64 i = 0; i < framesRead; ++i )
+        {
+            for ( ma_uint32 c = 0; c < channels; ++c )
+            {
+                ir[c].push_back( buffer[i * channels + c] );
+            }
+        }
+    } while ( framesRead > 0 );
+
+    ma_decoder_uninit( &decoder );
+
+    // Normalize the impulse response to unit energy so that the wet level is comparable to the dry level.
+    double energy = 0.0;
+    for ( const auto& channel: ir )
+    {
+        double e = 0.0;
+        for ( float s: channel )
+            e += static_cast<double>( s ) * s;
+        energy = std::max( energy, e );
+    }
+
+    if ( energy > 0.0 )
+    {
+        const float scale = static_cast<float>( 1.0 / std::sqrt( energy ) );
+        for ( auto& channel: ir )
+        {
+            for ( float& s: channel )
+                s *= scale;
+        }
+    }
+
+    return ir;
+}
+
+ConvolutionReverbImpl::ConvolutionReverbImpl( std::shared_ptr<DeviceImpl> device, const std::filesystem::path& impulseResponse, ma_engine* pEngine )
+: CustomEffectImpl( std::move( device ), pEngine, 1, MA_NODE_FLAG_CONTINUOUS_PROCESSING )
+{
+    if ( !isInitialized() )
+        return;
+
+    const auto ir = LoadImpulseResponse( impulseResponse, sampleRate );
+
+    channelData.resize( channels );
+    for ( ma_uint32 c = 0; c < channels; ++c )
+    {
+        Channel& channel = channelData[c];
+
+        const float* h      = ir.empty() ? nullptr : ir[c % ir.size()].data();
+        const size_t length = ir.empty() ? 0 : ir[c % ir.size()].size();
+
+        channel.head = std::make_unique<Convolver>( headBlockSize, h, std::min( length, headLength ) );
+        channel.input.resize( headBlockSize );
+        channel.output.resize( headBlockSize );
+
+        if ( length > headLength )
+        {
+            hasTail      = true;
+            channel.tail = std::make_unique<Convolver>( tailBlockSize, h + headLength, length - headLength );
+            channel.tailInput.resize( tailBlockSize );
+            channel.tailOutput.resize( tailBlockSize );
+            channel.workerInput.resize( tailBlockSize );
+            channel.workerOutput.resize( tailBlockSize );
+        }
+    }
+
+    if ( hasTail )
+    {
+        ma_event_init( &workerEvent );
+        worker = std::thread( &ConvolutionReverbImpl::processTail, this );
+    }
+}
+
+ConvolutionReverbImpl::~ConvolutionReverbImpl()
+{
+    uninit();
+
+    if ( worker.joinable() )
+    {
+        workerQuit = true;
+        ma_event_signal( &workerEvent );
+        worker.join();
+        ma_event_uninit( &workerEvent );
+    }
+}
+
+void ConvolutionReverbImpl::setWet( float _wet ) noexcept
+{
+    wet.store( _wet, std::memory_order_relaxed );
+}
+
+float ConvolutionReverbImpl::getWet() const noexcept
+{
+    return wet.load( std::memory_order_relaxed );
+}
+
+void ConvolutionReverbImpl::setDry( float _dry ) noexcept
+{
+    dry.store( _dry, std::memory_order_relaxed );
+}
+
+float ConvolutionReverbImpl::getDry() const noexcept
+{
+    return dry.load( std::memory_order_relaxed );
+}
+
+void ConvolutionReverbImpl::process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount )
+{
+    const float* in     = ppFramesIn[0];
+    const float  wetMix = wet.load( std::memory_order_relaxed );
+    const float  dryMix = dry.load( std::memory_order_relaxed );
+
+    ma_uint32 frame = 0;
+    while ( frame < frameCount )
+    {
+        const ma_uint32 count = std::min( frameCount - frame, static_cast<ma_uint32>( headBlockSize - headPos ) );
+
+        for ( ma_uint32 c = 0; c < channels; ++c )
+        {
+            float*       input  = channelData[c].input.data() + headPos;
+            const float* output = channelData[c].output.data() + headPos;
+
+            for ( ma_uint32 i = 0; i < count; ++i )
+            {
+                const ma_uint32 s = ( frame + i ) * channels + c;
+                input[i]          = in[s];
+                pFramesOut[s]     = dryMix * in[s] + wetMix * output[i];
+            }
+        }
+
+        headPos += count;
+        frame += count;
+
+        if ( headPos == headBlockSize )
+        {
+            processBlock();
+            headPos = 0;
+        }
+    }
+}
+
+void ConvolutionReverbImpl::processBlock()
+{
+    for ( auto& channel: channelData )
+    {
+        channel.head->process( channel.input.data(), channel.output.data() );
+
+        if ( hasTail )
+        {
+            const float* tail = channel.tailOutput.data() + tailPos;
+            for ( size_t i = 0; i < headBlockSize; ++i )
+            {
+                channel.output[i] += tail[i];
+            }
+
+            std::copy( channel.input.begin(), channel.input.end(), channel.tailInput.begin() + tailPos );
+        }
+    }
+
+    if ( hasTail )
+    {
+        tailPos += headBlockSize;
+        if ( tailPos == tailBlockSize )
+        {
+            swapTail();
+            tailPos = 0;
+        }
+    }
+}
+
+void ConvolutionReverbImpl::swapTail()
+{
+    if ( workerBusy.load( std::memory_order_acquire ) )
+    {
+        // The worker thread did not finish in time. Drop this tail block rather than blocking the audio thread.
+        for ( auto& channel: channelData )
+        {
+            std::fill( channel.tailOutput.begin(), channel.tailOutput.end(), 0.0f );
+        }
+        return;
+    }
+
+    // Swapping vectors only swaps pointers, so no memory is allocated on the audio thread.
+    for ( auto& channel: channelData )
+    {
+        std::swap( channel.tailOutput, channel.workerOutput );
+        std::swap( channel.tailInput, channel.workerInput );
+    }
+
+    workerBusy.store( true, std::memory_order_release );
+    ma_event_signal( &workerEvent );
+}
+
+void ConvolutionReverbImpl::processTail()
+{
+    while ( true )
+    {
+        ma_event_wait( &workerEvent );
+
+        if ( workerQuit )
+            break;
+
+        if ( !workerBusy.load( std::memory_order_acquire ) )
+            continue;
+
+        for ( auto& channel: channelData )
+        {
+            channel.tail->process( channel.workerInput.data(), channel.workerOutput.data() );
+        }
+
+        workerBusy.store( false, std::memory_order_release );
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Convolver.hpp"
+#include "EffectImpl.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Audio
+{
+class ConvolutionReverbImpl : public CustomEffectImpl
+{
+public:
+    ConvolutionReverbImpl( std::shared_ptr<DeviceImpl> device, const std::filesystem::path& impulseResponse, ma_engine* pEngine );
+    ~ConvolutionReverbImpl() override;
+
+    void  setWet( float wet ) noexcept;
+    float getWet() const noexcept;
+
+    void  setDry( float dry ) noexcept;
+    float getDry() const noexcept;
+
+protected:
+    void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) override;
+
+private:
+    // The block size of the head partitions (processed on the audio thread).
+    static constexpr size_t headBlockSize = 256;
+    // The block size of the tail partitions (processed on the worker thread).
+    static constexpr size_t tailBlockSize = 16 * headBlockSize;
+    // The head covers the first two tail blocks of the impulse response. This gives the worker thread
+    // a full tail block of time to process the tail before the result is needed.
+    static constexpr size_t headLength = 2 * tailBlockSize;
+
+    // Process a full head block on the audio thread.
+    void processBlock();
+    // Hand off a full tail block to the worker thread and pick up the previous result.
+    void swapTail();
+    // The worker thread that processes the tail partitions.
+    void processTail();
+
+    struct Channel
+    {
+        std::unique_ptr<Convolver> head;
+        std::unique_ptr<Convolver> tail;
+
+        std::vector<float> input;   // The current head block input.
+        std::vector<float> output;  // The wet output of the previous head block.
+
+        std::vector<float> tailInput;     // The tail block being collected on the audio thread.
+        std::vector<float> tailOutput;    // The tail result being played on the audio thread.
+        std::vector<float> workerInput;   // The tail block being processed by the worker thread.
+        std::vector<float> workerOutput;  // The tail result being computed by the worker thread.
+    };
+
+    std::vector<Channel> channelData;
+
+    size_t headPos = 0;
+    size_t tailPos = 0;
+    bool   hasTail = false;
+
+    std::atomic<float> wet { 0.5f };
+    std::atomic<float> dry { 1.0f };
+
+    std::thread       worker;
+    ma_event          workerEvent {};
+    std::atomic<bool> workerBusy { false };
+    std::atomic<bool> workerQuit { false };
+};
+}  // namespace Audio
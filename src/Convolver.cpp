@@ -0,0 +1,78 @@
+#include "Convolver.hpp"
+
+#include <algorithm>
+
+using namespace Audio;
+
+Convolver::Convolver( size_t _blockSize, const float* ir, size_t irLength )
+: blockSize { _blockSize }
+, binCount { _blockSize + 1 }
+, partitionCount { ( irLength + _blockSize - 1 ) / _blockSize }
+, fft { _blockSize * 2 }
+{
+    irRe.resize( partitionCount * binCount );
+    irIm.resize( partitionCount * binCount );
+    inputRe.resize( partitionCount * binCount );
+    inputIm.resize( partitionCount * binCount );
+    window.resize( blockSize * 2 );
+    accRe.resize( binCount );
+    accIm.resize( binCount );
+    result.resize( blockSize * 2 );
+
+    // Each partition is zero-padded to twice the block size.
+    std::vector<float> padded( blockSize * 2 );
+    for ( size_t p = 0; p < partitionCount; ++p )
+    {
+        const size_t offset = p * blockSize;
+        const size_t count  = std::min( blockSize, irLength - offset );
+
+        std::fill( padded.begin(), padded.end(), 0.0f );
+        std::copy_n( ir + offset, count, padded.begin() );
+
+        fft.forward( padded.data(), irRe.data() + p * binCount, irIm.data() + p * binCount );
+    }
+}
+
+void Convolver::process( const float* in, float* out )
+{
+    if ( partitionCount == 0 )
+    {
+        std::fill_n( out, blockSize, 0.0f );
+        return;
+    }
+
+    // Slide the input window by one block.
+    std::copy( window.begin() + blockSize, window.end(), window.begin() );
+    std::copy_n( in, blockSize, window.begin() + blockSize );
+
+    fft.forward( window.data(), inputRe.data() + current * binCount, inputIm.data() + current * binCount );
+
+    std::fill( accRe.begin(), accRe.end(), 0.0f );
+    std::fill( accIm.begin(), accIm.end(), 0.0f );
+
+    // The newest input spectrum is multiplied with the first partition, the one before that with the second partition, etc...
+    size_t input = current;
+    for ( size_t p = 0; p < partitionCount; ++p )
+    {
+        FFT::multiplyAccumulate( inputRe.data() + input * binCount, inputIm.data() + input * binCount,
+                                 irRe.data() + p * binCount, irIm.data() + p * binCount,
+                                 accRe.data(), accIm.data(), binCount );
+
+        input = input == 0 ? partitionCount - 1 : input - 1;
+    }
+
+    fft.inverse( accRe.data(), accIm.data(), result.data() );
+
+    // The first half of the result is aliased (overlap-save), the second half is the output.
+    std::copy_n( result.begin() + blockSize, blockSize, out );
+
+    current = ( current + 1 ) % partitionCount;
+}
+
+void Convolver::reset()
+{
+    std::fill( inputRe.begin(), inputRe.end(), 0.0f );
+    std::fill( inputIm.begin(), inputIm.end(), 0.0f );
+    std::fill( window.begin(), window.end(), 0.0f );
+    current = 0;
+}
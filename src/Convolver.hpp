@@ -0,0 +1,66 @@
+#pragma once
+
+#include "FFT.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// Uniformly partitioned overlap-save convolution of a single channel.
+/// </summary>
+/// <remarks>
+/// The impulse response is split into partitions of `blockSize` samples. The spectrum of each
+/// partition is computed once, and every block of input is transformed only once and stored in
+/// a frequency-domain delay line. Processing a block costs one forward and one inverse FFT plus
+/// one complex multiply-accumulate per partition, regardless of the length of the impulse response.
+/// </remarks>
+class Convolver
+{
+public:
+    /// <summary>
+    /// Create a convolver.
+    /// </summary>
+    /// <param name="blockSize">The number of samples per block. Must be a power of 2.</param>
+    /// <param name="ir">The impulse response.</param>
+    /// <param name="irLength">The number of samples in the impulse response.</param>
+    Convolver( size_t blockSize, const float* ir, size_t irLength );
+
+    size_t getBlockSize() const noexcept
+    {
+        return blockSize;
+    }
+
+    /// <summary>
+    /// Convolve exactly `blockSize` samples.
+    /// `in` and `out` may point to the same memory.
+    /// </summary>
+    void process( const float* in, float* out );
+
+    /// <summary>
+    /// Clear the input history.
+    /// </summary>
+    void reset();
+
+private:
+    size_t blockSize;
+    size_t binCount;
+    size_t partitionCount;
+    size_t current = 0;  // The newest spectrum in the frequency-domain delay line.
+
+    FFT fft;
+
+    // Spectra of the impulse response partitions.
+    std::vector<float> irRe;
+    std::vector<float> irIm;
+    // Frequency-domain delay line of the input spectra.
+    std::vector<float> inputRe;
+    std::vector<float> inputIm;
+    // The last two blocks of input (overlap-save).
+    std::vector<float> window;
+    std::vector<float> accRe;
+    std::vector<float> accIm;
+    std::vector<float> result;
+};
+}  // namespace Audio
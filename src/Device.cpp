@@ -1,11 +1,29 @@
 #include <Audio/Device.hpp>
 
+#include "AttenuationCurveImpl.hpp"
+#include "BusImpl.hpp"
+#include "CompressorImpl.hpp"
+#include "ConvolutionReverbImpl.hpp"
+#include "DeviceImpl.hpp"
+#include "DuckerImpl.hpp"
+#include "EmitterGrid.hpp"
+#include "FilterImpl.hpp"
+#include "LimiterImpl.hpp"
 #include "ListenerImpl.hpp"
+#include "OcclusionScheduler.hpp"
+#include "PositionInterpolator.hpp"
+#include "PropagationDelayImpl.hpp"
+#include "PortalImpl.hpp"
+#include "ReverbImpl.hpp"
+#include "ReverbZoneImpl.hpp"
+#include "RoomImpl.hpp"
 #include "SoundImpl.hpp"
+#include "TransformBufferImpl.hpp"
 #include "WaveformImpl.hpp"
 
 #include "miniaudio.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace Audio
@@ -31,60 +49,206 @@ struct MakeWaveform : Waveform
     {}
 };
 
-class DeviceImpl
+struct MakeBus : Bus
 {
-public:
-    DeviceImpl();
-    ~DeviceImpl();
-
-    static std::shared_ptr<DeviceImpl> get()
-    {
-        static auto inst = std::make_shared<DeviceImpl>();
-        return inst;
-    }
-
-    Listener getListener( uint32_t listenerIndex );
+    MakeBus( std::shared_ptr<BusImpl> impl )
+    : Bus( std::move( impl ) )
+    {}
+};
 
-    void setMasterVolume( float volume );
+struct MakeReverbZone : ReverbZone
+{
+    MakeReverbZone( std::shared_ptr<ReverbZoneImpl> impl )
+    : ReverbZone( std::move( impl ) )
+    {}
+};
 
-    Sound loadSound( const std::filesystem::path& filePath );
+struct MakeRoom : Room
+{
+    MakeRoom( std::shared_ptr<RoomImpl> impl )
+    : Room( std::move( impl ) )
+    {}
+};
 
-    Sound loadMusic( const std::filesystem::path& filePath );
+struct MakePortal : Portal
+{
+    MakePortal( std::shared_ptr<PortalImpl> impl )
+    : Portal( std::move( impl ) )
+    {}
+};
 
-    void playSound( const std::filesystem::path& path );
+struct MakeTransformBuffer : TransformBuffer
+{
+    MakeTransformBuffer( std::shared_ptr<TransformBufferImpl> impl )
+    : TransformBuffer( std::move( impl ) )
+    {}
+};
 
-    Waveform createWaveform( Waveform::Type type, float amplitude, float frequency );
+struct MakeAttenuationCurve : AttenuationCurve
+{
+    MakeAttenuationCurve( std::shared_ptr<AttenuationCurveImpl> impl )
+    : AttenuationCurve( std::move( impl ) )
+    {}
+};
 
-private:
-    ma_engine engine {};
+template<typename T>
+struct MakeEffect : T
+{
+    MakeEffect( std::shared_ptr<EffectImpl> impl )
+    : T( std::move( impl ) )
+    {}
 };
 }  // namespace Audio
 
 using namespace Audio;
 
+namespace
+{
+// The settings that are used when the device is created.
+struct Settings
+{
+    Device::SpeakerLayout speakerLayout = Device::SpeakerLayout::Default;
+    bool                  offline       = false;
+    uint32_t              sampleRate    = 48000;
+    bool                  created       = false;
+};
+
+Settings& GetSettings()
+{
+    static Settings settings;
+    return settings;
+}
+
+// The channel count of a speaker layout (or 0 for the channel count of the device).
+ma_uint32 GetChannelCount( Device::SpeakerLayout layout )
+{
+    switch ( layout )
+    {
+    case Device::SpeakerLayout::Mono:
+        return 1;
+    case Device::SpeakerLayout::Stereo:
+        return 2;
+    case Device::SpeakerLayout::Surround51:
+        return 6;
+    case Device::SpeakerLayout::Surround71:
+        return 8;
+    default:
+        return 0;
+    }
+}
+}  // namespace
+
 DeviceImpl::DeviceImpl()
 {
+    auto& settings    = GetSettings();
+    settings.created  = true;
+    const auto layout = GetChannelCount( settings.speakerLayout );
+
     ma_engine_config config = ma_engine_config_init();
     config.listenerCount    = MA_ENGINE_MAX_LISTENERS;
 
+    if ( settings.offline )
+    {
+        // Without a device, the engine is only rendered by `Device::render`.
+        config.noDevice   = MA_TRUE;
+        config.channels   = layout > 0 ? layout : 2;
+        config.sampleRate = settings.sampleRate;
+    }
+    else
+    {
+        // The device is created here (instead of by the engine) so that the parallel buses
+        // can be rendered at the start of every period.
+        ma_device_config deviceConfig          = ma_device_config_init( ma_device_type_playback );
+        deviceConfig.playback.format           = ma_format_f32;
+        deviceConfig.playback.channels         = layout;  // The device converts the standard channel map to its own.
+        deviceConfig.dataCallback              = &DeviceImpl::dataCallback;
+        deviceConfig.pUserData                 = this;
+        deviceConfig.noPreSilencedOutputBuffer = MA_TRUE;  // The engine writes every frame.
+        deviceConfig.noClip                    = MA_TRUE;  // The engine clips the output.
+
+        if ( ma_device_init( nullptr, &deviceConfig, &device ) != MA_SUCCESS )
+        {
+            std::cerr << "Failed to initialize audio device." << std::endl;
+            return;
+        }
+        deviceInitialized = true;
+
+        config.pDevice = &device;
+    }
+
     if ( ma_engine_init( &config, &engine ) != MA_SUCCESS )
     {
         std::cerr << "Failed to initialize audio engine." << std::endl;
         return;
     }
+
+    auto master                                      = std::make_shared<BusImpl>( nullptr, &engine, nullptr, &mixer );
+    buses[static_cast<size_t>( Bus::Type::Master )]  = master;
+    buses[static_cast<size_t>( Bus::Type::Music )]   = std::make_shared<BusImpl>( nullptr, &engine, master );
+    buses[static_cast<size_t>( Bus::Type::Effects )] = std::make_shared<BusImpl>( nullptr, &engine, master );
+    buses[static_cast<size_t>( Bus::Type::Voice )]   = std::make_shared<BusImpl>( nullptr, &engine, master );
+    buses[static_cast<size_t>( Bus::Type::UI )]      = std::make_shared<BusImpl>( nullptr, &engine, master );
 }
 
 DeviceImpl::~DeviceImpl()
 {
+    // Stop the occlusion queries (the callback may use the engine).
+    OcclusionScheduler::get().setCallback( nullptr, 0.0f, 0.0f );
+
 #if !defined( Audio_EXPORTS )
     // There is a bug that causes destruction of the audio engine to hang when building
     // as a DLL. This does not happen when building as a static library.
     // As a workaround, don't call this function when building as a DLL
     // until I can find a better solution.
+    // Stop the device first, so the engine is no longer used by the audio thread.
+    if ( deviceInitialized )
+    {
+        ma_device_uninit( &device );
+    }
+    for ( auto& bus: buses )
+    {
+        bus.reset();
+    }
     ma_engine_uninit( &engine );
 #endif
 }
 
+void DeviceImpl::dataCallback( ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount )
+{
+    (void)pInput;
+
+    static_cast<DeviceImpl*>( pDevice->pUserData )->renderFrames( static_cast<float*>( pOutput ), frameCount );
+}
+
+void DeviceImpl::renderFrames( float* out, ma_uint32 frameCount )
+{
+    const auto channels = ma_engine_get_channels( &engine );
+
+    // The objects that are removed by the game thread stay alive until the end of the render pass.
+    renderEpoch.begin();
+
+    // Move the sounds that are attached to a transform buffer.
+    TransformBufferImpl::applyAll( transformBuffers );
+
+    // Render the parallel buses before the engine reads its node graph (which plays back the rendered buses).
+    while ( frameCount > 0 )
+    {
+        const ma_uint32 count = std::min( frameCount, ParallelMixer::maxFrameCount );
+
+        PositionInterpolator::applyAll( interpolators );
+        // Move the sounds to their apparent positions (after they are moved by the interpolators).
+        PortalImpl::applyAll( portalSources, &engine );
+        AttenuationCurveImpl::applyAll( attenuationCurves, &engine );
+        mixer.render( ma_engine_get_time( &engine ), count );
+        ma_engine_read_pcm_frames( &engine, out, count, nullptr );
+
+        out += static_cast<size_t>( count ) * channels;
+        frameCount -= count;
+    }
+
+    renderEpoch.end();
+}
+
 Listener DeviceImpl::getListener( uint32_t listenerIndex )
 {
     if ( listenerIndex < MA_ENGINE_MAX_LISTENERS )
@@ -102,19 +266,22 @@ void DeviceImpl::setMasterVolume( float volume )
 
 Sound DeviceImpl::loadSound( const std::filesystem::path& filePath )
 {
-    auto sound = std::make_shared<SoundImpl>( get(), filePath, &engine, nullptr, MA_SOUND_FLAG_DECODE );
+    auto sound = std::make_shared<SoundImpl>( get(), filePath, &engine, buses[static_cast<size_t>( Bus::Type::Effects )], MA_SOUND_FLAG_DECODE );
     return MakeSound( std::move( sound ) );
 }
 
 Sound DeviceImpl::loadMusic( const std::filesystem::path& filePath )
 {
-    auto sound = std::make_shared<SoundImpl>( get(), filePath, &engine, nullptr, MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_NO_SPATIALIZATION );
+    auto sound = std::make_shared<SoundImpl>( get(), filePath, &engine, buses[static_cast<size_t>( Bus::Type::Music )], MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_NO_SPATIALIZATION );
     return MakeSound( std::move( sound ) );
 }
 
 void DeviceImpl::playSound( const std::filesystem::path& path )
 {
-    if ( ma_engine_play_sound( &engine, path.string().c_str(), nullptr ) != MA_SUCCESS )
+    const auto&     bus   = buses[static_cast<size_t>( Bus::Type::Effects )];
+    ma_sound_group* group = bus ? static_cast<ma_sound_group*>( bus->getInputNode() ) : nullptr;
+
+    if ( ma_engine_play_sound( &engine, path.string().c_str(), group ) != MA_SUCCESS )
     {
         std::cerr << "Failed to play sound: " << path << std::endl;
     }
@@ -122,10 +289,212 @@ void DeviceImpl::playSound( const std::filesystem::path& path )
 
 Waveform DeviceImpl::createWaveform( Waveform::Type type, float amplitude, float frequency )
 {
-    auto waveform = std::make_shared<WaveformImpl>( get(), type, amplitude, frequency, &engine );
+    auto waveform = std::make_shared<WaveformImpl>( get(), type, amplitude, frequency, &engine, buses[static_cast<size_t>( Bus::Type::Effects )] );
     return MakeWaveform( std::move( waveform ) );
 }
 
+Bus DeviceImpl::getBus( Bus::Type type )
+{
+    return MakeBus( buses[static_cast<size_t>( type )] );
+}
+
+Bus DeviceImpl::createBus( const Bus& parent )
+{
+    auto parentImpl = parent ? parent.get() : buses[static_cast<size_t>( Bus::Type::Master )];
+    if ( !parentImpl )
+        return MakeBus( nullptr );
+
+    return MakeBus( std::make_shared<BusImpl>( get(), &engine, std::move( parentImpl ) ) );
+}
+
+TransformBuffer DeviceImpl::createTransformBuffer( uint32_t slotCount )
+{
+    return MakeTransformBuffer( std::make_shared<TransformBufferImpl>( get(), slotCount ) );
+}
+
+AttenuationCurve DeviceImpl::createAttenuationCurve( const AttenuationCurve::Point* points, size_t count, AttenuationCurve::Interpolation interpolation )
+{
+    return MakeAttenuationCurve( std::make_shared<AttenuationCurveImpl>( get(), points, count, interpolation ) );
+}
+
+AttenuationCurve DeviceImpl::loadAttenuationCurve( const std::filesystem::path& filePath, AttenuationCurve::Interpolation interpolation )
+{
+    return MakeAttenuationCurve( AttenuationCurveImpl::load( get(), filePath, interpolation ) );
+}
+
+Filter DeviceImpl::createFilter( Filter::Type type, float frequency, float q, float gainDB )
+{
+    auto filter = std::make_shared<FilterImpl>( get(), type, frequency, q, gainDB, &engine );
+    return MakeEffect<Filter>( std::move( filter ) );
+}
+
+ConvolutionReverb DeviceImpl::createConvolutionReverb( const std::filesystem::path& impulseResponse )
+{
+    auto reverb = std::make_shared<ConvolutionReverbImpl>( get(), impulseResponse, &engine );
+    return MakeEffect<ConvolutionReverb>( std::move( reverb ) );
+}
+
+Reverb DeviceImpl::createReverb( float roomSize, float decayTime )
+{
+    auto reverb = std::make_shared<ReverbImpl>( get(), roomSize, decayTime, &engine );
+    return MakeEffect<Reverb>( std::move( reverb ) );
+}
+
+ReverbZone DeviceImpl::createReverbZone( const Bus& reverbBus, const Reverb& reverb )
+{
+    if ( !reverbBus )
+    {
+        std::cerr << "Failed to create reverb zone: the reverb bus is empty." << std::endl;
+        return MakeReverbZone( nullptr );
+    }
+
+    return MakeReverbZone( std::make_shared<ReverbZoneImpl>( reverbBus.get(), std::static_pointer_cast<ReverbImpl>( reverb.get() ) ) );
+}
+
+Room DeviceImpl::createRoom( const Vector& center, const Vector& halfExtents )
+{
+    return MakeRoom( std::make_shared<RoomImpl>( ma_vec3f { center.x, center.y, center.z }, ma_vec3f { halfExtents.x, halfExtents.y, halfExtents.z } ) );
+}
+
+Portal DeviceImpl::createPortal( const Room& roomA, const Room& roomB, const Vector& center, const Vector& halfExtents )
+{
+    return MakePortal( std::make_shared<PortalImpl>( roomA.get(), roomB.get(), ma_vec3f { center.x, center.y, center.z }, ma_vec3f { halfExtents.x, halfExtents.y, halfExtents.z } ) );
+}
+
+Compressor DeviceImpl::createCompressor( float threshold, float ratio )
+{
+    auto compressor = std::make_shared<CompressorImpl>( get(), threshold, ratio, &engine );
+    return MakeEffect<Compressor>( std::move( compressor ) );
+}
+
+Limiter DeviceImpl::createLimiter( float threshold, float lookahead )
+{
+    auto limiter = std::make_shared<LimiterImpl>( get(), threshold, lookahead, &engine );
+    return MakeEffect<Limiter>( std::move( limiter ) );
+}
+
+Ducker DeviceImpl::createDucker( const Bus& sidechain, float reduction )
+{
+    auto ducker = std::make_shared<DuckerImpl>( get(), reduction, &engine );
+    ducker->setSidechain( sidechain.get() );
+    return MakeEffect<Ducker>( std::move( ducker ) );
+}
+
+std::vector<Sound> DeviceImpl::getAudibleSounds( uint32_t listenerIndex, float radius, size_t maxCount )
+{
+    std::vector<Sound> sounds;
+
+    if ( listenerIndex >= MA_ENGINE_MAX_LISTENERS )
+        return sounds;
+
+    for ( auto& sound: EmitterGrid::get().query( &engine, listenerIndex, radius, maxCount ) )
+        sounds.push_back( MakeSound( std::move( sound ) ) );
+
+    return sounds;
+}
+
+bool DeviceImpl::loadHrtf( const std::filesystem::path& directory )
+{
+    auto hrtf = Hrtf::load( directory, ma_engine_get_sample_rate( &engine ) );
+    if ( !hrtf )
+        return false;
+
+    Hrtf::setCurrent( hrtf.get() );
+    hrtfs.push_back( std::move( hrtf ) );
+    return true;
+}
+
+void DeviceImpl::setHrtfVoiceLimit( uint32_t voiceLimit )
+{
+    hrtfVoiceLimit = voiceLimit;
+}
+
+uint32_t DeviceImpl::getChannelCount()
+{
+    return ma_engine_get_channels( &engine );
+}
+
+uint64_t DeviceImpl::render( float* frames, uint64_t frameCount )
+{
+    if ( !GetSettings().offline )
+    {
+        std::cerr << "Offline rendering is not enabled." << std::endl;
+        return 0;
+    }
+
+    const auto channels = ma_engine_get_channels( &engine );
+
+    for ( uint64_t frame = 0; frame < frameCount; )
+    {
+        const auto count = static_cast<ma_uint32>( std::min<uint64_t>( frameCount - frame, 0xFFFFFFFFu ) );
+        renderFrames( frames + frame * channels, count );
+        frame += count;
+    }
+
+    return frameCount;
+}
+
+void DeviceImpl::update()
+{
+    // The clusters (and the HRTF voices) depend on the positions of the sounds.
+    TransformBufferImpl::updateEmitters( transformBuffers );
+
+    // Update the clusters first: sounds in a cluster are not rendered with the HRTF.
+    BusImpl::updateClusters();
+    SoundImpl::updateHrtf( Hrtf::getCurrent(), hrtfVoiceLimit );
+
+    // The reverb zones depend on the positions of the listeners.
+    ReverbZoneImpl::updateAll( &engine );
+
+    // Find the paths from the listeners to the sounds through the portals (on a worker thread).
+    PortalImpl::updateAll( portalSources, &engine );
+
+    // Apply the results of the occlusion queries, and start the next queries (on a worker thread).
+    OcclusionScheduler::get().update();
+}
+
+bool Device::setSpeakerLayout( SpeakerLayout layout )
+{
+    auto& settings = GetSettings();
+    if ( settings.created )
+    {
+        std::cerr << "The speaker layout must be set before the device is used." << std::endl;
+        return false;
+    }
+
+    settings.speakerLayout = layout;
+    return true;
+}
+
+Device::SpeakerLayout Device::getSpeakerLayout()
+{
+    return GetSettings().speakerLayout;
+}
+
+uint32_t Device::getChannelCount()
+{
+    return DeviceImpl::get()->getChannelCount();
+}
+
+bool Device::setOfflineRendering( bool enabled, uint32_t sampleRate )
+{
+    auto& settings = GetSettings();
+    if ( settings.created )
+    {
+        std::cerr << "Offline rendering must be set before the device is used." << std::endl;
+        return false;
+    }
+
+    settings.offline    = enabled;
+    settings.sampleRate = sampleRate > 0 ? sampleRate : 48000;
+    return true;
+}
+
+uint64_t Device::render( float* frames, uint64_t frameCount )
+{
+    return DeviceImpl::get()->render( frames, frameCount );
+}
+
 void Device::setMasterVolume( float volume )
 {
     DeviceImpl::get()->setMasterVolume( volume );
@@ -155,3 +524,125 @@ Waveform Device::createWaveform( Waveform::Type type, float amplitude, float fre
 {
     return DeviceImpl::get()->createWaveform( type, amplitude, frequency );
 }
+
+Bus Device::getBus( Bus::Type type )
+{
+    return DeviceImpl::get()->getBus( type );
+}
+
+Bus Device::createBus( const Bus& parent )
+{
+    return DeviceImpl::get()->createBus( parent );
+}
+
+TransformBuffer Device::createTransformBuffer( uint32_t slotCount )
+{
+    return DeviceImpl::get()->createTransformBuffer( slotCount );
+}
+
+AttenuationCurve Device::createAttenuationCurve( const AttenuationCurve::Point* points, size_t count, AttenuationCurve::Interpolation interpolation )
+{
+    return DeviceImpl::get()->createAttenuationCurve( points, count, interpolation );
+}
+
+AttenuationCurve Device::loadAttenuationCurve( const std::filesystem::path& filePath, AttenuationCurve::Interpolation interpolation )
+{
+    return DeviceImpl::get()->loadAttenuationCurve( filePath, interpolation );
+}
+
+Filter Device::createFilter( Filter::Type type, float frequency, float q, float gainDB )
+{
+    return DeviceImpl::get()->createFilter( type, frequency, q, gainDB );
+}
+
+ConvolutionReverb Device::createConvolutionReverb( const std::filesystem::path& impulseResponse )
+{
+    return DeviceImpl::get()->createConvolutionReverb( impulseResponse );
+}
+
+Reverb Device::createReverb( float roomSize, float decayTime )
+{
+    return DeviceImpl::get()->createReverb( roomSize, decayTime );
+}
+
+ReverbZone Device::createReverbZone( const Bus& reverbBus, const Reverb& reverb )
+{
+    return DeviceImpl::get()->createReverbZone( reverbBus, reverb );
+}
+
+Room Device::createRoom( const Vector& center, const Vector& halfExtents )
+{
+    return DeviceImpl::get()->createRoom( center, halfExtents );
+}
+
+Portal Device::createPortal( const Room& roomA, const Room& roomB, const Vector& center, const Vector& halfExtents )
+{
+    return DeviceImpl::get()->createPortal( roomA, roomB, center, halfExtents );
+}
+
+Compressor Device::createCompressor( float threshold, float ratio )
+{
+    return DeviceImpl::get()->createCompressor( threshold, ratio );
+}
+
+Limiter Device::createLimiter( float threshold, float lookahead )
+{
+    return DeviceImpl::get()->createLimiter( threshold, lookahead );
+}
+
+Ducker Device::createDucker( const Bus& sidechain, float reduction )
+{
+    return DeviceImpl::get()->createDucker( sidechain, reduction );
+}
+
+void Device::setOcclusion( const Sound* sounds, const float* occlusion, const float* obstruction, size_t count )
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        // Access the implementation directly (Sound::get returns a copy of the shared pointer).
+        if ( SoundImpl* sound = sounds[i].impl.get() )
+        {
+            sound->setOcclusion( occlusion[i], obstruction ? obstruction[i] : 0.0f );
+        }
+    }
+}
+
+void Device::setOcclusionCallback( OcclusionCallback callback, float maxRate, float minRate )
+{
+    OcclusionScheduler::get().setCallback( std::move( callback ), maxRate, minRate );
+}
+
+void Device::update()
+{
+    DeviceImpl::get()->update();
+}
+
+std::vector<Sound> Device::getAudibleSounds( uint32_t listenerIndex, float radius, size_t maxCount )
+{
+    return DeviceImpl::get()->getAudibleSounds( listenerIndex, radius, maxCount );
+}
+
+void Device::setEmitterGridCellSize( float cellSize )
+{
+    EmitterGrid::get().setCellSize( cellSize );
+}
+
+bool Device::loadHrtf( const std::filesystem::path& directory )
+{
+    return DeviceImpl::get()->loadHrtf( directory );
+}
+
+void Device::setHrtfVoiceLimit( uint32_t voiceLimit )
+{
+    DeviceImpl::get()->setHrtfVoiceLimit( voiceLimit );
+}
+
+void Device::setSpeedOfSound( float speedOfSound )
+{
+    PropagationDelayImpl::setSpeedOfSound( speedOfSound );
+}
+
+float Device::getSpeedOfSound()
+{
+    return PropagationDelayImpl::getSpeedOfSound();
+}
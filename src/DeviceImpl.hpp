@@ -0,0 +1,142 @@
+#pragma once
+
+#include <Audio/Device.hpp>
+
+#include "Hrtf.hpp"
+#include "ParallelMixer.hpp"
+#include "Realtime.hpp"
+
+#include "miniaudio.h"
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Audio
+{
+class AttenuationCurveImpl;
+class BusImpl;
+class PortalSource;
+class PositionInterpolator;
+class TransformBufferImpl;
+
+class DeviceImpl
+{
+public:
+    DeviceImpl();
+    ~DeviceImpl();
+
+    static std::shared_ptr<DeviceImpl> get()
+    {
+        static auto inst = std::make_shared<DeviceImpl>();
+        return inst;
+    }
+
+    Listener getListener( uint32_t listenerIndex );
+
+    void setMasterVolume( float volume );
+
+    Sound loadSound( const std::filesystem::path& filePath );
+
+    Sound loadMusic( const std::filesystem::path& filePath );
+
+    void playSound( const std::filesystem::path& path );
+
+    Waveform createWaveform( Waveform::Type type, float amplitude, float frequency );
+
+    Bus getBus( Bus::Type type );
+
+    Bus createBus( const Bus& parent );
+
+    TransformBuffer createTransformBuffer( uint32_t slotCount );
+
+    AttenuationCurve createAttenuationCurve( const AttenuationCurve::Point* points, size_t count, AttenuationCurve::Interpolation interpolation );
+
+    AttenuationCurve loadAttenuationCurve( const std::filesystem::path& filePath, AttenuationCurve::Interpolation interpolation );
+
+    Filter createFilter( Filter::Type type, float frequency, float q, float gainDB );
+
+    ConvolutionReverb createConvolutionReverb( const std::filesystem::path& impulseResponse );
+
+    Reverb createReverb( float roomSize, float decayTime );
+
+    ReverbZone createReverbZone( const Bus& reverbBus, const Reverb& reverb );
+
+    Room createRoom( const Vector& center, const Vector& halfExtents );
+
+    Portal createPortal( const Room& roomA, const Room& roomB, const Vector& center, const Vector& halfExtents );
+
+    Compressor createCompressor( float threshold, float ratio );
+
+    Limiter createLimiter( float threshold, float lookahead );
+
+    Ducker createDucker( const Bus& sidechain, float reduction );
+
+    std::vector<Sound> getAudibleSounds( uint32_t listenerIndex, float radius, size_t maxCount );
+
+    bool loadHrtf( const std::filesystem::path& directory );
+
+    void setHrtfVoiceLimit( uint32_t voiceLimit );
+
+    uint32_t getChannelCount();
+
+    uint64_t render( float* frames, uint64_t frameCount );
+
+    void update();
+
+    RenderEpoch& getRenderEpoch() noexcept
+    {
+        return renderEpoch;
+    }
+
+    RealtimeList<TransformBufferImpl*>& getTransformBuffers() noexcept
+    {
+        return transformBuffers;
+    }
+
+    RealtimeList<PositionInterpolator*>& getInterpolators() noexcept
+    {
+        return interpolators;
+    }
+
+    RealtimeList<AttenuationCurveImpl*>& getAttenuationCurves() noexcept
+    {
+        return attenuationCurves;
+    }
+
+    RealtimeList<PortalSource*>& getPortalSources() noexcept
+    {
+        return portalSources;
+    }
+
+private:
+    // The device calls back into the engine (after rendering the parallel buses).
+    static void dataCallback( ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount );
+
+    // Render the parallel buses and the engine (on the audio thread, or by `render` when rendering offline).
+    void renderFrames( float* out, ma_uint32 frameCount );
+
+    // The render passes of the audio thread (used by the lists that are read by the audio thread).
+    RenderEpoch renderEpoch;
+
+    ParallelMixer mixer { renderEpoch };
+    ma_device     device {};
+    bool          deviceInitialized = false;
+    ma_engine     engine {};
+
+    // The built-in buses (indexed by Bus::Type).
+    // The built-in buses don't hold a reference to the device, otherwise the device would never be destroyed.
+    std::array<std::shared_ptr<BusImpl>, 5> buses;
+
+    // All loaded HRTFs (the last one is current). Replaced HRTFs are kept, because they may still be used by the audio thread.
+    std::vector<std::unique_ptr<Hrtf>> hrtfs;
+    uint32_t                           hrtfVoiceLimit = 16;
+
+    // The objects that are applied by the audio thread (destroyed after the device is stopped).
+    RealtimeList<TransformBufferImpl*>  transformBuffers { renderEpoch };
+    RealtimeList<PositionInterpolator*> interpolators { renderEpoch };
+    RealtimeList<AttenuationCurveImpl*> attenuationCurves { renderEpoch };
+    RealtimeList<PortalSource*>         portalSources { renderEpoch };
+};
+}  // namespace Audio
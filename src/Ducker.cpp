@@ -0,0 +1,73 @@
+#include <Audio/Device.hpp>
+#include <Audio/Ducker.hpp>
+
+#include "BusImpl.hpp"
+#include "DuckerImpl.hpp"
+
+using namespace Audio;
+
+struct MakeBus : Bus
+{
+    MakeBus( std::shared_ptr<BusImpl> impl )
+    : Bus( std::move( impl ) )
+    {}
+};
+
+Ducker::Ducker( const Bus& sidechain, float reduction )
+{
+    *this = Device::createDucker( sidechain, reduction );
+}
+
+Ducker::Ducker( std::shared_ptr<EffectImpl> impl )
+: Effect( std::move( impl ) )
+{}
+
+void Ducker::setSidechain( const Bus& sidechain )
+{
+    std::static_pointer_cast<DuckerImpl>( get() )->setSidechain( sidechain.get() );
+}
+
+Bus Ducker::getSidechain() const
+{
+    return MakeBus( std::static_pointer_cast<DuckerImpl>( get() )->getSidechain() );
+}
+
+void Ducker::setThreshold( float threshold )
+{
+    std::static_pointer_cast<DuckerImpl>( get() )->setThreshold( threshold );
+}
+
+float Ducker::getThreshold() const
+{
+    return std::static_pointer_cast<DuckerImpl>( get() )->getThreshold();
+}
+
+void Ducker::setReduction( float reduction )
+{
+    std::static_pointer_cast<DuckerImpl>( get() )->setReduction( reduction );
+}
+
+float Ducker::getReduction() const
+{
+    return std::static_pointer_cast<DuckerImpl>( get() )->getReduction();
+}
+
+void Ducker::setAttack( float attack )
+{
+    std::static_pointer_cast<DuckerImpl>( get() )->setAttack( attack );
+}
+
+float Ducker::getAttack() const
+{
+    return std::static_pointer_cast<DuckerImpl>( get() )->getAttack();
+}
+
+void Ducker::setRelease( float release )
+{
+    std::static_pointer_cast<DuckerImpl>( get() )->setRelease( release );
+}
+
+float Ducker::getRelease() const
+{
+    return std::static_pointer_cast<DuckerImpl>( get() )->getRelease();
+}
@@ -0,0 +1,135 @@
+#include "DuckerImpl.hpp"
+#include "BusImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+// The release time (in seconds) of the sidechain level detector.
+// Long enough to smooth out the waveform, short enough to follow the envelope of speech.
+static constexpr float DetectorRelease = 0.05f;
+
+DuckerImpl::DuckerImpl( std::shared_ptr<DeviceImpl> device, float _reduction, ma_engine* pEngine )
+: CustomEffectImpl( std::move( device ), pEngine, 2 )
+, reduction { std::min( _reduction, 0.0f ) }
+{}
+
+DuckerImpl::~DuckerImpl()
+{
+    uninit();
+}
+
+void DuckerImpl::setSidechain( std::shared_ptr<BusImpl> _sidechain )
+{
+    if ( auto current = sidechain.lock() )
+    {
+        current->removeSidechain( this );
+    }
+    sidechain.reset();
+
+    if ( _sidechain && _sidechain->addSidechain( shared_from_this() ) )
+    {
+        sidechain = _sidechain;
+    }
+}
+
+std::shared_ptr<BusImpl> DuckerImpl::getSidechain() const
+{
+    return sidechain.lock();
+}
+
+void DuckerImpl::setThreshold( float _threshold ) noexcept
+{
+    threshold.store( _threshold, std::memory_order_relaxed );
+}
+
+float DuckerImpl::getThreshold() const noexcept
+{
+    return threshold.load( std::memory_order_relaxed );
+}
+
+void DuckerImpl::setReduction( float _reduction ) noexcept
+{
+    reduction.store( std::min( _reduction, 0.0f ), std::memory_order_relaxed );
+}
+
+float DuckerImpl::getReduction() const noexcept
+{
+    return reduction.load( std::memory_order_relaxed );
+}
+
+void DuckerImpl::setAttack( float _attack ) noexcept
+{
+    attack.store( std::max( _attack, 0.0f ), std::memory_order_relaxed );
+}
+
+float DuckerImpl::getAttack() const noexcept
+{
+    return attack.load( std::memory_order_relaxed );
+}
+
+void DuckerImpl::setRelease( float _release ) noexcept
+{
+    release.store( std::max( _release, 0.0f ), std::memory_order_relaxed );
+}
+
+float DuckerImpl::getRelease() const noexcept
+{
+    return release.load( std::memory_order_relaxed );
+}
+
+void DuckerImpl::process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount )
+{
+    for ( ma_uint32 f = 0; f < frameCount; f += blockSize )
+    {
+        const ma_uint32 count = std::min( blockSize, frameCount - f );
+        processBlock( ppFramesIn[0] + f * channels, ppFramesIn[1] + f * channels, pFramesOut + f * channels, count );
+    }
+}
+
+void DuckerImpl::processBlock( const float* in, const float* sidechainIn, float* out, ma_uint32 frameCount )
+{
+    const float rate          = static_cast<float>( sampleRate );
+    const float thresholdGain = std::pow( 10.0f, threshold.load( std::memory_order_relaxed ) * 0.05f );
+    const float target        = reduction.load( std::memory_order_relaxed );
+    const float attackTime    = attack.load( std::memory_order_relaxed );
+    const float releaseTime   = release.load( std::memory_order_relaxed );
+    const float attackCoeff   = attackTime > 0.0f ? std::exp( -1.0f / ( attackTime * rate ) ) : 0.0f;
+    const float releaseCoeff  = releaseTime > 0.0f ? std::exp( -1.0f / ( releaseTime * rate ) ) : 0.0f;
+    const float detectorCoeff = std::exp( -1.0f / ( DetectorRelease * rate ) );
+
+    // Detector: the peak level of the sidechain for each frame (linked across channels).
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        float peak = 0.0f;
+        for ( ma_uint32 c = 0; c < channels; ++c )
+            peak = std::max( peak, std::abs( sidechainIn[f * channels + c] ) );
+
+        blockGain[f] = peak;
+    }
+
+    // Envelope: duck while the sidechain level is above the threshold.
+    float l = level;
+    float g = gain;
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        l = std::max( blockGain[f], l * detectorCoeff );
+
+        const float goal  = l > thresholdGain ? target : 0.0f;
+        const float coeff = goal < g ? attackCoeff : releaseCoeff;
+        g                 = goal + coeff * ( g - goal );
+
+        blockGain[f] = g;
+    }
+    level = l;
+    gain  = g;
+
+    // Apply the gain.
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        const float linear = std::pow( 10.0f, blockGain[f] * 0.05f );
+        for ( ma_uint32 c = 0; c < channels; ++c )
+            out[f * channels + c] = in[f * channels + c] * linear;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "EffectImpl.hpp"
+
+#include <atomic>
+
+namespace Audio
+{
+class DuckerImpl : public CustomEffectImpl, public std::enable_shared_from_this<DuckerImpl>
+{
+public:
+    DuckerImpl( std::shared_ptr<DeviceImpl> device, float reduction, ma_engine* pEngine );
+    ~DuckerImpl() override;
+
+    void                     setSidechain( std::shared_ptr<BusImpl> sidechain );
+    std::shared_ptr<BusImpl> getSidechain() const override;
+
+    void  setThreshold( float threshold ) noexcept;
+    float getThreshold() const noexcept;
+
+    void  setReduction( float reduction ) noexcept;
+    float getReduction() const noexcept;
+
+    void  setAttack( float attack ) noexcept;
+    float getAttack() const noexcept;
+
+    void  setRelease( float release ) noexcept;
+    float getRelease() const noexcept;
+
+protected:
+    void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) override;
+
+private:
+    // Frames are processed in blocks so the detector and gain stages run as simple (vectorizable) loops.
+    static constexpr ma_uint32 blockSize = 256;
+
+    void processBlock( const float* in, const float* sidechainIn, float* out, ma_uint32 frameCount );
+
+    // The sidechain bus owns the connection to this effect, so only a weak reference is kept here.
+    std::weak_ptr<BusImpl> sidechain;
+
+    std::atomic<float> threshold { -40.0f };
+    std::atomic<float> reduction;
+    std::atomic<float> attack { 0.05f };
+    std::atomic<float> release { 0.5f };
+
+    // The (peak) level of the sidechain.
+    float level = 0.0f;
+    // The smoothed gain (in dB).
+    float gain = 0.0f;
+
+    // Scratch buffer for the gain of each frame in a block.
+    float blockGain[blockSize] {};
+};
+}  // namespace Audio
@@ -0,0 +1,421 @@
+#include "EarlyReflections.hpp"
+#include "PropagationDelayImpl.hpp"
+#include "RoomImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace Audio;
+
+static constexpr float Pi = 3.14159265358979323846f;
+
+// The image sources are recomputed when the sound or the listener moves by more than 1 cm, or the listener turns by more than 1 degree.
+static constexpr float MinMovement          = 0.01f;
+static const float     MinOrientationChange = std::cos( Pi / 180.0f );
+
+// The distance below which the reflections are not louder than at this distance (like the default minimum distance of a sound).
+static constexpr float MinDistance = 1.0f;
+
+namespace
+{
+ma_vec3f Normalize( const ma_vec3f& v, const ma_vec3f& fallback )
+{
+    const float length = std::sqrt( v.x * v.x + v.y * v.y + v.z * v.z );
+    if ( length < 1e-6f )
+        return fallback;
+
+    return { v.x / length, v.y / length, v.z / length };
+}
+
+ma_vec3f Cross( const ma_vec3f& a, const ma_vec3f& b )
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+float Dot( const ma_vec3f& a, const ma_vec3f& b )
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+float Distance( const ma_vec3f& a, const ma_vec3f& b )
+{
+    const ma_vec3f d = { a.x - b.x, a.y - b.y, a.z - b.z };
+    return std::sqrt( Dot( d, d ) );
+}
+
+float& At( ma_vec3f& v, int axis )
+{
+    return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+}
+
+bool Contains( const ma_vec3f& min, const ma_vec3f& max, const ma_vec3f& p )
+{
+    return p.x >= min.x && p.y >= min.y && p.z >= min.z && p.x <= max.x && p.y <= max.y && p.z <= max.z;
+}
+
+// Add a (mono) block to the delay line at `start`, with the gains ramped from `from` to `to` over the block.
+template<ma_uint32 Channels>
+void Scatter( float* line, size_t mask, size_t start, const float* mono, ma_uint32 frameCount, const float* from, const float* to )
+{
+    bool audible = false;
+    for ( ma_uint32 c = 0; c < Channels; ++c )
+        audible |= from[c] != 0.0f || to[c] != 0.0f;
+
+    if ( !audible || frameCount == 0 )
+        return;
+
+    float delta[Channels];
+    for ( ma_uint32 c = 0; c < Channels; ++c )
+        delta[c] = ( to[c] - from[c] ) / static_cast<float>( frameCount );
+
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        float* frame = line + ( ( start + f ) & mask ) * Channels;
+
+        for ( ma_uint32 c = 0; c < Channels; ++c )
+            frame[c] += ( from[c] + static_cast<float>( f + 1 ) * delta[c] ) * mono[f];
+    }
+}
+}  // namespace
+
+EarlyReflections::EarlyReflections( ma_engine* pEngine, std::shared_ptr<RoomImpl> _room )
+: engine { pEngine }
+, room { std::move( _room ) }
+, outputChannels { ma_engine_get_channels( pEngine ) }
+, lineChannels { outputChannels >= 2 ? 2u : 1u }
+{
+    // The image sources are attached to the (mono) input, but add their output to the delay line directly.
+    // The delay line is processed continuously, so the reflections are flushed when the sounds stop.
+    vtable.onProcess      = &EarlyReflections::onProcess;
+    vtable.inputBusCount  = 1;
+    vtable.outputBusCount = 1;
+    vtable.flags          = MA_NODE_FLAG_CONTINUOUS_PROCESSING | MA_NODE_FLAG_ALLOW_NULL_INPUT;
+
+    const ma_uint32 inputChannels = 1;
+
+    ma_node_config config  = ma_node_config_init();
+    config.vtable          = &vtable;
+    config.pInputChannels  = &inputChannels;
+    config.pOutputChannels = &outputChannels;
+
+    node.reflections = this;
+
+    if ( ma_node_init( ma_engine_get_node_graph( pEngine ), &config, nullptr, &node.base ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize early reflections node." << std::endl;
+        return;
+    }
+
+    // The node never reads (or processes) more frames at a time than fit in its cache. The delay line holds
+    // the longest delay past the end of the round (and the image sources write at most one round ahead).
+    capacity = node.base.cachedDataCapInFramesPerBus;
+    maxDelay = static_cast<ma_uint32>( MaxDelay * static_cast<float>( ma_engine_get_sample_rate( pEngine ) ) );
+
+    size_t lineFrames = 1;
+    while ( lineFrames < static_cast<size_t>( maxDelay ) + 2 * capacity )
+        lineFrames *= 2;
+
+    line.resize( lineFrames * lineChannels );
+    mask = lineFrames - 1;
+
+    initialized = true;
+}
+
+EarlyReflections::~EarlyReflections()
+{
+    if ( initialized )
+    {
+        ma_node_uninit( &node.base, nullptr );
+    }
+}
+
+void EarlyReflections::onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut )
+{
+    (void)ppFramesIn;
+
+    auto* reflections = static_cast<Node*>( pNode )->reflections;
+
+    // Input and output are processed at the same rate.
+    const ma_uint32 frameCount = std::min( { *pFrameCountIn, *pFrameCountOut, reflections->capacity - reflections->consumed } );
+
+    const size_t    start          = reflections->roundStart + reflections->consumed;
+    const ma_uint32 lineChannels   = reflections->lineChannels;
+    const ma_uint32 outputChannels = reflections->outputChannels;
+    float*          out            = ppFramesOut[0];
+
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        float* frame = reflections->line.data() + ( ( start + f ) & reflections->mask ) * lineChannels;
+
+        for ( ma_uint32 c = 0; c < outputChannels; ++c )
+            out[f * outputChannels + c] = c < lineChannels ? frame[c] : 0.0f;
+
+        std::fill_n( frame, lineChannels, 0.0f );
+    }
+
+    // The input is read again (and the image sources are processed again) once all of it is consumed.
+    if ( frameCount == *pFrameCountIn )
+    {
+        reflections->roundStart += reflections->consumed + frameCount;
+        reflections->consumed = 0;
+        reflections->round++;
+    }
+    else
+    {
+        reflections->consumed += frameCount;
+    }
+
+    *pFrameCountIn  = frameCount;
+    *pFrameCountOut = frameCount;
+}
+
+ImageSources::ImageSources( EarlyReflections* _reflections, ma_sound* pSound )
+: reflections { _reflections }
+, sound { pSound }
+, inputChannels { ma_engine_get_channels( _reflections->getEngine() ) }
+{
+    // Output bus 0 passes the sound through, output bus 1 is silent.
+    vtable.onProcess      = &ImageSources::onProcess;
+    vtable.inputBusCount  = 1;
+    vtable.outputBusCount = 2;
+
+    const ma_uint32 outputChannels[2] = { inputChannels, 1 };
+
+    ma_node_config config  = ma_node_config_init();
+    config.vtable          = &vtable;
+    config.pInputChannels  = &inputChannels;
+    config.pOutputChannels = outputChannels;
+
+    node.sources = this;
+
+    if ( ma_node_init( ma_engine_get_node_graph( reflections->getEngine() ), &config, nullptr, &node.base ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize image sources node." << std::endl;
+        return;
+    }
+
+    mono.resize( node.base.cachedDataCapInFramesPerBus );
+
+    ma_node_attach_output_bus( &node.base, 1, reflections->getNode(), 0 );
+
+    initialized = true;
+}
+
+ImageSources::~ImageSources()
+{
+    if ( initialized )
+    {
+        ma_node_uninit( &node.base, nullptr );
+    }
+}
+
+void ImageSources::onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut )
+{
+    auto* sources = static_cast<Node*>( pNode )->sources;
+
+    // Input and output are processed at the same rate.
+    const ma_uint32 frameCount = std::min( *pFrameCountIn, *pFrameCountOut );
+
+    std::copy_n( ppFramesIn[0], static_cast<size_t>( frameCount ) * sources->inputChannels, ppFramesOut[0] );
+    std::fill_n( ppFramesOut[1], frameCount, 0.0f );
+
+    sources->process( ppFramesIn[0], frameCount );
+
+    *pFrameCountIn  = frameCount;
+    *pFrameCountOut = frameCount;
+}
+
+void ImageSources::updateTaps()
+{
+    ma_engine*      engine        = reflections->getEngine();
+    const ma_uint32 listenerIndex = ma_sound_get_listener_index( sound );
+
+    const ma_vec3f listener = ma_engine_listener_get_position( engine, listenerIndex );
+    const ma_vec3f forward  = Normalize( ma_engine_listener_get_direction( engine, listenerIndex ), { 0.0f, 0.0f, -1.0f } );
+    const ma_vec3f right    = Normalize( Cross( forward, ma_engine_listener_get_world_up( engine, listenerIndex ) ), { 1.0f, 0.0f, 0.0f } );
+
+    ma_vec3f position = ma_sound_get_position( sound );
+    if ( ma_sound_get_positioning( sound ) == ma_positioning_relative )
+    {
+        // The room is in world space.
+        const ma_vec3f up = Cross( right, forward );
+        const ma_vec3f p  = position;
+
+        position = { listener.x + p.x * right.x + p.y * up.x - p.z * forward.x,
+                     listener.y + p.x * right.y + p.y * up.y - p.z * forward.y,
+                     listener.z + p.x * right.z + p.y * up.z - p.z * forward.z };
+    }
+
+    const RoomImpl& room    = *reflections->getRoom();
+    const uint32_t  version = room.getVersion();
+
+    if ( hasTaps && version == roomVersion && Distance( position, soundPosition ) < MinMovement && Distance( listener, listenerPosition ) < MinMovement &&
+         Dot( right, listenerRight ) >= MinOrientationChange )
+        return;
+
+    soundPosition    = position;
+    listenerPosition = listener;
+    listenerRight    = right;
+    roomVersion      = version;
+
+    // Silent reflections keep their delay, so they are not crossfaded.
+    for ( size_t t = 0; t < MaxTaps; ++t )
+        targets[t] = { taps[t].delay, { 0.0f, 0.0f } };
+
+    ma_vec3f min, max;
+    room.getBox( min, max );
+
+    if ( Contains( min, max, position ) && Contains( min, max, listener ) )
+    {
+        float reflectance[RoomImpl::WallCount];
+        for ( uint32_t wall = 0; wall < RoomImpl::WallCount; ++wall )
+            reflectance[wall] = std::sqrt( 1.0f - room.getAbsorption( wall ) );
+
+        const float direct        = std::max( Distance( position, listener ), MinDistance );
+        const float level         = room.getLevel();
+        const float framesPerUnit = static_cast<float>( ma_engine_get_sample_rate( engine ) ) / PropagationDelayImpl::getSpeedOfSound();
+
+        size_t     count = 0;
+        const auto add   = [&]( const ma_vec3f& image, float gain ) {
+            Tap& tap = targets[count++];
+
+            const float distance = Distance( image, listener );
+            const float delay    = std::max( distance - direct, 0.0f ) * framesPerUnit;
+            if ( delay > static_cast<float>( reflections->maxDelay ) )
+                return;
+
+            tap.delay = static_cast<ma_uint32>( delay + 0.5f );
+            gain *= level * direct / std::max( distance, MinDistance );
+
+            if ( reflections->lineChannels == 1 )
+            {
+                tap.gains[0] = gain;
+                return;
+            }
+
+            // Constant power panning by the direction of the image source (relative to the listener).
+            const ma_vec3f direction = Normalize( { image.x - listener.x, image.y - listener.y, image.z - listener.z }, forward );
+            const float    angle     = ( std::clamp( Dot( direction, right ), -1.0f, 1.0f ) + 1.0f ) * Pi * 0.25f;
+
+            tap.gains[0] = gain * std::cos( angle );
+            tap.gains[1] = gain * std::sin( angle );
+        };
+
+        // First order: the sound mirrored by each wall.
+        for ( int axis = 0; axis < 3; ++axis )
+        {
+            ma_vec3f image = position;
+
+            At( image, axis ) = 2.0f * At( min, axis ) - At( position, axis );
+            add( image, reflectance[axis * 2] );
+
+            At( image, axis ) = 2.0f * At( max, axis ) - At( position, axis );
+            add( image, reflectance[axis * 2 + 1] );
+        }
+
+        if ( room.getOrder() >= 2 )
+        {
+            // Second order off the opposite walls of an axis: the sound shifted by twice the size of the room.
+            for ( int axis = 0; axis < 3; ++axis )
+            {
+                const float size = 2.0f * ( At( max, axis ) - At( min, axis ) );
+                const float gain = reflectance[axis * 2] * reflectance[axis * 2 + 1];
+
+                ma_vec3f image = position;
+
+                At( image, axis ) = At( position, axis ) + size;
+                add( image, gain );
+
+                At( image, axis ) = At( position, axis ) - size;
+                add( image, gain );
+            }
+
+            // Second order off the walls of two different axes: the sound mirrored by one wall of each axis.
+            for ( int a = 0; a < 3; ++a )
+            {
+                for ( int b = a + 1; b < 3; ++b )
+                {
+                    for ( int i = 0; i < 4; ++i )
+                    {
+                        const int wallA = a * 2 + ( i & 1 );
+                        const int wallB = b * 2 + ( i >> 1 );
+
+                        ma_vec3f image = position;
+                        At( image, a ) = 2.0f * At( ( i & 1 ) ? max : min, a ) - At( position, a );
+                        At( image, b ) = 2.0f * At( ( i >> 1 ) ? max : min, b ) - At( position, b );
+
+                        add( image, reflectance[wallA] * reflectance[wallB] );
+                    }
+                }
+            }
+        }
+    }
+
+    // The first block of a sound starts from silence, so its reflections are not ramped.
+    if ( !hasTaps )
+    {
+        std::copy_n( targets, MaxTaps, taps );
+        hasTaps = true;
+    }
+}
+
+void ImageSources::process( const float* in, ma_uint32 frameCount )
+{
+    updateTaps();
+
+    // The image sources may be processed more than once per round (if the delay line reads more frames than this node processes at a time).
+    if ( round != reflections->round )
+    {
+        round  = reflections->round;
+        offset = 0;
+    }
+
+    const ma_uint32 count = std::min( frameCount, reflections->capacity - offset );
+
+    // The reflections are not panned by the spatializer, so the sound is downmixed to mono.
+    const float downmix = 1.0f / static_cast<float>( inputChannels );
+    for ( ma_uint32 f = 0; f < count; ++f )
+    {
+        float sample = 0.0f;
+        for ( ma_uint32 c = 0; c < inputChannels; ++c )
+            sample += in[f * inputChannels + c];
+
+        mono[f] = sample * downmix;
+    }
+
+    float*       line  = reflections->line.data();
+    const size_t mask  = reflections->mask;
+    const size_t start = reflections->roundStart + offset;
+
+    const float silent[2] = { 0.0f, 0.0f };
+
+    for ( size_t t = 0; t < MaxTaps; ++t )
+    {
+        const Tap& tap    = taps[t];
+        const Tap& target = targets[t];
+
+        // The line channel count is a compile-time constant, so the inner loops are unrolled.
+        const auto scatter = [&]( ma_uint32 delay, const float* from, const float* to ) {
+            if ( reflections->lineChannels == 2 )
+                Scatter<2>( line, mask, start + delay, mono.data(), count, from, to );
+            else
+                Scatter<1>( line, mask, start + delay, mono.data(), count, from, to );
+        };
+
+        if ( tap.delay == target.delay )
+        {
+            scatter( tap.delay, tap.gains, target.gains );
+        }
+        else
+        {
+            // Crossfade from the previous delay to the new delay.
+            scatter( tap.delay, tap.gains, silent );
+            scatter( target.delay, silent, target.gains );
+        }
+
+        taps[t] = target;
+    }
+
+    offset += count;
+}
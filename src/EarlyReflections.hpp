@@ -0,0 +1,171 @@
+#pragma once
+
+#include "miniaudio.h"
+
+#include <memory>
+#include <vector>
+
+namespace Audio
+{
+class RoomImpl;
+
+/// <summary>
+/// The tapped delay line that renders the early reflections of all sounds of a bus (see `Bus::setRoom`).
+/// </summary>
+/// <remarks>
+/// Each sound computes its image sources (`ImageSources`) and adds itself to the delay line once per
+/// image source, at the delay and gain of the reflection. The delay line is shared, so the cost of a
+/// reflection is one multiply-add per frame (and channel): there is no per-voice delay line or filter.
+/// The image sources are inputs of this node (with a silent output), so they are processed before it,
+/// and the delay line is read in rounds like the sound field of the ambisonic decoder. The reflections
+/// are panned between the front left and front right channels (or mixed to mono).
+/// </remarks>
+class EarlyReflections
+{
+public:
+    EarlyReflections( ma_engine* pEngine, std::shared_ptr<RoomImpl> room );
+    ~EarlyReflections();
+
+    ma_node* getNode() noexcept
+    {
+        return &node.base;
+    }
+
+    ma_engine* getEngine() const noexcept
+    {
+        return engine;
+    }
+
+    const std::shared_ptr<RoomImpl>& getRoom() const noexcept
+    {
+        return room;
+    }
+
+    // The longest delay of a reflection (in seconds). Longer reflections are dropped.
+    static constexpr float MaxDelay = 0.25f;
+
+    EarlyReflections( const EarlyReflections& )            = delete;
+    EarlyReflections( EarlyReflections&& )                 = delete;
+    EarlyReflections& operator=( const EarlyReflections& ) = delete;
+    EarlyReflections& operator=( EarlyReflections&& )      = delete;
+
+private:
+    static void onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut );
+
+    friend class ImageSources;
+
+    struct Node
+    {
+        ma_node_base      base;
+        EarlyReflections* reflections;
+    };
+
+    ma_node_vtable vtable {};
+    Node           node {};
+    bool           initialized = false;
+
+    ma_engine*                engine = nullptr;
+    std::shared_ptr<RoomImpl> room;
+    ma_uint32                 outputChannels = 0;
+
+    // The delay line (frame x line channel) has 1 channel for mono output, and 2 channels otherwise.
+    // The size is a power of two. The frames that are read are cleared, so the image sources only add to it.
+    std::vector<float> line;
+    ma_uint32          lineChannels = 1;
+    size_t             mask         = 0;
+    ma_uint32          maxDelay     = 0;
+
+    // The delay line is read in rounds: the image sources write relative to the start of the round,
+    // and the round ends once all input frames are consumed.
+    size_t    roundStart = 0;
+    ma_uint32 capacity   = 0;
+    ma_uint32 round      = 0;
+    ma_uint32 consumed   = 0;
+};
+
+/// <summary>
+/// Computes the first and second order image sources of a sound in the room of its bus, and adds the sound to the
+/// delay line of the bus at the delay and gain of each reflection. The node is inserted between the sound (and its
+/// filters) and the target of the sound: output bus 0 passes the sound through, and output bus 1 (which is silent)
+/// is attached to the delay line, so the image sources are processed before the delay line is read.
+/// </summary>
+/// <remarks>
+/// The image sources are only recomputed when the sound, the listener, or the room has moved (or the room has changed).
+/// The gains are ramped over each block, and when the delay of a reflection changes, the reflection is crossfaded
+/// from the previous delay to the new delay.
+/// The input is the spatialized sound (attenuated for the direct path), so the reflections are scaled by the ratio of
+/// the direct distance and the distance of each image source (inverse distance attenuation relative to the direct sound).
+/// </remarks>
+class ImageSources
+{
+public:
+    ImageSources( EarlyReflections* reflections, ma_sound* pSound );
+    ~ImageSources();
+
+    ma_node* getNode() noexcept
+    {
+        return &node.base;
+    }
+
+    EarlyReflections* getReflections() const noexcept
+    {
+        return reflections;
+    }
+
+    // 6 first order reflections and 18 second order reflections.
+    static constexpr size_t MaxTaps = 24;
+
+    ImageSources( const ImageSources& )            = delete;
+    ImageSources( ImageSources&& )                 = delete;
+    ImageSources& operator=( const ImageSources& ) = delete;
+    ImageSources& operator=( ImageSources&& )      = delete;
+
+private:
+    static void onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut );
+
+    // Add the sound to the delay line once per reflection.
+    void process( const float* in, ma_uint32 frameCount );
+
+    // Recompute the target taps if the sound, the listener, or the room has changed since the last update.
+    void updateTaps();
+
+    struct Node
+    {
+        ma_node_base  base;
+        ImageSources* sources;
+    };
+
+    ma_node_vtable vtable {};
+    Node           node {};
+    bool           initialized = false;
+
+    EarlyReflections* reflections   = nullptr;
+    ma_sound*         sound         = nullptr;
+    ma_uint32         inputChannels = 0;
+
+    // A reflection: the delay (in frames) and the gains (per line channel).
+    struct Tap
+    {
+        ma_uint32 delay = 0;
+        float     gains[2] {};
+    };
+
+    // The taps of the previous block, and the taps the gains are ramped to in the next block.
+    Tap  taps[MaxTaps] {};
+    Tap  targets[MaxTaps] {};
+    bool hasTaps = false;
+
+    // The state the target taps were computed for.
+    ma_vec3f soundPosition {};
+    ma_vec3f listenerPosition {};
+    ma_vec3f listenerRight {};
+    uint32_t roomVersion = 0;
+
+    // The (mono) input of the current block.
+    std::vector<float> mono;
+
+    // The round of the delay line this node last wrote to, and the number of frames written in that round.
+    ma_uint32 round  = 0;
+    ma_uint32 offset = 0;
+};
+}  // namespace Audio
@@ -0,0 +1,47 @@
+#include <Audio/Effect.hpp>
+
+#include "EffectImpl.hpp"
+
+using namespace Audio;
+
+Effect::Effect()                               = default;
+Effect::~Effect()                              = default;
+Effect::Effect( const Effect& )                = default;
+Effect::Effect( Effect&& ) noexcept            = default;
+Effect& Effect::operator=( const Effect& )     = default;
+Effect& Effect::operator=( Effect&& ) noexcept = default;
+
+Effect& Effect::operator=( nullptr_t ) noexcept
+{
+    impl = nullptr;
+    return *this;
+}
+
+bool Effect::operator==( nullptr_t ) const noexcept
+{
+    return impl == nullptr;
+}
+
+bool Effect::operator!=( nullptr_t ) const noexcept
+{
+    return impl != nullptr;
+}
+
+Effect::operator bool() const noexcept
+{
+    return impl != nullptr;
+}
+
+std::shared_ptr<EffectImpl> Effect::get() const noexcept
+{
+    return impl;
+}
+
+void Effect::reset() noexcept
+{
+    impl.reset();
+}
+
+Effect::Effect( std::shared_ptr<EffectImpl> impl )
+: impl { std::move( impl ) }
+{}
@@ -0,0 +1,67 @@
+#include "EffectImpl.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Audio;
+
+CustomEffectImpl::CustomEffectImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, ma_uint8 inputBusCount, ma_uint32 flags )
+: EffectImpl( std::move( device ) )
+{
+    if ( !pEngine )
+        return;
+
+    channels   = ma_engine_get_channels( pEngine );
+    sampleRate = ma_engine_get_sample_rate( pEngine );
+
+    vtable.onProcess      = &CustomEffectImpl::onProcess;
+    vtable.inputBusCount  = inputBusCount;
+    vtable.outputBusCount = 1;
+    vtable.flags          = flags;
+
+    // All input buses and the output bus use the engine's channel count.
+    ma_uint32 inputChannels[MA_MAX_NODE_BUS_COUNT];
+    std::fill_n( inputChannels, inputBusCount, channels );
+
+    ma_node_config config  = ma_node_config_init();
+    config.vtable          = &vtable;
+    config.pInputChannels  = inputChannels;
+    config.pOutputChannels = &channels;
+
+    node.effect = this;
+
+    if ( ma_node_init( ma_engine_get_node_graph( pEngine ), &config, nullptr, &node.base ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize effect node." << std::endl;
+        return;
+    }
+
+    initialized = true;
+}
+
+CustomEffectImpl::~CustomEffectImpl()
+{
+    uninit();
+}
+
+void CustomEffectImpl::uninit() noexcept
+{
+    if ( initialized )
+    {
+        ma_node_uninit( &node.base, nullptr );
+        initialized = false;
+    }
+}
+
+void CustomEffectImpl::onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut )
+{
+    auto* effect = static_cast<Node*>( pNode )->effect;
+
+    // Input and output are processed at the same rate.
+    const ma_uint32 frameCount = std::min( *pFrameCountIn, *pFrameCountOut );
+
+    effect->process( ppFramesIn, ppFramesOut[0], frameCount );
+
+    *pFrameCountIn  = frameCount;
+    *pFrameCountOut = frameCount;
+}
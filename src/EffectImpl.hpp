@@ -0,0 +1,123 @@
+#pragma once
+
+#include "miniaudio.h"
+
+#include <memory>
+
+namespace Audio
+{
+class BusImpl;
+class DeviceImpl;
+
+/// <summary>
+/// Base class for all effect implementations.
+/// An effect is a node in the engine's node graph with a single input and a single output bus.
+/// </summary>
+class EffectImpl
+{
+public:
+    explicit EffectImpl( std::shared_ptr<DeviceImpl> device )
+    : device { std::move( device ) }
+    {}
+
+    virtual ~EffectImpl() = default;
+
+    /// <summary>
+    /// Get the node that implements this effect.
+    /// </summary>
+    virtual ma_node* getNode() noexcept = 0;
+
+    /// <summary>
+    /// Get the bus this effect was added to (or `nullptr` if the effect is not part of an effect chain).
+    /// </summary>
+    BusImpl* getBus() const noexcept
+    {
+        return bus;
+    }
+
+    void setBus( BusImpl* _bus ) noexcept
+    {
+        bus = _bus;
+    }
+
+    /// <summary>
+    /// Get the bus that drives this effect (for effects with a sidechain input).
+    /// </summary>
+    virtual std::shared_ptr<BusImpl> getSidechain() const
+    {
+        return nullptr;
+    }
+
+    EffectImpl( const EffectImpl& )            = delete;
+    EffectImpl( EffectImpl&& )                 = delete;
+    EffectImpl& operator=( const EffectImpl& ) = delete;
+    EffectImpl& operator=( EffectImpl&& )      = delete;
+
+protected:
+    std::shared_ptr<DeviceImpl> device;
+
+private:
+    BusImpl* bus = nullptr;
+};
+
+/// <summary>
+/// Base class for effects that implement their own processing.
+/// </summary>
+class CustomEffectImpl : public EffectImpl
+{
+public:
+    /// <summary>
+    /// Create a custom effect node.
+    /// </summary>
+    /// <param name="device">The device that owns the engine.</param>
+    /// <param name="pEngine">The engine the effect is processed by.</param>
+    /// <param name="inputBusCount">(optional) The number of input buses. Default: 1</param>
+    /// <param name="flags">(optional) The miniaudio node flags (for example, `MA_NODE_FLAG_CONTINUOUS_PROCESSING` for effects with a tail). Default: 0</param>
+    CustomEffectImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, ma_uint8 inputBusCount = 1, ma_uint32 flags = 0 );
+    ~CustomEffectImpl() override;
+
+    ma_node* getNode() noexcept override
+    {
+        return &node.base;
+    }
+
+protected:
+    /// <summary>
+    /// Process a block of interleaved frames (on the audio thread).
+    /// </summary>
+    /// <param name="ppFramesIn">The input frames for each input bus.</param>
+    /// <param name="pFramesOut">The output frames.</param>
+    /// <param name="frameCount">The number of frames to process.</param>
+    virtual void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) = 0;
+
+    /// <summary>
+    /// Uninitialize the node, and wait for the audio thread to stop processing it. Derived effects call this
+    /// in their destructor, because the node is only uninitialized by this class after their members are destroyed.
+    /// </summary>
+    void uninit() noexcept;
+
+    /// <summary>
+    /// Check if the node was successfully initialized.
+    /// </summary>
+    bool isInitialized() const noexcept
+    {
+        return initialized;
+    }
+
+    ma_uint32 channels   = 0u;
+    ma_uint32 sampleRate = 0u;
+
+private:
+    static void onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut );
+
+    struct Node
+    {
+        ma_node_base      base;
+        CustomEffectImpl* effect;
+    };
+
+    ma_node_vtable vtable {};
+    Node           node {};
+    bool           initialized = false;
+};
+}  // namespace Audio
@@ -0,0 +1,251 @@
+#include "EmitterGrid.hpp"
+#include "AttenuationCurveImpl.hpp"
+#include "SoundImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+namespace
+{
+float distance( const ma_vec3f& a, const ma_vec3f& b ) noexcept
+{
+    const float x = a.x - b.x;
+    const float y = a.y - b.y;
+    const float z = a.z - b.z;
+    return std::sqrt( x * x + y * y + z * z );
+}
+}  // namespace
+
+float EmitterGrid::estimateGain( const SoundImpl* soundImpl, float distance )
+{
+    const ma_sound* sound       = soundImpl->getSound();
+    const float     minDistance = ma_sound_get_min_distance( sound );
+    const float     maxDistance = ma_sound_get_max_distance( sound );
+    const float     rolloff     = ma_sound_get_rolloff( sound );
+    const float     d           = std::clamp( distance, minDistance, std::max( minDistance, maxDistance ) );
+
+    float gain = 1.0f;
+
+    if ( const AttenuationCurveImpl* curve = soundImpl->getAttenuationCurve() )
+    {
+        // The attenuation of the spatializer is only fitted to the curve at the current distance of the sound.
+        gain = curve->getGain( distance );
+    }
+    else if ( minDistance < maxDistance )
+    {
+        // Same as the attenuation models of the spatializer.
+        switch ( ma_sound_get_attenuation_model( sound ) )
+        {
+        case ma_attenuation_model_inverse:
+            gain = minDistance / ( minDistance + rolloff * ( d - minDistance ) );
+            break;
+        case ma_attenuation_model_linear:
+            gain = 1.0f - rolloff * ( d - minDistance ) / ( maxDistance - minDistance );
+            break;
+        case ma_attenuation_model_exponential:
+            gain = minDistance > 0.0f ? std::pow( d / minDistance, -rolloff ) : 1.0f;
+            break;
+        case ma_attenuation_model_none:
+            break;
+        }
+    }
+
+    gain = std::clamp( gain, ma_sound_get_min_gain( sound ), ma_sound_get_max_gain( sound ) );
+
+    return gain * ma_sound_get_volume( sound );
+}
+
+EmitterGrid& EmitterGrid::get()
+{
+    static EmitterGrid grid;
+    return grid;
+}
+
+void EmitterGrid::setCellSize( float size )
+{
+    std::lock_guard lock { mutex };
+
+    if ( size <= 0.0f || size == cellSize )
+        return;
+
+    cellSize = size;
+
+    // Rebuild the grid with the new cell size.
+    auto oldCells = std::move( cells );
+    cells.clear();
+
+    for ( auto& [key, emitters]: oldCells )
+    {
+        for ( const Emitter& emitter: emitters )
+        {
+            const uint64_t newKey = getKey( getCell( emitter.position ) );
+            cells[newKey].push_back( emitter );
+            soundCells[emitter.sound] = newKey;
+        }
+    }
+}
+
+float EmitterGrid::getCellSize() const
+{
+    std::lock_guard lock { mutex };
+    return cellSize;
+}
+
+void EmitterGrid::insert( SoundImpl* sound, const ma_vec3f& position )
+{
+    std::lock_guard lock { mutex };
+
+    const uint64_t key = getKey( getCell( position ) );
+    cells[key].push_back( { sound, position } );
+    soundCells[sound] = key;
+}
+
+void EmitterGrid::move( SoundImpl* sound, const ma_vec3f& position )
+{
+    std::lock_guard lock { mutex };
+
+    const auto iter = soundCells.find( sound );
+    if ( iter == soundCells.end() )
+        return;
+
+    const uint64_t key = getKey( getCell( position ) );
+
+    auto& emitters = cells[iter->second];
+    auto  emitter  = std::find_if( emitters.begin(), emitters.end(), [sound]( const Emitter& e ) { return e.sound == sound; } );
+
+    if ( key == iter->second )
+    {
+        emitter->position = position;
+        return;
+    }
+
+    // Move the sound to its new cell.
+    *emitter = emitters.back();
+    emitters.pop_back();
+    if ( emitters.empty() )
+        cells.erase( iter->second );
+
+    cells[key].push_back( { sound, position } );
+    iter->second = key;
+}
+
+void EmitterGrid::remove( SoundImpl* sound )
+{
+    std::lock_guard lock { mutex };
+
+    const auto iter = soundCells.find( sound );
+    if ( iter == soundCells.end() )
+        return;
+
+    auto& emitters = cells[iter->second];
+    auto  emitter  = std::find_if( emitters.begin(), emitters.end(), [sound]( const Emitter& e ) { return e.sound == sound; } );
+
+    *emitter = emitters.back();
+    emitters.pop_back();
+    if ( emitters.empty() )
+        cells.erase( iter->second );
+
+    soundCells.erase( iter );
+}
+
+std::vector<std::shared_ptr<SoundImpl>> EmitterGrid::query( ma_engine* pEngine, ma_uint32 listenerIndex, float radius, size_t maxCount ) const
+{
+    std::vector<std::shared_ptr<SoundImpl>> result;
+
+    if ( maxCount == 0 || radius < 0.0f )
+        return result;
+
+    const ma_vec3f listener = ma_engine_listener_get_position( pEngine, listenerIndex );
+
+    std::lock_guard lock { mutex };
+
+    std::vector<std::pair<float, Emitter>> candidates;
+
+    // Visit the cells that overlap the sphere, unless that's more cells than are occupied.
+    const double minX      = std::floor( ( static_cast<double>( listener.x ) - radius ) / cellSize );
+    const double minY      = std::floor( ( static_cast<double>( listener.y ) - radius ) / cellSize );
+    const double minZ      = std::floor( ( static_cast<double>( listener.z ) - radius ) / cellSize );
+    const double maxX      = std::floor( ( static_cast<double>( listener.x ) + radius ) / cellSize );
+    const double maxY      = std::floor( ( static_cast<double>( listener.y ) + radius ) / cellSize );
+    const double maxZ      = std::floor( ( static_cast<double>( listener.z ) + radius ) / cellSize );
+    const double cellCount = ( maxX - minX + 1.0 ) * ( maxY - minY + 1.0 ) * ( maxZ - minZ + 1.0 );
+
+    if ( !( cellCount < static_cast<double>( cells.size() ) ) )
+    {
+        for ( const auto& [key, emitters]: cells )
+            gather( emitters, listener, radius, candidates );
+    }
+    else
+    {
+        for ( auto z = static_cast<int32_t>( minZ ); z <= static_cast<int32_t>( maxZ ); ++z )
+        {
+            for ( auto y = static_cast<int32_t>( minY ); y <= static_cast<int32_t>( maxY ); ++y )
+            {
+                for ( auto x = static_cast<int32_t>( minX ); x <= static_cast<int32_t>( maxX ); ++x )
+                {
+                    const auto iter = cells.find( getKey( { x, y, z } ) );
+                    if ( iter != cells.end() )
+                        gather( iter->second, listener, radius, candidates );
+                }
+            }
+        }
+    }
+
+    // Replace the distances by the estimated loudness (and drop the sounds that can't be heard by the listener).
+    size_t count = 0;
+    for ( auto& [d, emitter]: candidates )
+    {
+        const ma_uint32 pinned = ma_sound_get_pinned_listener_index( emitter.sound->getSound() );
+
+        if ( pinned != MA_LISTENER_INDEX_CLOSEST && pinned != listenerIndex )
+            continue;
+
+        const float gain = estimateGain( emitter.sound, d );
+        if ( gain > 0.0f )
+            candidates[count++] = { gain, emitter };
+    }
+    candidates.resize( count );
+
+    // Only the loudest sounds need to be sorted.
+    const auto last = candidates.begin() + static_cast<std::ptrdiff_t>( std::min( maxCount, candidates.size() ) );
+    std::partial_sort( candidates.begin(), last, candidates.end(), []( const auto& a, const auto& b ) { return a.first > b.first; } );
+
+    result.reserve( static_cast<size_t>( last - candidates.begin() ) );
+    for ( auto iter = candidates.begin(); iter != last; ++iter )
+    {
+        // The sound may be in the process of being destroyed.
+        if ( auto sound = iter->second.sound->weak_from_this().lock() )
+            result.push_back( std::move( sound ) );
+    }
+
+    return result;
+}
+
+EmitterGrid::Cell EmitterGrid::getCell( const ma_vec3f& position ) const noexcept
+{
+    // Positions beyond the range of the grid are clamped to the outer cells.
+    const auto cell = [this]( float p ) {
+        return static_cast<int32_t>( std::clamp( std::floor( static_cast<double>( p ) / cellSize ), -1048576.0, 1048575.0 ) );
+    };
+
+    return { cell( position.x ), cell( position.y ), cell( position.z ) };
+}
+
+uint64_t EmitterGrid::getKey( const Cell& cell ) noexcept
+{
+    // 21 bits per coordinate. Cells that are far apart may share a key, which only costs a few extra distance checks.
+    constexpr uint64_t mask = ( 1u << 21 ) - 1;
+    return ( ( static_cast<uint64_t>( cell.x ) & mask ) << 42 ) | ( ( static_cast<uint64_t>( cell.y ) & mask ) << 21 ) | ( static_cast<uint64_t>( cell.z ) & mask );
+}
+
+void EmitterGrid::gather( const std::vector<Emitter>& emitters, const ma_vec3f& listener, float radius, std::vector<std::pair<float, Emitter>>& candidates )
+{
+    for ( const Emitter& emitter: emitters )
+    {
+        const float d = distance( emitter.position, listener );
+        if ( d <= radius )
+            candidates.emplace_back( d, emitter );
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "miniaudio.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Audio
+{
+class SoundImpl;
+
+/// <summary>
+/// A uniform grid of the positions of the spatialized sounds.
+/// The grid is used to find the sounds around a listener without iterating all of the sounds.
+/// </summary>
+/// <remarks>
+/// Only the occupied cells are stored (in a hash map), so the grid is unbounded.
+/// Moving a sound within its cell does not change the grid.
+/// </remarks>
+class EmitterGrid
+{
+public:
+    /// <summary>
+    /// Get the grid that contains all of the spatialized sounds.
+    /// </summary>
+    static EmitterGrid& get();
+
+    /// <summary>
+    /// Set the size of the cells of the grid (in world units).
+    /// The cell size should be about the same as the typical query radius.
+    /// </summary>
+    void  setCellSize( float size );
+    float getCellSize() const;
+
+    void insert( SoundImpl* sound, const ma_vec3f& position );
+    void move( SoundImpl* sound, const ma_vec3f& position );
+    void remove( SoundImpl* sound );
+
+    /// <summary>
+    /// Find the sounds that are within `radius` of a listener and can be heard by the listener,
+    /// sorted by their estimated loudness (loudest first).
+    /// </summary>
+    /// <param name="pEngine">The engine of the listener.</param>
+    /// <param name="listenerIndex">The index of the listener.</param>
+    /// <param name="radius">The maximum distance between a sound and the listener.</param>
+    /// <param name="maxCount">The maximum number of sounds to return.</param>
+    std::vector<std::shared_ptr<SoundImpl>> query( ma_engine* pEngine, ma_uint32 listenerIndex, float radius, size_t maxCount ) const;
+
+    /// <summary>
+    /// Estimate the gain of a sound at a distance from the listener (the volume and the distance attenuation).
+    /// </summary>
+    static float estimateGain( const SoundImpl* sound, float distance );
+
+    static constexpr float DefaultCellSize = 16.0f;
+
+    EmitterGrid()                                = default;
+    ~EmitterGrid()                               = default;
+    EmitterGrid( const EmitterGrid& )            = delete;
+    EmitterGrid( EmitterGrid&& )                 = delete;
+    EmitterGrid& operator=( const EmitterGrid& ) = delete;
+    EmitterGrid& operator=( EmitterGrid&& )      = delete;
+
+private:
+    struct Emitter
+    {
+        SoundImpl* sound;
+        ma_vec3f   position;
+    };
+
+    struct Cell
+    {
+        int32_t x, y, z;
+    };
+
+    Cell            getCell( const ma_vec3f& position ) const noexcept;
+    static uint64_t getKey( const Cell& cell ) noexcept;
+
+    // Append the emitters of a cell that are within `radius` of `listener`.
+    static void gather( const std::vector<Emitter>& cell, const ma_vec3f& listener, float radius, std::vector<std::pair<float, Emitter>>& candidates );
+
+    mutable std::mutex mutex;
+    float              cellSize = DefaultCellSize;
+
+    // The emitters in each (occupied) cell, and the cell of each sound.
+    std::unordered_map<uint64_t, std::vector<Emitter>> cells;
+    std::unordered_map<SoundImpl*, uint64_t>           soundCells;
+};
+}  // namespace Audio
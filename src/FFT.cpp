@@ -0,0 +1,206 @@
+#include "FFT.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#if defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 )
+    #include <xmmintrin.h>
+    #define AUDIO_FFT_SSE
+#elif defined( __ARM_NEON ) || defined( _M_ARM64 )
+    #include <arm_neon.h>
+    #define AUDIO_FFT_NEON
+#endif
+
+using namespace Audio;
+
+static constexpr double two_pi = 6.28318530717958647692;
+
+FFT::FFT( size_t _size )
+: size { _size }
+, half { _size / 2 }
+{
+    assert( size >= 4 && ( size & ( size - 1 ) ) == 0 && "FFT size must be a power of 2." );
+
+    size_t bits = 0;
+    while ( ( size_t { 1 } << bits ) < half )
+        ++bits;
+
+    bitReverse.resize( half );
+    for ( size_t i = 0; i < half; ++i )
+    {
+        size_t r = 0;
+        for ( size_t b = 0; b < bits; ++b )
+        {
+            if ( i & ( size_t { 1 } << b ) )
+                r |= size_t { 1 } << ( bits - 1 - b );
+        }
+        bitReverse[i] = r;
+    }
+
+    // Stage with butterflies of size `n` uses n/2 twiddle factors.
+    // All stages are stored one after the other: 1 + 2 + 4 + ... + half/2 = half - 1 factors.
+    twiddleRe.reserve( half );
+    twiddleIm.reserve( half );
+    for ( size_t n = 2; n <= half; n *= 2 )
+    {
+        for ( size_t k = 0; k < n / 2; ++k )
+        {
+            const double a = -two_pi * static_cast<double>( k ) / static_cast<double>( n );
+            twiddleRe.push_back( static_cast<float>( std::cos( a ) ) );
+            twiddleIm.push_back( static_cast<float>( std::sin( a ) ) );
+        }
+    }
+
+    splitRe.resize( half + 1 );
+    splitIm.resize( half + 1 );
+    for ( size_t k = 0; k <= half; ++k )
+    {
+        const double a = -two_pi * static_cast<double>( k ) / static_cast<double>( size );
+        splitRe[k]     = static_cast<float>( std::cos( a ) );
+        splitIm[k]     = static_cast<float>( std::sin( a ) );
+    }
+
+    workRe.resize( half );
+    workIm.resize( half );
+}
+
+void FFT::transform( float* re, float* im, bool inverse )
+{
+    for ( size_t i = 0; i < half; ++i )
+    {
+        const size_t j = bitReverse[i];
+        if ( j > i )
+        {
+            std::swap( re[i], re[j] );
+            std::swap( im[i], im[j] );
+        }
+    }
+
+    const float sign = inverse ? -1.0f : 1.0f;
+
+    const float* wRe = twiddleRe.data();
+    const float* wIm = twiddleIm.data();
+
+    for ( size_t n = 2; n <= half; n *= 2 )
+    {
+        const size_t h = n / 2;
+        for ( size_t start = 0; start < half; start += n )
+        {
+            float* aRe = re + start;
+            float* aIm = im + start;
+            float* bRe = aRe + h;
+            float* bIm = aIm + h;
+
+            // Contiguous twiddles allow the compiler to vectorize this loop.
+            for ( size_t k = 0; k < h; ++k )
+            {
+                const float wr = wRe[k];
+                const float wi = wIm[k] * sign;
+                const float tr = wr * bRe[k] - wi * bIm[k];
+                const float ti = wr * bIm[k] + wi * bRe[k];
+                bRe[k]         = aRe[k] - tr;
+                bIm[k]         = aIm[k] - ti;
+                aRe[k] += tr;
+                aIm[k] += ti;
+            }
+        }
+        wRe += h;
+        wIm += h;
+    }
+}
+
+void FFT::forward( const float* in, float* re, float* im )
+{
+    // Pack the even samples in the real part and the odd samples in the imaginary part.
+    for ( size_t i = 0; i < half; ++i )
+    {
+        workRe[i] = in[2 * i];
+        workIm[i] = in[2 * i + 1];
+    }
+
+    transform( workRe.data(), workIm.data(), false );
+
+    // Split the spectrum of the packed signal into the spectrum of the real signal.
+    for ( size_t k = 0; k <= half; ++k )
+    {
+        const size_t k0  = k == half ? 0 : k;
+        const size_t k1  = k == 0 ? 0 : half - k;
+        const float  zr  = workRe[k0];
+        const float  zi  = workIm[k0];
+        const float  cr  = workRe[k1];
+        const float  ci  = -workIm[k1];
+        const float  er  = 0.5f * ( zr + cr );
+        const float  ei  = 0.5f * ( zi + ci );
+        const float  orr = 0.5f * ( zi - ci );  // (z - conj) / 2i
+        const float  oi  = -0.5f * ( zr - cr );
+        re[k]            = er + splitRe[k] * orr - splitIm[k] * oi;
+        im[k]            = ei + splitRe[k] * oi + splitIm[k] * orr;
+    }
+}
+
+void FFT::inverse( const float* re, const float* im, float* out )
+{
+    // Merge the spectrum of the real signal into the spectrum of the packed signal.
+    for ( size_t k = 0; k < half; ++k )
+    {
+        const float xr = re[k];
+        const float xi = im[k];
+        const float cr = re[half - k];
+        const float ci = -im[half - k];
+        const float er = 0.5f * ( xr + cr );
+        const float ei = 0.5f * ( xi + ci );
+        const float dr = 0.5f * ( xr - cr );
+        const float di = 0.5f * ( xi - ci );
+        // O = D * conj(W^k)
+        const float orr = dr * splitRe[k] + di * splitIm[k];
+        const float oi  = di * splitRe[k] - dr * splitIm[k];
+        // Z = E + iO
+        workRe[k] = er - oi;
+        workIm[k] = ei + orr;
+    }
+
+    transform( workRe.data(), workIm.data(), true );
+
+    const float scale = 1.0f / static_cast<float>( half );
+    for ( size_t i = 0; i < half; ++i )
+    {
+        out[2 * i]     = workRe[i] * scale;
+        out[2 * i + 1] = workIm[i] * scale;
+    }
+}
+
+void FFT::multiplyAccumulate( const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* accRe, float* accIm, size_t binCount ) noexcept
+{
+    size_t k = 0;
+
+#if defined( AUDIO_FFT_SSE )
+    for ( ; k + 4 <= binCount; k += 4 )
+    {
+        const __m128 ar = _mm_loadu_ps( aRe + k );
+        const __m128 ai = _mm_loadu_ps( aIm + k );
+        const __m128 br = _mm_loadu_ps( bRe + k );
+        const __m128 bi = _mm_loadu_ps( bIm + k );
+
+        _mm_storeu_ps( accRe + k, _mm_add_ps( _mm_loadu_ps( accRe + k ), _mm_sub_ps( _mm_mul_ps( ar, br ), _mm_mul_ps( ai, bi ) ) ) );
+        _mm_storeu_ps( accIm + k, _mm_add_ps( _mm_loadu_ps( accIm + k ), _mm_add_ps( _mm_mul_ps( ar, bi ), _mm_mul_ps( ai, br ) ) ) );
+    }
+#elif defined( AUDIO_FFT_NEON )
+    for ( ; k + 4 <= binCount; k += 4 )
+    {
+        const float32x4_t ar = vld1q_f32( aRe + k );
+        const float32x4_t ai = vld1q_f32( aIm + k );
+        const float32x4_t br = vld1q_f32( bRe + k );
+        const float32x4_t bi = vld1q_f32( bIm + k );
+
+        vst1q_f32( accRe + k, vmlsq_f32( vmlaq_f32( vld1q_f32( accRe + k ), ar, br ), ai, bi ) );
+        vst1q_f32( accIm + k, vmlaq_f32( vmlaq_f32( vld1q_f32( accIm + k ), ar, bi ), ai, br ) );
+    }
+#endif
+
+    // The remaining bins (the Nyquist bin).
+    for ( ; k < binCount; ++k )
+    {
+        accRe[k] += aRe[k] * bRe[k] - aIm[k] * bIm[k];
+        accIm[k] += aRe[k] * bIm[k] + aIm[k] * bRe[k];
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// A real-valued fast Fourier transform.
+/// </summary>
+/// <remarks>
+/// The spectrum is stored in split format (separate real and imaginary arrays)
+/// so that operations on the spectrum (like complex multiply-accumulate) can be vectorized.
+/// A transform of `size` real samples produces `size / 2 + 1` complex bins.
+/// </remarks>
+class FFT
+{
+public:
+    /// <summary>
+    /// Create a transform for `size` real samples.
+    /// </summary>
+    /// <param name="size">The number of real samples. Must be a power of 2 (and at least 4).</param>
+    explicit FFT( size_t size );
+
+    size_t getSize() const noexcept
+    {
+        return size;
+    }
+
+    /// <summary>
+    /// The number of complex bins in the spectrum.
+    /// </summary>
+    size_t getBinCount() const noexcept
+    {
+        return half + 1;
+    }
+
+    /// <summary>
+    /// Compute the spectrum of `size` real samples.
+    /// </summary>
+    void forward( const float* in, float* re, float* im );
+
+    /// <summary>
+    /// Compute `size` real samples from a spectrum.
+    /// The result is normalized so that `inverse( forward( x ) ) == x`.
+    /// </summary>
+    void inverse( const float* re, const float* im, float* out );
+
+    /// <summary>
+    /// Multiply two spectra and add the result to an accumulator: acc += a * b.
+    /// </summary>
+    static void multiplyAccumulate( const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* accRe, float* accIm, size_t binCount ) noexcept;
+
+private:
+    // Complex transform of `half` points (in-place).
+    void transform( float* re, float* im, bool inverse );
+
+    size_t size;
+    size_t half;
+
+    std::vector<size_t> bitReverse;
+    // Twiddle factors for each stage of the complex transform (stored contiguously per stage).
+    std::vector<float> twiddleRe;
+    std::vector<float> twiddleIm;
+    // Twiddle factors to split (or merge) the real spectrum.
+    std::vector<float> splitRe;
+    std::vector<float> splitIm;
+    // Working buffers.
+    std::vector<float> workRe;
+    std::vector<float> workIm;
+};
+}  // namespace Audio
@@ -0,0 +1,55 @@
+#include <Audio/Device.hpp>
+#include <Audio/Filter.hpp>
+
+#include "FilterImpl.hpp"
+
+using namespace Audio;
+
+Filter::Filter( Type type, float frequency, float q, float gainDB )
+{
+    *this = Device::createFilter( type, frequency, q, gainDB );
+}
+
+Filter::Filter( std::shared_ptr<EffectImpl> impl )
+: Effect( std::move( impl ) )
+{}
+
+void Filter::setType( Type type )
+{
+    std::static_pointer_cast<FilterImpl>( get() )->setType( type );
+}
+
+Filter::Type Filter::getType() const
+{
+    return std::static_pointer_cast<FilterImpl>( get() )->getType();
+}
+
+void Filter::setFrequency( float frequency )
+{
+    std::static_pointer_cast<FilterImpl>( get() )->setFrequency( frequency );
+}
+
+float Filter::getFrequency() const
+{
+    return std::static_pointer_cast<FilterImpl>( get() )->getFrequency();
+}
+
+void Filter::setQ( float q )
+{
+    std::static_pointer_cast<FilterImpl>( get() )->setQ( q );
+}
+
+float Filter::getQ() const
+{
+    return std::static_pointer_cast<FilterImpl>( get() )->getQ();
+}
+
+void Filter::setGain( float gainDB )
+{
+    std::static_pointer_cast<FilterImpl>( get() )->setGain( gainDB );
+}
+
+float Filter::getGain() const
+{
+    return std::static_pointer_cast<FilterImpl>( get() )->getGain();
+}
@@ -0,0 +1,170 @@
+#include "FilterImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace Audio;
+
+FilterImpl::FilterImpl( std::shared_ptr<DeviceImpl> device, Filter::Type _type, float _frequency, float _q, float _gainDB, ma_engine* pEngine )
+: EffectImpl( std::move( device ) )
+, type { _type }
+, frequency { _frequency }
+, q { _q }
+, gainDB { _gainDB }
+{
+    if ( !pEngine )
+        return;
+
+    channels   = ma_engine_get_channels( pEngine );
+    sampleRate = ma_engine_get_sample_rate( pEngine );
+
+    const ma_biquad_node_config config = ma_biquad_node_config_init( channels, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f );
+    if ( ma_biquad_node_init( ma_engine_get_node_graph( pEngine ), &config, nullptr, &node ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize filter." << std::endl;
+        return;
+    }
+
+    const ma_biquad_config biquadConfig = getConfig();
+    ma_biquad_node_reinit( &biquadConfig, &node );
+}
+
+FilterImpl::~FilterImpl()
+{
+    ma_biquad_node_uninit( &node, nullptr );
+}
+
+void FilterImpl::setType( Filter::Type _type )
+{
+    type = _type;
+
+    const ma_biquad_config config = getConfig();
+    ma_biquad_node_reinit( &config, &node );
+}
+
+Filter::Type FilterImpl::getType() const noexcept
+{
+    return type;
+}
+
+void FilterImpl::setFrequency( float _frequency )
+{
+    frequency = _frequency;
+
+    const ma_biquad_config config = getConfig();
+    ma_biquad_node_reinit( &config, &node );
+}
+
+float FilterImpl::getFrequency() const noexcept
+{
+    return frequency;
+}
+
+void FilterImpl::setQ( float _q )
+{
+    q = _q;
+
+    const ma_biquad_config config = getConfig();
+    ma_biquad_node_reinit( &config, &node );
+}
+
+float FilterImpl::getQ() const noexcept
+{
+    return q;
+}
+
+void FilterImpl::setGain( float _gainDB )
+{
+    gainDB = _gainDB;
+
+    const ma_biquad_config config = getConfig();
+    ma_biquad_node_reinit( &config, &node );
+}
+
+float FilterImpl::getGain() const noexcept
+{
+    return gainDB;
+}
+
+ma_biquad_config FilterImpl::getConfig() const
+{
+    // Coefficients from the Audio EQ Cookbook by Robert Bristow-Johnson.
+    // See: https://www.w3.org/TR/audio-eq-cookbook/
+    const double nyquist = sampleRate > 0 ? sampleRate * 0.5 : 24000.0;
+    const double f0      = std::clamp<double>( frequency, 1.0, nyquist * 0.99 );
+    const double w0      = 2.0 * 3.14159265358979323846 * f0 / ( nyquist * 2.0 );
+    const double cosw0   = std::cos( w0 );
+    const double alpha   = std::sin( w0 ) / ( 2.0 * std::max<double>( q, 0.01 ) );
+    const double A       = std::pow( 10.0, gainDB / 40.0 );
+
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a0 = 1.0, a1 = 0.0, a2 = 0.0;
+
+    switch ( type )
+    {
+    case Filter::Type::LowPass:
+        b0 = ( 1.0 - cosw0 ) / 2.0;
+        b1 = 1.0 - cosw0;
+        b2 = ( 1.0 - cosw0 ) / 2.0;
+        a0 = 1.0 + alpha;
+        a1 = -2.0 * cosw0;
+        a2 = 1.0 - alpha;
+        break;
+    case Filter::Type::HighPass:
+        b0 = ( 1.0 + cosw0 ) / 2.0;
+        b1 = -( 1.0 + cosw0 );
+        b2 = ( 1.0 + cosw0 ) / 2.0;
+        a0 = 1.0 + alpha;
+        a1 = -2.0 * cosw0;
+        a2 = 1.0 - alpha;
+        break;
+    case Filter::Type::BandPass:
+        b0 = alpha;
+        b1 = 0.0;
+        b2 = -alpha;
+        a0 = 1.0 + alpha;
+        a1 = -2.0 * cosw0;
+        a2 = 1.0 - alpha;
+        break;
+    case Filter::Type::Notch:
+        b0 = 1.0;
+        b1 = -2.0 * cosw0;
+        b2 = 1.0;
+        a0 = 1.0 + alpha;
+        a1 = -2.0 * cosw0;
+        a2 = 1.0 - alpha;
+        break;
+    case Filter::Type::Peak:
+        b0 = 1.0 + alpha * A;
+        b1 = -2.0 * cosw0;
+        b2 = 1.0 - alpha * A;
+        a0 = 1.0 + alpha / A;
+        a1 = -2.0 * cosw0;
+        a2 = 1.0 - alpha / A;
+        break;
+    case Filter::Type::LowShelf:
+    {
+        const double sqrtA = 2.0 * std::sqrt( A ) * alpha;
+        b0                 = A * ( ( A + 1.0 ) - ( A - 1.0 ) * cosw0 + sqrtA );
+        b1                 = 2.0 * A * ( ( A - 1.0 ) - ( A + 1.0 ) * cosw0 );
+        b2                 = A * ( ( A + 1.0 ) - ( A - 1.0 ) * cosw0 - sqrtA );
+        a0                 = ( A + 1.0 ) + ( A - 1.0 ) * cosw0 + sqrtA;
+        a1                 = -2.0 * ( ( A - 1.0 ) + ( A + 1.0 ) * cosw0 );
+        a2                 = ( A + 1.0 ) + ( A - 1.0 ) * cosw0 - sqrtA;
+    }
+    break;
+    case Filter::Type::HighShelf:
+    {
+        const double sqrtA = 2.0 * std::sqrt( A ) * alpha;
+        b0                 = A * ( ( A + 1.0 ) + ( A - 1.0 ) * cosw0 + sqrtA );
+        b1                 = -2.0 * A * ( ( A - 1.0 ) + ( A + 1.0 ) * cosw0 );
+        b2                 = A * ( ( A + 1.0 ) + ( A - 1.0 ) * cosw0 - sqrtA );
+        a0                 = ( A + 1.0 ) - ( A - 1.0 ) * cosw0 + sqrtA;
+        a1                 = 2.0 * ( ( A - 1.0 ) - ( A + 1.0 ) * cosw0 );
+        a2                 = ( A + 1.0 ) - ( A - 1.0 ) * cosw0 - sqrtA;
+    }
+    break;
+    }
+
+    return ma_biquad_config_init( ma_format_f32, channels, b0, b1, b2, a0, a1, a2 );
+}
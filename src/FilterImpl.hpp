@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Audio/Filter.hpp>
+
+#include "EffectImpl.hpp"
+
+namespace Audio
+{
+class FilterImpl : public EffectImpl
+{
+public:
+    FilterImpl( std::shared_ptr<DeviceImpl> device, Filter::Type type, float frequency, float q, float gainDB, ma_engine* pEngine );
+    ~FilterImpl() override;
+
+    ma_node* getNode() noexcept override
+    {
+        return &node;
+    }
+
+    void         setType( Filter::Type type );
+    Filter::Type getType() const noexcept;
+
+    void  setFrequency( float frequency );
+    float getFrequency() const noexcept;
+
+    void  setQ( float q );
+    float getQ() const noexcept;
+
+    void  setGain( float gainDB );
+    float getGain() const noexcept;
+
+private:
+    // Compute the biquad coefficients for the current filter settings.
+    ma_biquad_config getConfig() const;
+
+    Filter::Type type;
+    float        frequency  = 0.0f;
+    float        q          = 0.0f;
+    float        gainDB     = 0.0f;
+    ma_uint32    channels   = 0u;
+    ma_uint32    sampleRate = 0u;
+
+    ma_biquad_node node {};
+};
+}  // namespace Audio
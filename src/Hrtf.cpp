@@ -0,0 +1,214 @@
+#include "Hrtf.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <regex>
+#include <utility>
+
+using namespace Audio;
+
+static constexpr double Pi = 3.14159265358979323846;
+
+namespace
+{
+std::atomic<const Hrtf*> current { nullptr };
+
+struct Response
+{
+    std::vector<float> left;
+    std::vector<float> right;
+};
+
+// Decode a stereo HRIR file at the given sample rate.
+bool LoadResponse( const std::filesystem::path& filePath, ma_uint32 sampleRate, Response& response )
+{
+    const ma_decoder_config config = ma_decoder_config_init( ma_format_f32, 2, sampleRate );
+    ma_decoder              decoder;
+
+    if ( ma_decoder_init_file_w( filePath.wstring().c_str(), &config, &decoder ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to load HRIR: " << filePath.string() << std::endl;
+        return false;
+    }
+
+    float     buffer[1024];
+    ma_uint64 framesRead = 0;
+    do
+    {
+        ma_decoder_read_pcm_frames( &decoder, buffer, std::size( buffer ) / 2, &framesRead );
+        for ( ma_uint64 i = 0; i < framesRead && response.left.size() < Hrtf::MaxLength; ++i )
+        {
+            response.left.push_back( buffer[i * 2 + 0] );
+            response.right.push_back( buffer[i * 2 + 1] );
+        }
+    } while ( framesRead > 0 && response.left.size() < Hrtf::MaxLength );
+
+    ma_decoder_uninit( &decoder );
+
+    return !response.left.empty();
+}
+
+// The direction of a measurement in listener space (azimuth is clockwise from the front).
+ma_vec3f GetDirection( int elevation, int azimuth )
+{
+    const double el = elevation * Pi / 180.0;
+    const double az = azimuth * Pi / 180.0;
+
+    return { static_cast<float>( std::cos( el ) * std::sin( az ) ), static_cast<float>( std::sin( el ) ), static_cast<float>( -std::cos( el ) * std::cos( az ) ) };
+}
+}  // namespace
+
+const Hrtf* Hrtf::getCurrent() noexcept
+{
+    return current.load( std::memory_order_acquire );
+}
+
+void Hrtf::setCurrent( const Hrtf* hrtf ) noexcept
+{
+    current.store( hrtf, std::memory_order_release );
+}
+
+std::unique_ptr<Hrtf> Hrtf::load( const std::filesystem::path& directory, ma_uint32 sampleRate )
+{
+    // The measurements keyed by (elevation, azimuth).
+    std::map<std::pair<int, int>, Response> responses;
+
+    const std::regex pattern { R"((-?\d+)e(\d+)a)", std::regex::icase };
+
+    std::error_code error;
+    for ( const auto& entry: std::filesystem::recursive_directory_iterator( directory, error ) )
+    {
+        if ( !entry.is_regular_file() )
+            continue;
+
+        const std::string name = entry.path().stem().string();
+        std::smatch       match;
+        if ( !std::regex_search( name, match, pattern ) )
+            continue;
+
+        const int elevation = std::stoi( match[1].str() );
+        const int azimuth   = std::stoi( match[2].str() ) % 360;
+
+        Response response;
+        if ( LoadResponse( entry.path(), sampleRate, response ) )
+            responses[{ elevation, azimuth }] = std::move( response );
+    }
+
+    if ( error || responses.empty() )
+    {
+        std::cerr << "Failed to load HRTF: " << directory.string() << std::endl;
+        return nullptr;
+    }
+
+    // Mirror the measurements of one hemisphere to the other hemisphere (if it is missing).
+    std::vector<std::pair<std::pair<int, int>, Response>> mirrored;
+    for ( const auto& [key, response]: responses )
+    {
+        const auto mirror = std::make_pair( key.first, ( 360 - key.second ) % 360 );
+        if ( responses.count( mirror ) == 0 )
+            mirrored.push_back( { mirror, { response.right, response.left } } );
+    }
+    for ( auto& [key, response]: mirrored )
+        responses[key] = std::move( response );
+
+    auto hrtf = std::make_unique<Hrtf>();
+
+    for ( const auto& [key, response]: responses )
+        hrtf->length = std::max( hrtf->length, response.left.size() );
+
+    // Normalize the set to unit (average) energy, so HRTF sounds are about as loud as panned sounds.
+    double energy = 0.0;
+    for ( const auto& [key, response]: responses )
+    {
+        for ( size_t i = 0; i < response.left.size(); ++i )
+            energy += 0.5 * ( static_cast<double>( response.left[i] ) * response.left[i] + static_cast<double>( response.right[i] ) * response.right[i] );
+    }
+    const float scale = energy > 0.0 ? static_cast<float>( 1.0 / std::sqrt( energy / static_cast<double>( responses.size() ) ) ) : 1.0f;
+
+    hrtf->samples.resize( responses.size() * hrtf->length * 2 );
+
+    for ( const auto& [key, response]: responses )
+    {
+        const size_t offset = hrtf->measurements.size() * hrtf->length * 2;
+        hrtf->measurements.push_back( { GetDirection( key.first, key.second ), offset } );
+
+        float* left  = hrtf->samples.data() + offset;
+        float* right = left + hrtf->length;
+        for ( size_t i = 0; i < response.left.size(); ++i )
+        {
+            left[i]  = response.left[i] * scale;
+            right[i] = response.right[i] * scale;
+        }
+    }
+
+    return hrtf;
+}
+
+void Hrtf::interpolate( const ma_vec3f& direction, float* left, float* right ) const
+{
+    // Find the three closest measurements (the largest dot products).
+    constexpr size_t count = 3;
+
+    size_t closest[count] {};
+    float  dots[count] { -2.0f, -2.0f, -2.0f };
+
+    for ( size_t m = 0; m < measurements.size(); ++m )
+    {
+        const ma_vec3f& d   = measurements[m].direction;
+        float           dot = d.x * direction.x + d.y * direction.y + d.z * direction.z;
+        size_t          i   = m;
+
+        // Insertion into the (sorted) list of closest measurements.
+        for ( size_t k = 0; k < count; ++k )
+        {
+            if ( dot > dots[k] )
+            {
+                std::swap( dot, dots[k] );
+                std::swap( i, closest[k] );
+            }
+        }
+    }
+
+    // Inverse angular distance weights.
+    float weights[count] {};
+    float total = 0.0f;
+    for ( size_t k = 0; k < std::min( count, measurements.size() ); ++k )
+    {
+        const float angle = std::acos( std::clamp( dots[k], -1.0f, 1.0f ) );
+
+        // The direction is (almost) exactly on a measurement.
+        if ( angle < 1e-3f )
+        {
+            std::fill_n( weights, count, 0.0f );
+            weights[k] = 1.0f;
+            total      = 1.0f;
+            break;
+        }
+
+        weights[k] = 1.0f / angle;
+        total += weights[k];
+    }
+
+    std::fill_n( left, length, 0.0f );
+    std::fill_n( right, length, 0.0f );
+
+    for ( size_t k = 0; k < count; ++k )
+    {
+        if ( weights[k] == 0.0f )
+            continue;
+
+        const float  w = weights[k] / total;
+        const float* l = samples.data() + measurements[closest[k]].offset;
+        const float* r = l + length;
+
+        for ( size_t i = 0; i < length; ++i )
+        {
+            left[i] += w * l[i];
+            right[i] += w * r[i];
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "miniaudio.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// A set of head-related impulse responses (HRIRs), measured for a number of directions around the listener.
+/// </summary>
+/// <remarks>
+/// The HRIRs are loaded from a directory of stereo WAV files (left and right ear), one file per direction.
+/// The direction is encoded in the file name as `e<elevation>a<azimuth>` (in degrees), like the MIT KEMAR
+/// set (for example, `H-10e090a.wav` was measured 10 degrees below and 90 degrees to the right of the listener).
+/// Sets that only contain the right hemisphere (like the compact KEMAR set) are mirrored to the left hemisphere.
+/// </remarks>
+class Hrtf
+{
+public:
+    /// <summary>
+    /// Load a set of HRIRs (resampled to the given sample rate).
+    /// </summary>
+    /// <param name="directory">The directory that contains the HRIR files.</param>
+    /// <param name="sampleRate">The sample rate of the engine.</param>
+    /// <returns>The HRIR set, or `nullptr` if the directory does not contain any HRIRs.</returns>
+    static std::unique_ptr<Hrtf> load( const std::filesystem::path& directory, ma_uint32 sampleRate );
+
+    /// <summary>
+    /// Get (or set) the HRIR set that is used for binaural rendering.
+    /// The HRIR set must stay alive while it can be used by the audio thread.
+    /// </summary>
+    static const Hrtf* getCurrent() noexcept;
+    static void        setCurrent( const Hrtf* hrtf ) noexcept;
+
+    /// <summary>
+    /// The number of samples of each HRIR.
+    /// </summary>
+    size_t getLength() const noexcept
+    {
+        return length;
+    }
+
+    /// <summary>
+    /// Interpolate the HRIRs of the (three) measurements closest to a direction.
+    /// </summary>
+    /// <param name="direction">The (unit) direction of the sound in listener space (-Z is forward, +X is right, +Y is up).</param>
+    /// <param name="left">Receives `getLength()` samples of the left ear HRIR.</param>
+    /// <param name="right">Receives `getLength()` samples of the right ear HRIR.</param>
+    void interpolate( const ma_vec3f& direction, float* left, float* right ) const;
+
+    // HRIRs are truncated to this length.
+    static constexpr size_t MaxLength = 512;
+
+private:
+    struct Measurement
+    {
+        ma_vec3f direction;
+        // The left ear HRIR starts at `offset` in `samples`, followed by the right ear HRIR.
+        size_t offset;
+    };
+
+    std::vector<Measurement> measurements;
+    std::vector<float>       samples;
+    size_t                   length = 0;
+};
+}  // namespace Audio
@@ -0,0 +1,197 @@
+#include "HrtfFilterImpl.hpp"
+#include "Hrtf.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+// The filter is updated when the direction of the sound changes by more than 1 degree.
+static const float MinDirectionChange = std::cos( 3.14159265358979323846f / 180.0f );
+
+HrtfFilterImpl::HrtfFilterImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, const Hrtf* _hrtf, ma_sound* pSound )
+: CustomEffectImpl( std::move( device ), pEngine )
+, hrtf { _hrtf }
+, engine { pEngine }
+, sound { pSound }
+, partitionCount { ( _hrtf->getLength() + BlockSize - 1 ) / BlockSize }
+, binCount { BlockSize + 1 }
+, fft { BlockSize * 2 }
+{
+    for ( auto& filter: filters )
+    {
+        for ( size_t ear = 0; ear < 2; ++ear )
+        {
+            filter.re[ear].resize( partitionCount * binCount );
+            filter.im[ear].resize( partitionCount * binCount );
+        }
+    }
+
+    inputRe.resize( partitionCount * binCount );
+    inputIm.resize( partitionCount * binCount );
+    window.resize( BlockSize * 2 );
+    input.resize( BlockSize );
+    output.resize( BlockSize * 2 );
+    hrir[0].resize( partitionCount * BlockSize );
+    hrir[1].resize( partitionCount * BlockSize );
+    padded.resize( BlockSize * 2 );
+    accRe.resize( binCount );
+    accIm.resize( binCount );
+    result.resize( BlockSize * 2 );
+    block.resize( BlockSize );
+    faded.resize( BlockSize );
+}
+
+HrtfFilterImpl::~HrtfFilterImpl()
+{
+    uninit();
+}
+
+void HrtfFilterImpl::process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount )
+{
+    const float* in = ppFramesIn[0];
+
+    // Binaural rendering is only possible on a stereo device.
+    if ( channels != 2 )
+    {
+        std::copy_n( in, frameCount * channels, pFramesOut );
+        return;
+    }
+
+    ma_uint32 frame = 0;
+    while ( frame < frameCount )
+    {
+        const auto count = std::min( frameCount - frame, static_cast<ma_uint32>( BlockSize - position ) );
+
+        for ( ma_uint32 i = 0; i < count; ++i )
+        {
+            const ma_uint32 f = frame + i;
+
+            // The spatializer does not pan the sound, so the channels only differ for stereo sounds.
+            input[position + i]   = 0.5f * ( in[f * 2 + 0] + in[f * 2 + 1] );
+            pFramesOut[f * 2 + 0] = output[( position + i ) * 2 + 0];
+            pFramesOut[f * 2 + 1] = output[( position + i ) * 2 + 1];
+        }
+
+        position += count;
+        frame += count;
+
+        if ( position == BlockSize )
+        {
+            processBlock();
+            position = 0;
+        }
+    }
+}
+
+void HrtfFilterImpl::processBlock()
+{
+    // Slide the input window by one block and add the spectrum of the window to the delay line.
+    std::copy( window.begin() + BlockSize, window.end(), window.begin() );
+    std::copy( input.begin(), input.end(), window.begin() + BlockSize );
+
+    fft.forward( window.data(), inputRe.data() + current * binCount, inputIm.data() + current * binCount );
+
+    const ma_vec3f newDirection = getDirection();
+    bool           fade         = false;
+
+    if ( !hasDirection )
+    {
+        setFilter( filters[active], newDirection );
+        direction    = newDirection;
+        hasDirection = true;
+    }
+    else if ( newDirection.x * direction.x + newDirection.y * direction.y + newDirection.z * direction.z < MinDirectionChange )
+    {
+        setFilter( filters[1 - active], newDirection );
+        direction = newDirection;
+        fade      = true;
+    }
+
+    for ( size_t ear = 0; ear < 2; ++ear )
+    {
+        convolve( filters[active], ear, block.data() );
+
+        if ( fade )
+        {
+            // Crossfade from the previous filter to the next filter over the block.
+            convolve( filters[1 - active], ear, faded.data() );
+
+            for ( size_t i = 0; i < BlockSize; ++i )
+            {
+                const float t = ( static_cast<float>( i ) + 0.5f ) / static_cast<float>( BlockSize );
+                block[i] += t * ( faded[i] - block[i] );
+            }
+        }
+
+        for ( size_t i = 0; i < BlockSize; ++i )
+            output[i * 2 + ear] = block[i];
+    }
+
+    if ( fade )
+        active = 1 - active;
+
+    current = ( current + 1 ) % partitionCount;
+}
+
+ma_vec3f HrtfFilterImpl::getDirection() const
+{
+    ma_vec3f relativePosition;
+
+    if ( ma_sound_get_positioning( sound ) == ma_positioning_relative )
+    {
+        relativePosition = ma_sound_get_position( sound );
+    }
+    else
+    {
+        const ma_uint32 listener = ma_sound_get_listener_index( sound );
+        ma_spatializer_get_relative_position_and_direction( &sound->engineNode.spatializer, &engine->listeners[listener], &relativePosition, nullptr );
+    }
+
+    const float length = std::sqrt( relativePosition.x * relativePosition.x + relativePosition.y * relativePosition.y + relativePosition.z * relativePosition.z );
+
+    // A sound on top of the listener is rendered in front of the listener.
+    if ( length < 1e-3f )
+        return { 0.0f, 0.0f, -1.0f };
+
+    return { relativePosition.x / length, relativePosition.y / length, relativePosition.z / length };
+}
+
+void HrtfFilterImpl::setFilter( Filter& filter, const ma_vec3f& dir )
+{
+    hrtf->interpolate( dir, hrir[0].data(), hrir[1].data() );
+
+    // Each partition is zero-padded to twice the block size.
+    for ( size_t ear = 0; ear < 2; ++ear )
+    {
+        for ( size_t p = 0; p < partitionCount; ++p )
+        {
+            std::fill( padded.begin(), padded.end(), 0.0f );
+            std::copy_n( hrir[ear].data() + p * BlockSize, std::min( BlockSize, hrtf->getLength() - p * BlockSize ), padded.begin() );
+
+            fft.forward( padded.data(), filter.re[ear].data() + p * binCount, filter.im[ear].data() + p * binCount );
+        }
+    }
+}
+
+void HrtfFilterImpl::convolve( const Filter& filter, size_t ear, float* out )
+{
+    std::fill( accRe.begin(), accRe.end(), 0.0f );
+    std::fill( accIm.begin(), accIm.end(), 0.0f );
+
+    // The newest input spectrum is multiplied with the first partition, the one before that with the second partition, etc...
+    size_t spectrum = current;
+    for ( size_t p = 0; p < partitionCount; ++p )
+    {
+        FFT::multiplyAccumulate( inputRe.data() + spectrum * binCount, inputIm.data() + spectrum * binCount,
+                                 filter.re[ear].data() + p * binCount, filter.im[ear].data() + p * binCount,
+                                 accRe.data(), accIm.data(), binCount );
+
+        spectrum = spectrum == 0 ? partitionCount - 1 : spectrum - 1;
+    }
+
+    fft.inverse( accRe.data(), accIm.data(), result.data() );
+
+    // The first half of the result is aliased (overlap-save), the second half is the output.
+    std::copy_n( result.begin() + BlockSize, BlockSize, out );
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "EffectImpl.hpp"
+#include "FFT.hpp"
+
+#include <vector>
+
+namespace Audio
+{
+class Hrtf;
+
+/// <summary>
+/// Per-voice binaural rendering: the (downmixed) output of a sound is convolved with the HRIRs
+/// for the direction of the sound. The filter is inserted between a sound and its bus, and the
+/// panning of the sound is disabled (the sound is still attenuated by its spatializer).
+/// </summary>
+/// <remarks>
+/// The convolution is uniformly partitioned (like `Convolver`), but the frequency-domain delay line
+/// of the input is shared by both ears and by the previous and the next filter. When the sound
+/// moves, the HRIRs are interpolated for the new direction, and the output of the previous and the
+/// next filter are crossfaded over one block.
+/// The filter adds one block of latency.
+/// </remarks>
+class HrtfFilterImpl : public CustomEffectImpl
+{
+public:
+    /// <summary>
+    /// Create an HRTF filter.
+    /// </summary>
+    /// <param name="device">The device that owns the engine.</param>
+    /// <param name="pEngine">The engine. The engine must have two output channels.</param>
+    /// <param name="hrtf">The HRIR set.</param>
+    /// <param name="pSound">The sound that is filtered (for its position relative to the listener).</param>
+    HrtfFilterImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, const Hrtf* hrtf, ma_sound* pSound );
+    ~HrtfFilterImpl() override;
+
+    const Hrtf* getHrtf() const noexcept
+    {
+        return hrtf;
+    }
+
+    // The number of frames that are convolved at a time.
+    static constexpr size_t BlockSize = 128;
+
+protected:
+    void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) override;
+
+private:
+    struct Filter
+    {
+        // The spectra of the partitions of the left and right ear HRIRs.
+        std::vector<float> re[2];
+        std::vector<float> im[2];
+    };
+
+    // Convolve a full block of input.
+    void processBlock();
+
+    // Get the direction of the sound in listener space.
+    ma_vec3f getDirection() const;
+
+    // Interpolate the HRIRs for a direction and compute their spectra.
+    void setFilter( Filter& filter, const ma_vec3f& direction );
+
+    // Convolve the delay line with one ear of a filter. Writes `BlockSize` samples.
+    void convolve( const Filter& filter, size_t ear, float* out );
+
+    const Hrtf* hrtf   = nullptr;
+    ma_engine*  engine = nullptr;
+    ma_sound*   sound  = nullptr;
+
+    size_t partitionCount = 0;
+    size_t binCount       = 0;
+    FFT    fft;
+
+    // The current filter and the filter that is faded in.
+    Filter filters[2];
+    size_t active = 0;
+
+    // The direction the active filter was computed for.
+    ma_vec3f direction {};
+    bool     hasDirection = false;
+
+    // Frequency-domain delay line of the input spectra.
+    std::vector<float> inputRe;
+    std::vector<float> inputIm;
+    size_t             current = 0;
+
+    // The last two blocks of input (overlap-save).
+    std::vector<float> window;
+
+    // The (mono) input of the current block and the (stereo) output of the previous block.
+    std::vector<float> input;
+    std::vector<float> output;
+    size_t             position = 0;
+
+    // Scratch buffers.
+    std::vector<float> hrir[2];
+    std::vector<float> padded;
+    std::vector<float> accRe;
+    std::vector<float> accIm;
+    std::vector<float> result;
+    std::vector<float> block;
+    std::vector<float> faded;
+};
+}  // namespace Audio
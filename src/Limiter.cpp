@@ -0,0 +1,40 @@
+#include <Audio/Device.hpp>
+#include <Audio/Limiter.hpp>
+
+#include "LimiterImpl.hpp"
+
+using namespace Audio;
+
+Limiter::Limiter( float threshold, float lookahead )
+{
+    *this = Device::createLimiter( threshold, lookahead );
+}
+
+Limiter::Limiter( std::shared_ptr<EffectImpl> impl )
+: Effect( std::move( impl ) )
+{}
+
+void Limiter::setThreshold( float threshold )
+{
+    std::static_pointer_cast<LimiterImpl>( get() )->setThreshold( threshold );
+}
+
+float Limiter::getThreshold() const
+{
+    return std::static_pointer_cast<LimiterImpl>( get() )->getThreshold();
+}
+
+void Limiter::setRelease( float release )
+{
+    std::static_pointer_cast<LimiterImpl>( get() )->setRelease( release );
+}
+
+float Limiter::getRelease() const
+{
+    return std::static_pointer_cast<LimiterImpl>( get() )->getRelease();
+}
+
+float Limiter::getLookahead() const
+{
+    return std::static_pointer_cast<LimiterImpl>( get() )->getLookahead();
+}
@@ -0,0 +1,124 @@
+#include "LimiterImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+LimiterImpl::LimiterImpl( std::shared_ptr<DeviceImpl> device, float _threshold, float _lookahead, ma_engine* pEngine )
+: CustomEffectImpl( std::move( device ), pEngine )
+, threshold { _threshold }
+{
+    if ( !isInitialized() )
+        return;
+
+    lookahead = std::max<size_t>( static_cast<size_t>( std::clamp( _lookahead, 0.001f, 0.05f ) * static_cast<float>( sampleRate ) ), 1 );
+
+    delayLine.resize( lookahead * channels );
+    minGain.resize( lookahead );
+    minFrame.resize( lookahead );
+    average.resize( lookahead, 1.0f );
+    averageSum = static_cast<double>( lookahead );
+}
+
+LimiterImpl::~LimiterImpl()
+{
+    uninit();
+}
+
+void LimiterImpl::setThreshold( float _threshold ) noexcept
+{
+    threshold.store( _threshold, std::memory_order_relaxed );
+}
+
+float LimiterImpl::getThreshold() const noexcept
+{
+    return threshold.load( std::memory_order_relaxed );
+}
+
+void LimiterImpl::setRelease( float _release ) noexcept
+{
+    release.store( std::max( _release, 0.0f ), std::memory_order_relaxed );
+}
+
+float LimiterImpl::getRelease() const noexcept
+{
+    return release.load( std::memory_order_relaxed );
+}
+
+float LimiterImpl::getLookahead() const noexcept
+{
+    return sampleRate > 0 ? static_cast<float>( lookahead ) / static_cast<float>( sampleRate ) : 0.0f;
+}
+
+void LimiterImpl::process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount )
+{
+    const float* in = ppFramesIn[0];
+
+    for ( ma_uint32 f = 0; f < frameCount; f += blockSize )
+    {
+        const ma_uint32 count = std::min( blockSize, frameCount - f );
+        processBlock( in + f * channels, pFramesOut + f * channels, count );
+    }
+}
+
+void LimiterImpl::processBlock( const float* in, float* out, ma_uint32 frameCount )
+{
+    const float ceiling     = std::pow( 10.0f, threshold.load( std::memory_order_relaxed ) * 0.05f );
+    const float releaseTime = release.load( std::memory_order_relaxed );
+    const float releaseRate = releaseTime > 0.0f ? 1.0f - std::exp( -1.0f / ( releaseTime * static_cast<float>( sampleRate ) ) ) : 1.0f;
+    const double scale      = 1.0 / static_cast<double>( lookahead );
+
+    // Detector: the gain that is required to keep each frame below the ceiling.
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        float peak = 0.0f;
+        for ( ma_uint32 c = 0; c < channels; ++c )
+            peak = std::max( peak, std::abs( in[f * channels + c] ) );
+
+        blockGain[f] = peak > ceiling ? ceiling / peak : 1.0f;
+    }
+
+    // Envelope: minimum over the lookahead window, release smoothing, and a moving average over the lookahead window.
+    for ( ma_uint32 f = 0; f < frameCount; ++f, ++frame )
+    {
+        const float g = blockGain[f];
+
+        if ( minCount > 0 && frame - minFrame[minFront] >= lookahead )
+        {
+            minFront = ( minFront + 1 ) % lookahead;
+            --minCount;
+        }
+
+        while ( minCount > 0 && minGain[( minFront + minCount - 1 ) % lookahead] >= g )
+            --minCount;
+
+        const size_t back = ( minFront + minCount ) % lookahead;
+        minGain[back]     = g;
+        minFrame[back]    = frame;
+        ++minCount;
+
+        // Instant attack, exponential release.
+        gain = std::min( minGain[minFront], gain + ( 1.0f - gain ) * releaseRate );
+
+        averageSum += gain - average[averagePos];
+        average[averagePos] = gain;
+        averagePos          = ( averagePos + 1 ) % lookahead;
+
+        blockGain[f] = std::min( static_cast<float>( averageSum * scale ), 1.0f );
+    }
+
+    // Apply the gain to the input that was delayed by (lookahead - 1) frames.
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        float* write = delayLine.data() + delayPos * channels;
+        delayPos     = ( delayPos + 1 ) % lookahead;
+        float* read  = delayLine.data() + delayPos * channels;
+
+        for ( ma_uint32 c = 0; c < channels; ++c )
+            write[c] = in[f * channels + c];
+
+        for ( ma_uint32 c = 0; c < channels; ++c )
+            out[f * channels + c] = read[c] * blockGain[f];
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "EffectImpl.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace Audio
+{
+class LimiterImpl : public CustomEffectImpl
+{
+public:
+    LimiterImpl( std::shared_ptr<DeviceImpl> device, float threshold, float lookahead, ma_engine* pEngine );
+    ~LimiterImpl() override;
+
+    void  setThreshold( float threshold ) noexcept;
+    float getThreshold() const noexcept;
+
+    void  setRelease( float release ) noexcept;
+    float getRelease() const noexcept;
+
+    float getLookahead() const noexcept;
+
+protected:
+    void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) override;
+
+private:
+    // Frames are processed in blocks so the detector and gain stages run as simple (vectorizable) loops.
+    static constexpr ma_uint32 blockSize = 256;
+
+    void processBlock( const float* in, float* out, ma_uint32 frameCount );
+
+    std::atomic<float> threshold;
+    std::atomic<float> release { 0.1f };
+
+    // The lookahead (in frames).
+    size_t lookahead = 1;
+
+    // The delayed input (lookahead frames).
+    std::vector<float> delayLine;
+    size_t             delayPos = 0;
+
+    // Monotonic queue for the minimum gain over the lookahead window.
+    std::vector<float>    minGain;
+    std::vector<uint64_t> minFrame;
+    size_t                minFront = 0;
+    size_t                minCount = 0;
+    uint64_t              frame    = 0;
+
+    // Moving average of the gain over the lookahead window, so the gain reaches
+    // the minimum exactly when the peak leaves the delay line.
+    std::vector<float> average;
+    size_t             averagePos = 0;
+    double             averageSum = 0.0;
+
+    // The gain after release smoothing.
+    float gain = 1.0f;
+
+    // Scratch buffer for the gain of each frame in a block.
+    float blockGain[blockSize] {};
+};
+}  // namespace Audio
@@ -39,6 +39,21 @@ Vector Listener::getPosition() const
     return impl->getPosition();
 }
 
+void Listener::setPosition( const Vector& pos, double seconds )
+{
+    impl->setPosition( pos, seconds );
+}
+
+void Listener::setVelocity( const Vector& vel )
+{
+    impl->setVelocity( vel );
+}
+
+Vector Listener::getVelocity() const
+{
+    return impl->getVelocity();
+}
+
 void Listener::setDirection( const Vector& dir )
 {
     impl->setDirection( dir );
@@ -1,10 +1,33 @@
 #include "ListenerImpl.hpp"
+#include "VelocityTracker.hpp"
 
 using namespace Audio;
 
+namespace
+{
+// Listener objects are created on demand, so the previous timestamped position is kept per listener index.
+VelocityTracker& GetVelocityTracker( uint32_t index )
+{
+    static VelocityTracker trackers[MA_ENGINE_MAX_LISTENERS];
+    return trackers[index];
+}
+}  // namespace
+
 void ListenerImpl::setPosition( const Vector& pos )
 {
     ma_engine_listener_set_position( engine, index, pos.x, pos.y, pos.z );
+
+    GetVelocityTracker( index ).reset();
+}
+
+void ListenerImpl::setPosition( const Vector& pos, double time )
+{
+    ma_vec3f velocity;
+    if ( !GetVelocityTracker( index ).update( { pos.x, pos.y, pos.z }, time, velocity ) )
+        return;
+
+    ma_engine_listener_set_position( engine, index, pos.x, pos.y, pos.z );
+    ma_engine_listener_set_velocity( engine, index, velocity.x, velocity.y, velocity.z );
 }
 
 Vector ListenerImpl::getPosition() const
@@ -13,6 +36,17 @@ Vector ListenerImpl::getPosition() const
     return { pos.x, pos.y, pos.z };
 }
 
+void ListenerImpl::setVelocity( const Vector& vel )
+{
+    ma_engine_listener_set_velocity( engine, index, vel.x, vel.y, vel.z );
+}
+
+Vector ListenerImpl::getVelocity() const
+{
+    auto vel = ma_engine_listener_get_velocity( engine, index );
+    return { vel.x, vel.y, vel.z };
+}
+
 void ListenerImpl::setDirection( const Vector& dir )
 {
     ma_engine_listener_set_direction( engine, index, dir.x, dir.y, dir.z );
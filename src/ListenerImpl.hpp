@@ -22,8 +22,12 @@ public:
     ~ListenerImpl() = default;
 
     void   setPosition( const Vector& pos );
+    void   setPosition( const Vector& pos, double time );
     Vector getPosition() const;
 
+    void   setVelocity( const Vector& vel );
+    Vector getVelocity() const;
+
     void   setDirection( const Vector& dir );
     Vector getDirection() const;
 
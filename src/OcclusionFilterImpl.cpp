@@ -0,0 +1,104 @@
+#include "OcclusionFilterImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+// The cutoff frequency (in Hz) of the low-pass filter for a fully occluded (or obstructed) sound.
+static constexpr float MinCutoff = 300.0f;
+// The attenuation (in dB) of a fully occluded sound.
+static constexpr float OcclusionGainDB = -18.0f;
+// The attenuation (in dB) of a fully obstructed sound.
+static constexpr float ObstructionGainDB = -6.0f;
+
+static constexpr float Pi = 3.14159265358979323846f;
+
+static uint32_t Pack( float occlusion, float obstruction ) noexcept
+{
+    const auto occ = static_cast<uint32_t>( std::clamp( occlusion, 0.0f, 1.0f ) * 65535.0f + 0.5f );
+    const auto obs = static_cast<uint32_t>( std::clamp( obstruction, 0.0f, 1.0f ) * 65535.0f + 0.5f );
+    return occ | ( obs << 16 );
+}
+
+OcclusionFilterImpl::OcclusionFilterImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine )
+: CustomEffectImpl( std::move( device ), pEngine )
+{
+    if ( !isInitialized() )
+        return;
+
+    minCoefficient = 1.0f - std::exp( -2.0f * Pi * MinCutoff / static_cast<float>( sampleRate ) );
+    state.resize( channels );
+}
+
+OcclusionFilterImpl::~OcclusionFilterImpl()
+{
+    uninit();
+}
+
+void OcclusionFilterImpl::setOcclusion( float occlusion, float obstruction ) noexcept
+{
+    parameters.store( Pack( occlusion, obstruction ), std::memory_order_relaxed );
+}
+
+float OcclusionFilterImpl::getOcclusion() const noexcept
+{
+    return static_cast<float>( parameters.load( std::memory_order_relaxed ) & 0xffff ) / 65535.0f;
+}
+
+float OcclusionFilterImpl::getObstruction() const noexcept
+{
+    return static_cast<float>( parameters.load( std::memory_order_relaxed ) >> 16 ) / 65535.0f;
+}
+
+void OcclusionFilterImpl::process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount )
+{
+    const uint32_t p = parameters.load( std::memory_order_relaxed );
+    if ( p != currentParameters )
+    {
+        const float occlusion   = static_cast<float>( p & 0xffff ) / 65535.0f;
+        const float obstruction = static_cast<float>( p >> 16 ) / 65535.0f;
+
+        // Interpolating the coefficient exponentially sweeps the cutoff frequency from
+        // (almost) the Nyquist frequency to the minimum cutoff frequency.
+        targetCoefficient = std::pow( minCoefficient, std::max( occlusion, obstruction ) );
+        targetGain        = std::pow( 10.0f, ( OcclusionGainDB * occlusion + ObstructionGainDB * obstruction ) * 0.05f );
+        currentParameters = p;
+    }
+
+    const float* in = ppFramesIn[0];
+
+    // Fast path: no filtering and no gain.
+    if ( coefficient == 1.0f && targetCoefficient == 1.0f && gain == 1.0f && targetGain == 1.0f )
+    {
+        std::copy_n( in, frameCount * channels, pFramesOut );
+
+        // Keep the filter state in sync with the input, so enabling the filter again does not click.
+        if ( frameCount > 0 )
+            std::copy_n( in + ( frameCount - 1 ) * channels, channels, state.data() );
+
+        return;
+    }
+
+    const float step       = frameCount > 0 ? 1.0f / static_cast<float>( frameCount ) : 0.0f;
+    const float deltaCoeff = ( targetCoefficient - coefficient ) * step;
+    const float deltaGain  = ( targetGain - gain ) * step;
+    float       a          = coefficient;
+    float       g          = gain;
+
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        a += deltaCoeff;
+        g += deltaGain;
+
+        for ( ma_uint32 c = 0; c < channels; ++c )
+        {
+            float& y = state[c];
+            y += a * ( in[f * channels + c] - y );
+            pFramesOut[f * channels + c] = y * g;
+        }
+    }
+
+    coefficient = targetCoefficient;
+    gain        = targetGain;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "EffectImpl.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// Per-voice occlusion and obstruction: a one-pole low-pass filter and a gain
+/// that are inserted between a sound and its bus.
+/// </summary>
+class OcclusionFilterImpl : public CustomEffectImpl
+{
+public:
+    OcclusionFilterImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine );
+    ~OcclusionFilterImpl() override;
+
+    /// <summary>
+    /// Set the occlusion and obstruction (both in the range [0 .. 1]).
+    /// This is a single atomic store, so it is cheap to call for many voices every frame.
+    /// </summary>
+    void setOcclusion( float occlusion, float obstruction ) noexcept;
+
+    float getOcclusion() const noexcept;
+    float getObstruction() const noexcept;
+
+protected:
+    void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) override;
+
+private:
+    // Occlusion (low 16 bits) and obstruction (high 16 bits) in 16-bit fixed point.
+    std::atomic<uint32_t> parameters { 0 };
+
+    // The parameters that the current targets were computed for.
+    uint32_t currentParameters = 0;
+
+    // The filter coefficient for full occlusion (300 Hz cutoff).
+    float minCoefficient = 1.0f;
+
+    // Current and target filter coefficient and gain. The current values are ramped
+    // to the target values over one block to avoid zipper noise.
+    float coefficient       = 1.0f;
+    float gain              = 1.0f;
+    float targetCoefficient = 1.0f;
+    float targetGain        = 1.0f;
+
+    // The filter state for each channel.
+    std::vector<float> state;
+};
+}  // namespace Audio
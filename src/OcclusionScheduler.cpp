@@ -0,0 +1,181 @@
+#include "OcclusionScheduler.hpp"
+#include "EmitterGrid.hpp"
+#include "SoundImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+// The smoothed occlusion is only applied to the sound when it changes by more than this.
+static constexpr float MinChange = 0.001f;
+
+namespace
+{
+// The sources are shared by the game thread and the worker thread.
+std::mutex& GetMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<OcclusionQuerySource*>& GetSources()
+{
+    static std::vector<OcclusionQuerySource*> sources;
+    return sources;
+}
+}  // namespace
+
+OcclusionQuerySource::OcclusionQuerySource( SoundImpl* sound )
+: sound { sound }
+, state { std::make_shared<State>() }
+{
+    std::lock_guard lock { GetMutex() };
+    GetSources().push_back( this );
+}
+
+OcclusionQuerySource::~OcclusionQuerySource()
+{
+    std::lock_guard lock { GetMutex() };
+
+    auto&      sources = GetSources();
+    const auto iter    = std::find( sources.begin(), sources.end(), this );
+    if ( iter != sources.end() )
+        sources.erase( iter );
+}
+
+OcclusionScheduler::~OcclusionScheduler()
+{
+    stop();
+}
+
+void OcclusionScheduler::setCallback( Device::OcclusionCallback _callback, float _maxRate, float _minRate )
+{
+    // The callback is only used by the worker thread.
+    stop();
+
+    callback = std::move( _callback );
+    maxRate  = std::max( _maxRate, 0.01f );
+    minRate  = std::clamp( _minRate, 0.01f, maxRate );
+
+    if ( callback )
+        start();
+}
+
+void OcclusionScheduler::start()
+{
+    ma_event_init( &event );
+    quit   = false;
+    busy   = false;
+    thread = std::thread( &OcclusionScheduler::run, this );
+}
+
+void OcclusionScheduler::stop()
+{
+    if ( !thread.joinable() )
+        return;
+
+    quit = true;
+    ma_event_signal( &event );
+    thread.join();
+    ma_event_uninit( &event );
+}
+
+void OcclusionScheduler::update()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto dt  = updated ? std::chrono::duration<float>( now - lastUpdate ).count() : 0.0f;
+    lastUpdate     = now;
+    updated        = true;
+
+    const double time  = std::chrono::duration<double>( now.time_since_epoch() ).count();
+    const float  blend = 1.0f - std::exp( -dt / SmoothingTime );
+
+    // A new batch is only started when the worker thread is done with the previous batch.
+    const bool schedule = thread.joinable() && !busy.load( std::memory_order_acquire );
+    if ( schedule )
+    {
+        queries.clear();
+        states.clear();
+    }
+
+    std::lock_guard lock { GetMutex() };
+
+    for ( OcclusionQuerySource* source: GetSources() )
+    {
+        SoundImpl* sound = source->sound;
+
+        // Smooth the occlusion towards the result of the last query (the first result is applied immediately).
+        if ( const auto& state = *source->state; state.valid )
+        {
+            const float occlusion   = source->smoothed ? source->occlusion + ( state.occlusion - source->occlusion ) * blend : state.occlusion;
+            const float obstruction = source->smoothed ? source->obstruction + ( state.obstruction - source->obstruction ) * blend : state.obstruction;
+
+            if ( !source->smoothed || std::abs( occlusion - source->occlusion ) > MinChange || std::abs( obstruction - source->obstruction ) > MinChange )
+            {
+                source->smoothed    = true;
+                source->occlusion   = occlusion;
+                source->obstruction = obstruction;
+                sound->setOcclusion( occlusion, obstruction );
+            }
+        }
+
+        if ( !schedule || time < source->nextQuery || !sound->isPlaying() )
+            continue;
+
+        // Sounds that are positioned relative to the listener are not occluded.
+        const ma_sound* s = sound->getSound();
+        if ( ma_sound_get_positioning( s ) == ma_positioning_relative )
+            continue;
+
+        const ma_vec3f listener = ma_engine_listener_get_position( ma_sound_get_engine( s ), ma_sound_get_listener_index( s ) );
+        const Vector   emitter  = sound->getPosition();
+
+        const float x        = emitter.x - listener.x;
+        const float y        = emitter.y - listener.y;
+        const float z        = emitter.z - listener.z;
+        const float distance = std::sqrt( x * x + y * y + z * z );
+
+        // Louder sounds are queried more often.
+        const float rate  = std::clamp( maxRate * EmitterGrid::estimateGain( sound, distance ), minRate, maxRate );
+        source->nextQuery = time + 1.0 / rate;
+
+        queries.push_back( { { listener.x, listener.y, listener.z }, emitter, source->state->occlusion, source->state->obstruction } );
+        states.push_back( source->state );
+    }
+
+    if ( schedule && !queries.empty() )
+    {
+        busy.store( true, std::memory_order_release );
+        ma_event_signal( &event );
+    }
+}
+
+void OcclusionScheduler::run()
+{
+    while ( true )
+    {
+        ma_event_wait( &event );
+
+        if ( quit )
+            break;
+
+        if ( !busy.load( std::memory_order_acquire ) )
+            continue;
+
+        callback( queries.data(), queries.size() );
+
+        {
+            std::lock_guard lock { GetMutex() };
+
+            for ( size_t i = 0; i < queries.size(); ++i )
+            {
+                states[i]->valid       = true;
+                states[i]->occlusion   = std::clamp( queries[i].occlusion, 0.0f, 1.0f );
+                states[i]->obstruction = std::clamp( queries[i].obstruction, 0.0f, 1.0f );
+            }
+        }
+
+        busy.store( false, std::memory_order_release );
+    }
+}
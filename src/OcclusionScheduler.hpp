@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Audio/Device.hpp>
+
+#include "miniaudio.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Audio
+{
+class SoundImpl;
+
+/// <summary>
+/// The occlusion of a sound that is queried with the occlusion callback (see `Device::setOcclusionCallback`).
+/// </summary>
+class OcclusionQuerySource
+{
+public:
+    explicit OcclusionQuerySource( SoundImpl* sound );
+    ~OcclusionQuerySource();
+
+    // The result of the last query (written by the worker thread, under the mutex of all sources),
+    // so the worker thread can publish the result of a sound that was destroyed in the meantime.
+    struct State
+    {
+        bool  valid       = false;
+        float occlusion   = 0.0f;
+        float obstruction = 0.0f;
+    };
+
+    OcclusionQuerySource( const OcclusionQuerySource& )            = delete;
+    OcclusionQuerySource( OcclusionQuerySource&& )                 = delete;
+    OcclusionQuerySource& operator=( const OcclusionQuerySource& ) = delete;
+    OcclusionQuerySource& operator=( OcclusionQuerySource&& )      = delete;
+
+private:
+    friend class OcclusionScheduler;
+
+    SoundImpl*             sound = nullptr;
+    std::shared_ptr<State> state;
+
+    // Only used by the game thread: the smoothed occlusion (that is applied to the sound),
+    // and the time (in seconds) of the next query.
+    bool   smoothed    = false;
+    float  occlusion   = 0.0f;
+    float  obstruction = 0.0f;
+    double nextQuery   = 0.0;
+};
+
+/// <summary>
+/// Runs the occlusion queries of the sounds on a worker thread.
+/// </summary>
+/// <remarks>
+/// Every update (in `Device::update`) starts a new batch of queries if the worker thread is idle. Each sound is
+/// queried at a rate between the minimum and the maximum rate, in proportion to its estimated loudness (so near
+/// and loud sounds are queried more often). The results are smoothed on the game thread and applied with
+/// `SoundImpl::setOcclusion`.
+/// </remarks>
+class OcclusionScheduler
+{
+public:
+    static OcclusionScheduler& get()
+    {
+        static OcclusionScheduler scheduler;
+        return scheduler;
+    }
+
+    ~OcclusionScheduler();
+
+    /// <summary>
+    /// Set the callback (or `nullptr` to stop the queries), and the range of the query rate (in queries per second).
+    /// </summary>
+    void setCallback( Device::OcclusionCallback callback, float maxRate, float minRate );
+
+    /// <summary>
+    /// Start the next batch of queries, and apply the smoothed results (on the game thread).
+    /// </summary>
+    void update();
+
+    // The time constant (in seconds) of the smoothing of the results.
+    static constexpr float SmoothingTime = 0.1f;
+
+private:
+    OcclusionScheduler() = default;
+
+    void start();
+    void stop();
+    void run();
+
+    std::thread       thread;
+    ma_event          event {};
+    std::atomic<bool> busy { false };
+    std::atomic<bool> quit { false };
+
+    // Only replaced while the worker thread is stopped.
+    Device::OcclusionCallback callback;
+    float                     maxRate = 30.0f;
+    float                     minRate = 2.0f;
+
+    // Only used by the game thread.
+    bool                                  updated = false;
+    std::chrono::steady_clock::time_point lastUpdate;
+
+    // The batch (written by the game thread while the worker thread is idle).
+    std::vector<Device::OcclusionQuery>                        queries;
+    std::vector<std::shared_ptr<OcclusionQuerySource::State>> states;
+};
+}  // namespace Audio
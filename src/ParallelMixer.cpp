@@ -0,0 +1,254 @@
+#include "ParallelMixer.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#if defined( _WIN32 )
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+using namespace Audio;
+
+// Raise the priority of the current thread to match the audio thread (if the OS allows it).
+static void SetRealtimePriority()
+{
+#if defined( _WIN32 )
+    SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL );
+#else
+    sched_param param {};
+    param.sched_priority = sched_get_priority_max( SCHED_FIFO ) - 1;
+    // This fails without the required privileges. In that case, the worker runs at normal priority.
+    pthread_setschedparam( pthread_self(), SCHED_FIFO, &param );
+#endif
+}
+
+ParallelSubmix::ParallelSubmix( ma_engine* pEngine )
+{
+    channels = ma_engine_get_channels( pEngine );
+
+    const ma_node_graph_config graphConfig = ma_node_graph_config_init( channels );
+    if ( ma_node_graph_init( &graphConfig, nullptr, &graph ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize parallel submix." << std::endl;
+        return;
+    }
+
+    vtable.onProcess      = &ParallelSubmix::onProcess;
+    vtable.inputBusCount  = 0;
+    vtable.outputBusCount = 1;
+
+    ma_node_config config  = ma_node_config_init();
+    config.vtable          = &vtable;
+    config.pOutputChannels = &channels;
+
+    source.submix = this;
+
+    if ( ma_node_init( ma_engine_get_node_graph( pEngine ), &config, nullptr, &source.base ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize parallel submix." << std::endl;
+        ma_node_graph_uninit( &graph, nullptr );
+        return;
+    }
+
+    buffer.resize( static_cast<size_t>( ParallelMixer::maxFrameCount ) * channels );
+    initialized = true;
+}
+
+ParallelSubmix::~ParallelSubmix()
+{
+    if ( initialized )
+    {
+        ma_node_uninit( &source.base, nullptr );
+        ma_node_graph_uninit( &graph, nullptr );
+    }
+}
+
+void ParallelSubmix::prepare( uint64_t _period, ma_uint64 _time, ma_uint32 _frameCount ) noexcept
+{
+    period     = _period;
+    time       = _time;
+    frameCount = _frameCount;
+    cursor     = 0;
+}
+
+void ParallelSubmix::render() noexcept
+{
+    if ( renderedPeriod.load( std::memory_order_acquire ) == period )
+        return;
+
+    uint64_t claimed = claimedPeriod.load( std::memory_order_relaxed );
+    if ( claimed != period && claimedPeriod.compare_exchange_strong( claimed, period, std::memory_order_acq_rel ) )
+    {
+        // Keep the time of the private graph in sync with the engine, so scheduled sounds start on time.
+        ma_node_graph_set_time( &graph, time );
+        ma_node_graph_read_pcm_frames( &graph, buffer.data(), frameCount, nullptr );
+        renderedPeriod.store( period, std::memory_order_release );
+        return;
+    }
+
+    // Another thread is rendering this submix.
+    while ( renderedPeriod.load( std::memory_order_acquire ) != period )
+        std::this_thread::yield();
+}
+
+void ParallelSubmix::onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut )
+{
+    (void)ppFramesIn;
+    (void)pFrameCountIn;
+
+    auto* submix = static_cast<Node*>( pNode )->submix;
+
+    // Normally, the submix was rendered by the mixer before the engine reads the node graph.
+    // A nested submix may be pulled by the submix it is part of before a worker got to it.
+    submix->render();
+
+    const ma_uint32 channels = submix->channels;
+    const ma_uint32 count    = std::min( *pFrameCountOut, submix->frameCount - submix->cursor );
+
+    std::copy_n( submix->buffer.data() + static_cast<size_t>( submix->cursor ) * channels, static_cast<size_t>( count ) * channels, ppFramesOut[0] );
+    std::fill_n( ppFramesOut[0] + static_cast<size_t>( count ) * channels, static_cast<size_t>( *pFrameCountOut - count ) * channels, 0.0f );
+
+    submix->cursor += count;
+}
+
+ParallelMixer::ParallelMixer( RenderEpoch& epoch )
+: submixes { epoch }
+{}
+
+ParallelMixer::~ParallelMixer()
+{
+    quit.store( true );
+
+    for ( size_t i = 0; i < workers.size(); ++i )
+    {
+        ma_event_signal( &wakeEvents[i] );
+        workers[i].join();
+        ma_event_uninit( &wakeEvents[i] );
+    }
+}
+
+void ParallelMixer::add( ParallelSubmix* submix )
+{
+    if ( !submix || !submix->isInitialized() )
+        return;
+
+    // Threads are only started once they are needed (and never on the audio thread).
+    // The audio thread only uses the threads once it sees the list with the submix.
+    if ( !queues )
+        startWorkers();
+
+    submixes.add( submix );
+}
+
+void ParallelMixer::remove( ParallelSubmix* submix )
+{
+    // Waits for the current period, so the submix can be destroyed.
+    submixes.remove( submix );
+}
+
+void ParallelMixer::startWorkers()
+{
+    // The audio thread is one of the threads that renders the submixes.
+    const size_t hardwareThreads = std::max( std::thread::hardware_concurrency(), 1u );
+    threadCount                  = hardwareThreads;
+
+    queues     = std::make_unique<Queue[]>( threadCount );
+    wakeEvents = std::make_unique<ma_event[]>( threadCount - 1 );
+
+    for ( size_t i = 1; i < threadCount; ++i )
+    {
+        if ( ma_event_init( &wakeEvents[i - 1] ) != MA_SUCCESS )
+        {
+            std::cerr << "Failed to initialize mixer thread." << std::endl;
+            threadCount = i;
+            break;
+        }
+
+        workers.emplace_back( &ParallelMixer::workerThread, this, i );
+    }
+}
+
+void ParallelMixer::workerThread( size_t index )
+{
+    SetRealtimePriority();
+
+    while ( true )
+    {
+        ma_event_wait( &wakeEvents[index - 1] );
+
+        if ( quit.load() )
+            break;
+
+        runQueues( index );
+    }
+}
+
+void ParallelMixer::runQueues( size_t index ) noexcept
+{
+    const uint64_t current = periodTasks.load( std::memory_order_acquire );
+    const uint64_t gen     = current >> 32;
+    const uint64_t count   = current & 0xffffffff;
+
+    // Start with the own queue, then steal from the others.
+    for ( size_t k = 0; k < threadCount; ++k )
+    {
+        const size_t q     = ( index + k ) % threadCount;
+        uint64_t     state = queues[q].state.load( std::memory_order_acquire );
+
+        while ( true )
+        {
+            // The queue belongs to another period (it was not reset yet, or this worker woke up too late).
+            if ( ( state >> 32 ) != gen )
+                break;
+
+            const uint64_t task = q + ( state & 0xffffffff ) * threadCount;
+            if ( task >= count )
+                break;
+
+            if ( !queues[q].state.compare_exchange_weak( state, state + 1, std::memory_order_acq_rel ) )
+                continue;
+
+            ( *tasks )[task]->render();
+            remaining.fetch_sub( 1, std::memory_order_acq_rel );
+
+            state = queues[q].state.load( std::memory_order_acquire );
+        }
+    }
+}
+
+void ParallelMixer::render( ma_uint64 time, ma_uint32 frameCount )
+{
+    const auto& current = submixes.acquire();
+    if ( current.empty() )
+        return;
+
+    // The workers see the list of the period once they see the period.
+    tasks = &current;
+
+    ++period;
+    for ( auto* submix: current )
+        submix->prepare( period, time, frameCount );
+
+    const uint64_t taskCount = current.size();
+    const uint64_t gen       = period & 0xffffffff;
+
+    remaining.store( taskCount, std::memory_order_release );
+    periodTasks.store( ( gen << 32 ) | taskCount, std::memory_order_release );
+
+    for ( size_t q = 0; q < threadCount; ++q )
+        queues[q].state.store( gen << 32, std::memory_order_release );
+
+    const size_t wake = std::min<size_t>( threadCount, taskCount ) - 1;
+    for ( size_t i = 0; i < wake; ++i )
+        ma_event_signal( &wakeEvents[i] );
+
+    runQueues( 0 );
+
+    // Join: wait for the submixes that are rendered by the workers.
+    while ( remaining.load( std::memory_order_acquire ) > 0 )
+        std::this_thread::yield();
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Realtime.hpp"
+
+#include "miniaudio.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// A part of the node graph that is rendered on a worker thread.
+/// The input node is the endpoint of a private node graph: everything that is attached to it is
+/// only pulled by the worker. The output node plays back the rendered audio in the engine's node graph.
+/// </summary>
+class ParallelSubmix
+{
+public:
+    explicit ParallelSubmix( ma_engine* pEngine );
+    ~ParallelSubmix();
+
+    ma_node* getInputNode() noexcept
+    {
+        return ma_node_graph_get_endpoint( &graph );
+    }
+
+    ma_node* getOutputNode() noexcept
+    {
+        return &source.base;
+    }
+
+    bool isInitialized() const noexcept
+    {
+        return initialized;
+    }
+
+    ParallelSubmix( const ParallelSubmix& )            = delete;
+    ParallelSubmix( ParallelSubmix&& )                 = delete;
+    ParallelSubmix& operator=( const ParallelSubmix& ) = delete;
+    ParallelSubmix& operator=( ParallelSubmix&& )      = delete;
+
+private:
+    friend class ParallelMixer;
+
+    // Prepare the submix for the next period (called by the mixer).
+    void prepare( uint64_t period, ma_uint64 time, ma_uint32 frameCount ) noexcept;
+
+    // Render the submix for the current period (unless it was already rendered).
+    // If another thread is rendering the submix, wait for it to finish.
+    void render() noexcept;
+
+    static void onProcess( ma_node* pNode, const float** ppFramesIn, ma_uint32* pFrameCountIn, float** ppFramesOut, ma_uint32* pFrameCountOut );
+
+    struct Node
+    {
+        ma_node_base    base;
+        ParallelSubmix* submix;
+    };
+
+    ma_node_graph      graph {};
+    ma_node_vtable     vtable {};
+    Node               source {};
+    ma_uint32          channels = 0;
+    std::vector<float> buffer;
+    bool               initialized = false;
+
+    // The current period (written by the mixer before the workers are started).
+    uint64_t  period     = 0;
+    ma_uint64 time       = 0;
+    ma_uint32 frameCount = 0;
+    ma_uint32 cursor     = 0;
+
+    std::atomic<uint64_t> claimedPeriod { 0 };
+    std::atomic<uint64_t> renderedPeriod { 0 };
+};
+
+/// <summary>
+/// Renders the parallel submixes on a pool of worker threads.
+/// The device callback calls `render` before the engine reads its node graph.
+/// The submixes are added and removed by the game thread, and read by the audio thread without a lock.
+/// </summary>
+class ParallelMixer
+{
+public:
+    // The maximum number of frames that is rendered at once.
+    static constexpr ma_uint32 maxFrameCount = 4096;
+
+    explicit ParallelMixer( RenderEpoch& epoch );
+    ~ParallelMixer();
+
+    void add( ParallelSubmix* submix );
+    void remove( ParallelSubmix* submix );
+
+    /// <summary>
+    /// Render all submixes (on the audio thread).
+    /// </summary>
+    /// <param name="time">The current time of the engine (in frames).</param>
+    /// <param name="frameCount">The number of frames to render (at most maxFrameCount).</param>
+    void render( ma_uint64 time, ma_uint32 frameCount );
+
+    ParallelMixer( const ParallelMixer& )            = delete;
+    ParallelMixer( ParallelMixer&& )                 = delete;
+    ParallelMixer& operator=( const ParallelMixer& ) = delete;
+    ParallelMixer& operator=( ParallelMixer&& )      = delete;
+
+private:
+    // Each thread (the audio thread is thread 0) owns a queue of submixes: submix i belongs to queue (i % threadCount).
+    // A thread renders the submixes in its own queue first, then steals from the other queues.
+    // The state of a queue is the period (high 32 bits) and the index of the next task in the queue (low 32 bits),
+    // so a worker that wakes up late can never claim a task from another period.
+    struct alignas( 64 ) Queue
+    {
+        std::atomic<uint64_t> state { 0 };
+    };
+
+    void startWorkers();
+    void workerThread( size_t index );
+    void runQueues( size_t index ) noexcept;
+
+    // The submixes (an immutable list that is replaced by the game thread), and the list that is rendered in
+    // the current period (only used by the audio thread, and by the workers while they render the period).
+    RealtimeList<ParallelSubmix*>       submixes;
+    const std::vector<ParallelSubmix*>* tasks  = nullptr;
+    uint64_t                            period = 0;
+
+    // The current period (high 32 bits) and the number of tasks in the period (low 32 bits).
+    std::atomic<uint64_t> periodTasks { 0 };
+
+    std::vector<std::thread>    workers;
+    std::unique_ptr<ma_event[]> wakeEvents;
+    std::unique_ptr<Queue[]>    queues;
+    size_t                      threadCount = 1;
+    std::atomic<size_t>         remaining { 0 };
+    std::atomic<bool>           quit { false };
+};
+}  // namespace Audio
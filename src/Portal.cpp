@@ -0,0 +1,62 @@
+#include <Audio/Portal.hpp>
+
+#include "PortalImpl.hpp"
+
+using namespace Audio;
+
+Portal::Portal( std::shared_ptr<PortalImpl> impl )
+: impl { std::move( impl ) }
+{}
+
+Portal::Portal()                               = default;
+Portal::~Portal()                              = default;
+Portal::Portal( const Portal& )                = default;
+Portal::Portal( Portal&& ) noexcept            = default;
+Portal& Portal::operator=( const Portal& )     = default;
+Portal& Portal::operator=( Portal&& ) noexcept = default;
+
+Portal& Portal::operator=( nullptr_t ) noexcept
+{
+    impl = nullptr;
+    return *this;
+}
+
+bool Portal::operator==( nullptr_t ) const noexcept
+{
+    return impl == nullptr;
+}
+
+bool Portal::operator!=( nullptr_t ) const noexcept
+{
+    return impl != nullptr;
+}
+
+void Portal::setBox( const Vector& center, const Vector& halfExtents )
+{
+    impl->setBox( { center.x, center.y, center.z }, { halfExtents.x, halfExtents.y, halfExtents.z } );
+}
+
+void Portal::setOpenness( float openness )
+{
+    impl->setOpenness( openness );
+}
+
+float Portal::getOpenness() const
+{
+    return impl->getOpenness();
+}
+
+Portal::operator bool() const noexcept
+{
+    return impl != nullptr;
+}
+
+std::shared_ptr<PortalImpl> Portal::get() const noexcept
+{
+    return impl;
+}
+
+void Portal::reset() noexcept
+{
+    impl.reset();
+}
@@ -0,0 +1,618 @@
+#include "PortalImpl.hpp"
+#include "DeviceImpl.hpp"
+#include "OcclusionFilterImpl.hpp"
+#include "RoomImpl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace Audio;
+
+// The cached paths of a listener (and the room of a source) are reused while it moves by less than 1 cm.
+static constexpr float MinMovement = 0.01f;
+
+namespace
+{
+// The portals are shared by the game thread and the worker thread.
+std::mutex& GetMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<PortalImpl*>& GetPortals()
+{
+    static std::vector<PortalImpl*> portals;
+    return portals;
+}
+
+float Dot( const ma_vec3f& a, const ma_vec3f& b )
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+float Distance( const ma_vec3f& a, const ma_vec3f& b )
+{
+    const ma_vec3f d = { a.x - b.x, a.y - b.y, a.z - b.z };
+    return std::sqrt( Dot( d, d ) );
+}
+
+ma_vec3f Normalize( const ma_vec3f& v, const ma_vec3f& fallback )
+{
+    const float length = std::sqrt( Dot( v, v ) );
+    if ( length < 1e-6f )
+        return fallback;
+
+    return { v.x / length, v.y / length, v.z / length };
+}
+
+ma_vec3f Clamp( const ma_vec3f& p, const ma_vec3f& min, const ma_vec3f& max )
+{
+    return { std::clamp( p.x, min.x, max.x ), std::clamp( p.y, min.y, max.y ), std::clamp( p.z, min.z, max.z ) };
+}
+
+bool Equal( const ma_vec3f& a, const ma_vec3f& b )
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+}  // namespace
+
+namespace Audio
+{
+/// <summary>
+/// The graph of the rooms and the portals, and the worker thread that finds the paths through the graph.
+/// </summary>
+/// <remarks>
+/// The game thread copies the graph (when it changes), the listeners, and the sources into a job while the
+/// worker thread is idle. The worker thread finds the shortest paths from each listener to all portals
+/// (Dijkstra), which are cached while the listener and the graph do not change, and picks the shortest
+/// path to each source from the portals of its room.
+/// </remarks>
+class PortalGraph
+{
+public:
+    static PortalGraph& get()
+    {
+        static PortalGraph graph;
+        return graph;
+    }
+
+    // Start the worker thread (when the first portal is created), or stop it (when the last portal is destroyed).
+    void start();
+    void stop();
+
+    // Start the next job (called by the game thread with the mutex of all portals locked).
+    void update( const std::vector<PortalSource*>& sources, ma_engine* pEngine );
+
+    // Incremented whenever a portal changes (guarded by the mutex of all portals).
+    uint64_t portalVersion = 1;
+
+private:
+    void run();
+
+    // Find the room that contains a position (the smallest room), or the outside.
+    size_t locate( const ma_vec3f& position ) const;
+
+    struct Room
+    {
+        const RoomImpl* room;
+        ma_vec3f        min;
+        ma_vec3f        max;
+        float           volume;
+    };
+
+    struct Node
+    {
+        size_t   rooms[2];
+        ma_vec3f center;
+        ma_vec3f min;
+        ma_vec3f max;
+        float    openness;
+    };
+
+    struct Query
+    {
+        std::shared_ptr<PortalSource::State> state;
+        ma_vec3f                             position;
+        ma_uint32                            listener;
+    };
+
+    // The shortest paths from a listener to each portal.
+    struct Tree
+    {
+        bool                valid   = false;
+        uint64_t            version = 0;
+        ma_vec3f            position {};
+        size_t              room = 0;
+        std::vector<float>  cost;
+        std::vector<float>  length;
+        std::vector<float>  transmission;
+        std::vector<size_t> previous;
+    };
+
+    void computeTree( Tree& tree, const ma_vec3f& listener ) const;
+
+    std::mutex        threadMutex;
+    std::thread       thread;
+    ma_event          event {};
+    std::atomic<bool> running { false };
+    std::atomic<bool> busy { false };
+    std::atomic<bool> quit { false };
+
+    // The job (written by the game thread while the worker thread is idle). The last room is the outside.
+    uint64_t                         version = 0;
+    std::vector<Room>                rooms;
+    std::vector<Node>                nodes;
+    std::vector<std::vector<size_t>> roomNodes;
+    ma_vec3f                         listeners[MA_ENGINE_MAX_LISTENERS] {};
+    std::vector<Query>               queries;
+
+    // Only used by the worker thread.
+    Tree                            trees[MA_ENGINE_MAX_LISTENERS];
+    std::vector<PortalSource::Path> paths;
+};
+}  // namespace Audio
+
+void PortalGraph::start()
+{
+    std::lock_guard lock { threadMutex };
+
+    if ( thread.joinable() )
+        return;
+
+    ma_event_init( &event );
+    quit    = false;
+    busy    = false;
+    running = true;
+    thread  = std::thread( &PortalGraph::run, this );
+}
+
+void PortalGraph::stop()
+{
+    std::lock_guard lock { threadMutex };
+
+    {
+        // A portal may have been created since the last portal was destroyed.
+        std::lock_guard portalsLock { GetMutex() };
+        if ( !thread.joinable() || !GetPortals().empty() )
+            return;
+
+        running = false;
+    }
+
+    quit = true;
+    ma_event_signal( &event );
+    thread.join();
+    ma_event_uninit( &event );
+
+    // The paths are recomputed for the next graph.
+    for ( auto& tree: trees )
+        tree.valid = false;
+}
+
+void PortalGraph::update( const std::vector<PortalSource*>& sources, ma_engine* pEngine )
+{
+    // Without portals, all sources are heard directly.
+    if ( !running )
+    {
+        for ( PortalSource* source: sources )
+            source->state->paths.publish( {} );
+
+        return;
+    }
+
+    if ( busy.load( std::memory_order_acquire ) )
+        return;
+
+    // The graph is copied when a portal or a room changes.
+    auto& portals = GetPortals();
+
+    uint64_t key = portalVersion;
+    for ( const PortalImpl* portal: portals )
+    {
+        for ( const auto& room: portal->rooms )
+            key = key * 1099511628211ull + ( room ? room->getVersion() : 0 );
+    }
+
+    if ( key != version )
+    {
+        version = key;
+        rooms.clear();
+        nodes.clear();
+
+        const auto getRoom = [this]( const RoomImpl* room ) {
+            const auto iter = std::find_if( rooms.begin(), rooms.end(), [room]( const Room& r ) { return r.room == room; } );
+            if ( iter != rooms.end() )
+                return static_cast<size_t>( iter - rooms.begin() );
+
+            ma_vec3f min, max;
+            room->getBox( min, max );
+            rooms.push_back( { room, min, max, ( max.x - min.x ) * ( max.y - min.y ) * ( max.z - min.z ) } );
+            return rooms.size() - 1;
+        };
+
+        // The outside gets its index once all rooms are known.
+        constexpr size_t outside = std::numeric_limits<size_t>::max();
+
+        for ( const PortalImpl* portal: portals )
+        {
+            Node node {};
+            for ( size_t side = 0; side < 2; ++side )
+                node.rooms[side] = portal->rooms[side] ? getRoom( portal->rooms[side].get() ) : outside;
+
+            const ma_vec3f& c = portal->center;
+            const ma_vec3f& e = portal->halfExtents;
+
+            node.center   = c;
+            node.min      = { c.x - e.x, c.y - e.y, c.z - e.z };
+            node.max      = { c.x + e.x, c.y + e.y, c.z + e.z };
+            node.openness = portal->openness;
+            nodes.push_back( node );
+        }
+
+        roomNodes.assign( rooms.size() + 1, {} );
+        for ( size_t n = 0; n < nodes.size(); ++n )
+        {
+            for ( auto& room: nodes[n].rooms )
+            {
+                if ( room == outside )
+                    room = rooms.size();
+
+                roomNodes[room].push_back( n );
+            }
+        }
+    }
+
+    const ma_uint32 listenerCount = std::min<ma_uint32>( ma_engine_get_listener_count( pEngine ), MA_ENGINE_MAX_LISTENERS );
+    for ( ma_uint32 listener = 0; listener < listenerCount; ++listener )
+        listeners[listener] = ma_engine_listener_get_position( pEngine, listener );
+
+    queries.clear();
+    for ( PortalSource* source: sources )
+    {
+        if ( source->engine != pEngine )
+            continue;
+
+        const ma_uint32 listener = ma_sound_get_listener_index( source->sound );
+        if ( listener < listenerCount )
+            queries.push_back( { source->state, source->getPosition(), listener } );
+    }
+
+    busy.store( true, std::memory_order_release );
+    ma_event_signal( &event );
+}
+
+size_t PortalGraph::locate( const ma_vec3f& position ) const
+{
+    size_t room   = rooms.size();
+    float  volume = std::numeric_limits<float>::max();
+
+    for ( size_t r = 0; r < rooms.size(); ++r )
+    {
+        const Room& candidate = rooms[r];
+        if ( candidate.volume < volume && Equal( Clamp( position, candidate.min, candidate.max ), position ) )
+        {
+            room   = r;
+            volume = candidate.volume;
+        }
+    }
+
+    return room;
+}
+
+void PortalGraph::computeTree( Tree& tree, const ma_vec3f& listener ) const
+{
+    constexpr float  infinity = std::numeric_limits<float>::infinity();
+    constexpr size_t none     = std::numeric_limits<size_t>::max();
+
+    tree.valid    = true;
+    tree.version  = version;
+    tree.position = listener;
+    tree.room     = locate( listener );
+    tree.cost.assign( nodes.size(), infinity );
+    tree.length.assign( nodes.size(), infinity );
+    tree.transmission.assign( nodes.size(), 1.0f );
+    tree.previous.assign( nodes.size(), none );
+
+    using Entry = std::pair<float, size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+    const auto penalty = [this]( size_t n ) { return ( 1.0f - nodes[n].openness ) * PortalImpl::ClosedPenalty; };
+
+    for ( size_t n: roomNodes[tree.room] )
+    {
+        const float length = Distance( listener, nodes[n].center );
+
+        tree.cost[n]         = length + penalty( n );
+        tree.length[n]       = length;
+        tree.transmission[n] = nodes[n].openness;
+        queue.push( { tree.cost[n], n } );
+    }
+
+    while ( !queue.empty() )
+    {
+        const auto [cost, n] = queue.top();
+        queue.pop();
+
+        if ( cost > tree.cost[n] )
+            continue;
+
+        // Continue into the rooms on both sides of the portal.
+        for ( size_t room: nodes[n].rooms )
+        {
+            for ( size_t m: roomNodes[room] )
+            {
+                const float length = Distance( nodes[n].center, nodes[m].center );
+                const float next   = cost + length + penalty( m );
+                if ( m == n || next >= tree.cost[m] )
+                    continue;
+
+                tree.cost[m]         = next;
+                tree.length[m]       = tree.length[n] + length;
+                tree.transmission[m] = tree.transmission[n] * nodes[m].openness;
+                tree.previous[m]     = n;
+                queue.push( { next, m } );
+            }
+        }
+    }
+}
+
+void PortalGraph::run()
+{
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    while ( true )
+    {
+        ma_event_wait( &event );
+
+        if ( quit )
+            break;
+
+        if ( !busy.load( std::memory_order_acquire ) )
+            continue;
+
+        paths.resize( queries.size() );
+        for ( size_t q = 0; q < queries.size(); ++q )
+        {
+            Query&               query    = queries[q];
+            PortalSource::State& state    = *query.state;
+            PortalSource::Path&  path     = paths[q];
+            Tree&                tree     = trees[query.listener];
+            const ma_vec3f&      listener = listeners[query.listener];
+
+            path = {};
+
+            if ( !tree.valid || tree.version != version || Distance( tree.position, listener ) >= MinMovement )
+                computeTree( tree, listener );
+
+            if ( state.queryVersion != version || Distance( state.queryPosition, query.position ) >= MinMovement )
+            {
+                state.queryVersion  = version;
+                state.queryPosition = query.position;
+                state.queryRoom     = static_cast<int>( locate( query.position ) );
+            }
+
+            const auto room = static_cast<size_t>( state.queryRoom );
+            if ( room == tree.room )
+                continue;
+
+            // The last portal of the path is one of the portals of the room of the source.
+            size_t last = none;
+            float  best = std::numeric_limits<float>::infinity();
+            for ( size_t n: roomNodes[room] )
+            {
+                const float cost = tree.cost[n] + Distance( nodes[n].center, query.position );
+                if ( cost < best )
+                {
+                    best = cost;
+                    last = n;
+                }
+            }
+
+            path.direct = false;
+
+            if ( last == none )
+            {
+                path.blocked = true;
+                continue;
+            }
+
+            // Walk back to the first portal (from the listener).
+            size_t first = last;
+            size_t child = none;
+            while ( tree.previous[first] != none )
+            {
+                child = first;
+                first = tree.previous[first];
+            }
+
+            path.portalMin    = nodes[first].min;
+            path.portalMax    = nodes[first].max;
+            path.nextIsSource = child == none;
+            path.next         = child == none ? query.position : nodes[child].center;
+            path.last         = nodes[last].center;
+            path.length       = tree.length[last];
+            path.transmission = tree.transmission[last];
+        }
+
+        // Hand the paths over to the audio thread.
+        for ( size_t q = 0; q < queries.size(); ++q )
+            queries[q].state->paths.publish( paths[q] );
+
+        // Release the sources that were destroyed in the meantime.
+        queries.clear();
+
+        busy.store( false, std::memory_order_release );
+    }
+}
+
+PortalImpl::PortalImpl( std::shared_ptr<RoomImpl> roomA, std::shared_ptr<RoomImpl> roomB, const ma_vec3f& _center, const ma_vec3f& _halfExtents )
+: rooms { std::move( roomA ), std::move( roomB ) }
+{
+    setBox( _center, _halfExtents );
+
+    {
+        std::lock_guard lock { GetMutex() };
+
+        GetPortals().push_back( this );
+        PortalGraph::get().portalVersion++;
+    }
+
+    PortalGraph::get().start();
+}
+
+PortalImpl::~PortalImpl()
+{
+    {
+        std::lock_guard lock { GetMutex() };
+
+        auto&      portals = GetPortals();
+        const auto iter    = std::find( portals.begin(), portals.end(), this );
+        if ( iter != portals.end() )
+            portals.erase( iter );
+
+        PortalGraph::get().portalVersion++;
+    }
+
+    PortalGraph::get().stop();
+}
+
+void PortalImpl::setBox( const ma_vec3f& _center, const ma_vec3f& _halfExtents )
+{
+    std::lock_guard lock { GetMutex() };
+
+    center      = _center;
+    halfExtents = { std::abs( _halfExtents.x ), std::abs( _halfExtents.y ), std::abs( _halfExtents.z ) };
+
+    PortalGraph::get().portalVersion++;
+}
+
+void PortalImpl::setOpenness( float _openness )
+{
+    std::lock_guard lock { GetMutex() };
+
+    openness = std::clamp( _openness, 0.0f, 1.0f );
+
+    PortalGraph::get().portalVersion++;
+}
+
+float PortalImpl::getOpenness() const
+{
+    std::lock_guard lock { GetMutex() };
+    return openness;
+}
+
+void PortalImpl::updateAll( const RealtimeList<PortalSource*>& sources, ma_engine* pEngine )
+{
+    std::lock_guard lock { GetMutex() };
+    PortalGraph::get().update( sources.items(), pEngine );
+}
+
+void PortalImpl::applyAll( const RealtimeList<PortalSource*>& sources, ma_engine* pEngine )
+{
+    for ( PortalSource* source: sources.acquire() )
+    {
+        if ( source->engine != pEngine )
+            continue;
+
+        // The position was set by the game, or it was changed since the apparent position was applied (by the game, or on the audio thread).
+        const ma_vec3f current   = ma_sound_get_position( source->sound );
+        const auto&    requested = source->requested.acquire();
+        if ( requested.version != source->sourcePosition.version )
+            source->sourcePosition = requested;
+        else if ( !Equal( current, source->apparent ) )
+            source->sourcePosition.position = current;
+
+        const ma_vec3f&           position = source->sourcePosition.position;
+        const PortalSource::Path& path     = source->state->paths.acquire();
+
+        ma_vec3f apparent    = position;
+        float    occlusion   = source->occlusion.load( std::memory_order_relaxed );
+        float    obstruction = source->obstruction.load( std::memory_order_relaxed );
+
+        if ( ma_sound_get_positioning( source->sound ) == ma_positioning_relative )
+        {
+            // Sounds that are positioned relative to the listener are always heard directly.
+        }
+        else if ( path.blocked )
+        {
+            occlusion = 1.0f;
+        }
+        else if ( !path.direct )
+        {
+            const ma_vec3f listener = ma_engine_listener_get_position( pEngine, ma_sound_get_listener_index( source->sound ) );
+            const ma_vec3f toSource = Normalize( { position.x - listener.x, position.y - listener.y, position.z - listener.z }, { 0.0f, 0.0f, -1.0f } );
+
+            // The sound is heard from the point of the first portal that is closest to the rest of the path, at the length of the path.
+            const float    length    = path.length + Distance( path.last, position );
+            const ma_vec3f opening   = Clamp( path.nextIsSource ? position : path.next, path.portalMin, path.portalMax );
+            const ma_vec3f direction = Normalize( { opening.x - listener.x, opening.y - listener.y, opening.z - listener.z }, toSource );
+
+            apparent = { listener.x + direction.x * length, listener.y + direction.y * length, listener.z + direction.z * length };
+
+            // Closed portals occlude the sound, and the bend of the path obstructs it (fully when the sound is heard from behind).
+            occlusion   = 1.0f - ( 1.0f - occlusion ) * path.transmission;
+            obstruction = std::max( obstruction, std::clamp( ( 1.0f - Dot( toSource, direction ) ) * 0.5f, 0.0f, 1.0f ) );
+        }
+
+        source->apparent = apparent;
+        if ( !Equal( current, apparent ) )
+            ma_sound_set_position( source->sound, apparent.x, apparent.y, apparent.z );
+
+        source->occlusionFilter->setOcclusion( occlusion, obstruction );
+
+        // Hand the position of the source back to the game.
+        source->rendered.publish( source->sourcePosition );
+    }
+}
+
+PortalSource::PortalSource( std::shared_ptr<DeviceImpl> _device, ma_engine* pEngine, ma_sound* pSound, OcclusionFilterImpl* _occlusionFilter )
+: device { std::move( _device ) }
+, engine { pEngine }
+, sound { pSound }
+, occlusionFilter { _occlusionFilter }
+, state { std::make_shared<State>() }
+, position { ma_sound_get_position( pSound ) }
+, requested { position }
+, rendered { position }
+, sourcePosition { position }
+, apparent { position.position }
+, occlusion { _occlusionFilter->getOcclusion() }
+, obstruction { _occlusionFilter->getObstruction() }
+{
+    device->getPortalSources().add( this );
+}
+
+PortalSource::~PortalSource()
+{
+    device->getPortalSources().remove( this );
+
+    // Restore the occlusion that was set by the game.
+    occlusionFilter->setOcclusion( occlusion, obstruction );
+}
+
+void PortalSource::setPosition( const ma_vec3f& _position )
+{
+    position = { _position, position.version + 1 };
+    requested.publish( position );
+}
+
+ma_vec3f PortalSource::getPosition()
+{
+    // The audio thread moves the source with the sound once it has seen the last position that was set by the game.
+    const Position& latest = rendered.acquire();
+    return latest.version == position.version ? latest.position : position.position;
+}
+
+void PortalSource::setOcclusion( float _occlusion, float _obstruction )
+{
+    occlusion.store( std::clamp( _occlusion, 0.0f, 1.0f ), std::memory_order_relaxed );
+    obstruction.store( std::clamp( _obstruction, 0.0f, 1.0f ), std::memory_order_relaxed );
+}
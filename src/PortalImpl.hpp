@@ -0,0 +1,172 @@
+#pragma once
+
+#include "Realtime.hpp"
+
+#include "miniaudio.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Audio
+{
+class DeviceImpl;
+class OcclusionFilterImpl;
+class PortalSource;
+class RoomImpl;
+
+/// <summary>
+/// A portal between two rooms (or a room and the outside). The portals are kept in a global graph.
+/// </summary>
+class PortalImpl
+{
+public:
+    /// <summary>
+    /// Create a portal.
+    /// </summary>
+    /// <param name="roomA">The room on one side of the portal (or `nullptr` for the outside).</param>
+    /// <param name="roomB">The room on the other side of the portal (or `nullptr` for the outside).</param>
+    /// <param name="center">The center of the portal.</param>
+    /// <param name="halfExtents">Half of the size of the portal along each axis.</param>
+    PortalImpl( std::shared_ptr<RoomImpl> roomA, std::shared_ptr<RoomImpl> roomB, const ma_vec3f& center, const ma_vec3f& halfExtents );
+    ~PortalImpl();
+
+    void setBox( const ma_vec3f& center, const ma_vec3f& halfExtents );
+
+    void  setOpenness( float openness );
+    float getOpenness() const;
+
+    /// <summary>
+    /// Start the path queries of all sounds with portal propagation (on the game thread, in `Device::update`).
+    /// The queries are run on a worker thread. If the worker thread is still busy with the previous queries,
+    /// the sounds keep the results of the previous queries.
+    /// </summary>
+    static void updateAll( const RealtimeList<PortalSource*>& sources, ma_engine* pEngine );
+
+    /// <summary>
+    /// Move the sounds with portal propagation to their apparent positions, and occlude them (on the audio thread).
+    /// The audio thread only reads the results of the queries, and never waits for the game thread or the worker thread.
+    /// </summary>
+    static void applyAll( const RealtimeList<PortalSource*>& sources, ma_engine* pEngine );
+
+    // The penalty (in world units) that is added to the length of a path through a closed portal.
+    static constexpr float ClosedPenalty = 20.0f;
+
+    PortalImpl( const PortalImpl& )            = delete;
+    PortalImpl( PortalImpl&& )                 = delete;
+    PortalImpl& operator=( const PortalImpl& ) = delete;
+    PortalImpl& operator=( PortalImpl&& )      = delete;
+
+private:
+    friend class PortalGraph;
+
+    // Guarded by the mutex of all portals.
+    std::shared_ptr<RoomImpl> rooms[2];
+    ma_vec3f                  center {};
+    ma_vec3f                  halfExtents {};
+    float                     openness = 1.0f;
+};
+
+/// <summary>
+/// The state of a sound that is heard through the portals.
+/// </summary>
+/// <remarks>
+/// The audio thread writes the apparent position to the sound. The position that is set by the game (or by
+/// the audio thread for interpolated sounds, and sounds in a transform buffer) is detected as a change of the
+/// position of the sound, and kept as the source position. The occlusion that is set by the game is combined
+/// with the occlusion of the path.
+/// The positions and the paths are handed over between the threads through triple buffers.
+/// </remarks>
+class PortalSource
+{
+public:
+    PortalSource( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, ma_sound* pSound, OcclusionFilterImpl* occlusionFilter );
+    ~PortalSource();
+
+    /// <summary>
+    /// Set (or get) the position of the source (the position of the sound that is not moved by the portals).
+    /// Only used by the game thread.
+    /// </summary>
+    void     setPosition( const ma_vec3f& position );
+    ma_vec3f getPosition();
+
+    /// <summary>
+    /// Set the occlusion and obstruction that are set by the game.
+    /// </summary>
+    void setOcclusion( float occlusion, float obstruction );
+
+    // The shortest path from the listener to the source (written by the worker thread).
+    struct Path
+    {
+        // The source is in the same room as the listener (or there are no portals).
+        bool direct = true;
+        // There is no path from the listener to the source.
+        bool blocked = false;
+        // The bounds of the first portal (from the listener).
+        ma_vec3f portalMin {};
+        ma_vec3f portalMax {};
+        // The point after the first portal: the center of the next portal, or the source.
+        ma_vec3f next {};
+        bool     nextIsSource = true;
+        // The center of the last portal (in the room of the source), and the length of the path up to it.
+        ma_vec3f last {};
+        float    length = 0.0f;
+        // The product of the openness of the portals on the path.
+        float transmission = 1.0f;
+    };
+
+    // The results of the queries are handed over to the audio thread through the shared state,
+    // so the worker thread can publish the result of a sound that was destroyed in the meantime.
+    struct State
+    {
+        // Written by the worker thread (or by the game thread while the worker thread is stopped).
+        TripleBuffer<Path> paths;
+
+        // Only used by the worker thread: the room of the source for the last query.
+        ma_vec3f queryPosition {};
+        int      queryRoom    = -1;
+        uint64_t queryVersion = 0;
+    };
+
+    PortalSource( const PortalSource& )            = delete;
+    PortalSource( PortalSource&& )                 = delete;
+    PortalSource& operator=( const PortalSource& ) = delete;
+    PortalSource& operator=( PortalSource&& )      = delete;
+
+private:
+    friend class PortalImpl;
+    friend class PortalGraph;
+
+    // A position of the source, and the number of positions that were set by the game before it.
+    struct Position
+    {
+        ma_vec3f position {};
+        uint64_t version = 0;
+    };
+
+    // The device that owns the list of all sources.
+    std::shared_ptr<DeviceImpl> device;
+
+    ma_engine*           engine          = nullptr;
+    ma_sound*            sound           = nullptr;
+    OcclusionFilterImpl* occlusionFilter = nullptr;
+
+    std::shared_ptr<State> state;
+
+    // Only used by the game thread: the last position that was set by the game.
+    Position position;
+
+    // The positions that are set by the game (read by the audio thread), and the positions of the source that
+    // are used by the audio thread (read by the game thread).
+    TripleBuffer<Position> requested;
+    TripleBuffer<Position> rendered;
+
+    // Only used by the audio thread: the position of the source, and the apparent position that was applied to the sound.
+    Position sourcePosition;
+    ma_vec3f apparent {};
+
+    // Set by the game.
+    std::atomic<float> occlusion { 0.0f };
+    std::atomic<float> obstruction { 0.0f };
+};
+}  // namespace Audio
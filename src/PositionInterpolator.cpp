@@ -0,0 +1,63 @@
+#include "PositionInterpolator.hpp"
+#include "DeviceImpl.hpp"
+
+#include <algorithm>
+
+using namespace Audio;
+
+PositionInterpolator::PositionInterpolator( std::shared_ptr<DeviceImpl> _device, ma_engine* pEngine, ma_sound* pSound )
+: device { std::move( _device ) }
+, engine { pEngine }
+, sound { pSound }
+, motion { ma_sound_get_position( pSound ), ma_sound_get_position( pSound ) }
+, motions { motion }
+{
+    device->getInterpolators().add( this );
+}
+
+PositionInterpolator::~PositionInterpolator()
+{
+    device->getInterpolators().remove( this );
+}
+
+void PositionInterpolator::push( const ma_vec3f& position, const ma_vec3f& velocity, double interval )
+{
+    const double now = getTime();
+
+    // Continue from the position that is rendered now.
+    motion = { evaluate( motion, now ), position, velocity, now, interval };
+    motions.publish( motion );
+}
+
+void PositionInterpolator::applyAll( const RealtimeList<PositionInterpolator*>& interpolators )
+{
+    for ( PositionInterpolator* interpolator: interpolators.acquire() )
+    {
+        const ma_vec3f position = evaluate( interpolator->motions.acquire(), interpolator->getTime() );
+        ma_sound_set_position( interpolator->sound, position.x, position.y, position.z );
+    }
+}
+
+double PositionInterpolator::getTime() const noexcept
+{
+    return static_cast<double>( ma_engine_get_time( engine ) ) / static_cast<double>( ma_engine_get_sample_rate( engine ) );
+}
+
+ma_vec3f PositionInterpolator::evaluate( const Motion& motion, double time ) noexcept
+{
+    const auto& [from, to, velocity, start, interval] = motion;
+
+    if ( interval <= 0.0 )
+        return to;
+
+    const double elapsed = time - start;
+    if ( elapsed < interval )
+    {
+        const float t = static_cast<float>( std::max( elapsed, 0.0 ) / interval );
+        return { from.x + ( to.x - from.x ) * t, from.y + ( to.y - from.y ) * t, from.z + ( to.z - from.z ) * t };
+    }
+
+    // The next position is late: keep moving (for at most one more interval).
+    const float late = static_cast<float>( std::min( elapsed - interval, interval ) );
+    return { to.x + velocity.x * late, to.y + velocity.y * late, to.z + velocity.z * late };
+}
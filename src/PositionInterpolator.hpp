@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Realtime.hpp"
+
+#include "miniaudio.h"
+
+#include <memory>
+
+namespace Audio
+{
+class DeviceImpl;
+
+/// <summary>
+/// Smooths the motion of a sound whose position is updated at a lower rate than the audio periods
+/// (for example, by a simulation that ticks at 20 Hz).
+/// </summary>
+/// <remarks>
+/// Each new position is reached over the interval between its timestamp and the timestamp of the
+/// previous position, starting from the position that is currently rendered. The motion is one
+/// update behind the simulation, but it has no steps. If the next position is late, the position
+/// is extrapolated with the velocity of the sound (for at most one more interval).
+/// The positions are applied to the sound by the audio thread at the start of every period, and
+/// each new motion is handed over to the audio thread without a lock.
+/// </remarks>
+class PositionInterpolator
+{
+public:
+    PositionInterpolator( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, ma_sound* pSound );
+    ~PositionInterpolator();
+
+    /// <summary>
+    /// Move to a new position (on the game thread).
+    /// </summary>
+    /// <param name="position">The new position.</param>
+    /// <param name="velocity">The velocity of the sound (used for extrapolation).</param>
+    /// <param name="interval">The time (in seconds) to move to the new position, or 0 to jump to the new position.</param>
+    void push( const ma_vec3f& position, const ma_vec3f& velocity, double interval );
+
+    /// <summary>
+    /// Apply the interpolated positions of all sounds of a device (on the audio thread).
+    /// </summary>
+    static void applyAll( const RealtimeList<PositionInterpolator*>& interpolators );
+
+    PositionInterpolator( const PositionInterpolator& )            = delete;
+    PositionInterpolator( PositionInterpolator&& )                 = delete;
+    PositionInterpolator& operator=( const PositionInterpolator& ) = delete;
+    PositionInterpolator& operator=( PositionInterpolator&& )      = delete;
+
+private:
+    // The motion from `from` to `to` starts at `start` and takes `interval` seconds.
+    struct Motion
+    {
+        ma_vec3f from {};
+        ma_vec3f to {};
+        ma_vec3f velocity {};
+        double   start    = 0.0;
+        double   interval = 0.0;
+    };
+
+    // Get the current time of the engine (in seconds).
+    double getTime() const noexcept;
+
+    // Get the position of a motion at a point in time.
+    static ma_vec3f evaluate( const Motion& motion, double time ) noexcept;
+
+    // The device that owns the list of all interpolators.
+    std::shared_ptr<DeviceImpl> device;
+
+    ma_engine* engine = nullptr;
+    ma_sound*  sound  = nullptr;
+
+    // The last motion (only used by the game thread), and the motions that are handed over to the audio thread.
+    Motion               motion;
+    TripleBuffer<Motion> motions;
+};
+}  // namespace Audio
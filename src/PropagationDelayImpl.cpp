@@ -0,0 +1,138 @@
+#include "PropagationDelayImpl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+using namespace Audio;
+
+// The speed of sound in air (in meters per second).
+static constexpr float DefaultSpeedOfSound = 343.3f;
+// Delay changes of more than this (in seconds) within one block are applied immediately.
+static constexpr double MaxRampTime = 0.05;
+// The delay can change by at most this many frames per frame (a pitch change of 0.5 - 1.5).
+static constexpr double MaxSlope = 0.5;
+// The shortest delay (in frames): the interpolation reads one frame after the read position.
+static constexpr double MinDelay = 2.0;
+
+namespace
+{
+std::atomic<float> speedOfSound { DefaultSpeedOfSound };
+
+// 4-point, 3rd-order Hermite interpolation between `y1` and `y2`.
+inline float Hermite( float y0, float y1, float y2, float y3, float t ) noexcept
+{
+    const float c1 = 0.5f * ( y2 - y0 );
+    const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+    const float c3 = 0.5f * ( y3 - y0 ) + 1.5f * ( y1 - y2 );
+    return ( ( c3 * t + c2 ) * t + c1 ) * t + y1;
+}
+}  // namespace
+
+void PropagationDelayImpl::setSpeedOfSound( float _speedOfSound ) noexcept
+{
+    speedOfSound.store( std::max( _speedOfSound, 1.0f ), std::memory_order_relaxed );
+}
+
+float PropagationDelayImpl::getSpeedOfSound() noexcept
+{
+    return speedOfSound.load( std::memory_order_relaxed );
+}
+
+PropagationDelayImpl::PropagationDelayImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, ma_sound* pSound )
+: CustomEffectImpl( std::move( device ), pEngine, 1, MA_NODE_FLAG_CONTINUOUS_PROCESSING )  // Keep playing the delayed tail after the sound stops.
+, engine { pEngine }
+, sound { pSound }
+{
+    if ( !isInitialized() )
+        return;
+
+    // Room for the longest delay, the interpolation taps, and one block.
+    const auto frames = static_cast<ma_uint32>( MaxDelay * static_cast<float>( sampleRate ) ) + 4096;
+
+    lineFrames = 1;
+    while ( lineFrames < frames )
+        lineFrames <<= 1;
+
+    mask = lineFrames - 1;
+    line.resize( static_cast<size_t>( lineFrames ) * channels );
+
+    maxDelay     = static_cast<double>( MaxDelay ) * sampleRate;
+    maxRamp      = MaxRampTime * sampleRate;
+    silentFrames = lineFrames;
+}
+
+PropagationDelayImpl::~PropagationDelayImpl()
+{
+    uninit();
+}
+
+float PropagationDelayImpl::getDistance() const
+{
+    ma_vec3f relativePosition;
+
+    if ( ma_sound_get_positioning( sound ) == ma_positioning_relative )
+    {
+        relativePosition = ma_sound_get_position( sound );
+    }
+    else
+    {
+        const ma_uint32 listener = ma_sound_get_listener_index( sound );
+        ma_spatializer_get_relative_position_and_direction( &sound->engineNode.spatializer, &engine->listeners[listener], &relativePosition, nullptr );
+    }
+
+    return std::sqrt( relativePosition.x * relativePosition.x + relativePosition.y * relativePosition.y + relativePosition.z * relativePosition.z );
+}
+
+void PropagationDelayImpl::process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount )
+{
+    const float* in = ppFramesIn[0];
+
+    const double distance = ma_sound_is_spatialization_enabled( sound ) ? getDistance() : 0.0;
+    const double target   = std::clamp( distance / getSpeedOfSound() * sampleRate, MinDelay, maxDelay );
+
+    // Jump to the first delay, and to delays that are too far away to ramp to.
+    if ( !hasDelay || std::fabs( target - delay ) > maxRamp )
+    {
+        delay    = target;
+        hasDelay = true;
+    }
+
+    const double slope = frameCount > 0 ? std::clamp( ( target - delay ) / frameCount, -MaxSlope, MaxSlope ) : 0.0;
+
+    const size_t samples = static_cast<size_t>( frameCount ) * channels;
+    const bool   silent  = std::all_of( in, in + samples, []( float sample ) { return sample == 0.0f; } );
+
+    silentFrames = silent ? std::min( silentFrames + frameCount, lineFrames ) : 0;
+
+    // Fast path: the delay line only contains silence (so it does not have to be written either).
+    if ( silentFrames >= lineFrames )
+    {
+        std::fill_n( pFramesOut, samples, 0.0f );
+        writeIndex = ( writeIndex + frameCount ) & mask;
+        delay += slope * frameCount;
+        return;
+    }
+
+    for ( ma_uint32 i = 0; i < frameCount; ++i )
+    {
+        std::copy_n( in + static_cast<size_t>( i ) * channels, channels, line.data() + static_cast<size_t>( writeIndex ) * channels );
+
+        // Read `delay` frames behind the frame that was just written, between frames `i1` and `i2`.
+        const double    whole = std::ceil( delay );
+        const auto      t     = static_cast<float>( whole - delay );
+        const ma_uint32 i1    = ( writeIndex - static_cast<ma_uint32>( whole ) ) & mask;
+        const ma_uint32 i0    = ( i1 - 1 ) & mask;
+        const ma_uint32 i2       = ( i1 + 1 ) & mask;
+        const ma_uint32 i3       = ( i1 + 2 ) & mask;
+
+        for ( ma_uint32 c = 0; c < channels; ++c )
+        {
+            pFramesOut[static_cast<size_t>( i ) * channels + c] = Hermite( line[static_cast<size_t>( i0 ) * channels + c], line[static_cast<size_t>( i1 ) * channels + c],
+                                                                           line[static_cast<size_t>( i2 ) * channels + c], line[static_cast<size_t>( i3 ) * channels + c], t );
+        }
+
+        writeIndex = ( writeIndex + 1 ) & mask;
+        delay += slope;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "EffectImpl.hpp"
+
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// Per-voice propagation delay: the output of a sound is delayed by the time the sound takes to
+/// travel from the sound to the listener. The filter is inserted between a sound and its bus.
+/// </summary>
+/// <remarks>
+/// The delay line is read at a fractional position (with cubic interpolation), and the delay is
+/// ramped over each block. When the distance changes, the ramp resamples the sound, which is the
+/// (physically correct) doppler effect. The pitch-based doppler effect of the spatializer should be
+/// disabled for delayed sounds. Distance changes that are too fast to be motion (like a teleport)
+/// are applied immediately instead.
+/// </remarks>
+class PropagationDelayImpl : public CustomEffectImpl
+{
+public:
+    /// <summary>
+    /// Create a propagation delay.
+    /// </summary>
+    /// <param name="device">The device that owns the engine.</param>
+    /// <param name="pEngine">The engine.</param>
+    /// <param name="pSound">The sound that is delayed (for its distance to the listener).</param>
+    PropagationDelayImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, ma_sound* pSound );
+    ~PropagationDelayImpl() override;
+
+    /// <summary>
+    /// Set (or get) the speed of sound (in world units per second) that is used by all propagation delays.
+    /// </summary>
+    static void  setSpeedOfSound( float speedOfSound ) noexcept;
+    static float getSpeedOfSound() noexcept;
+
+    // The longest delay (in seconds).
+    static constexpr float MaxDelay = 2.0f;
+
+protected:
+    void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) override;
+
+private:
+    // Get the distance between the sound and its listener.
+    float getDistance() const;
+
+    ma_engine* engine = nullptr;
+    ma_sound*  sound  = nullptr;
+
+    // The delay line (frame x channel). The size is a power of two.
+    std::vector<float> line;
+    ma_uint32          lineFrames = 0;
+    ma_uint32          mask       = 0;
+    ma_uint32          writeIndex = 0;
+
+    // The current delay (in frames), the longest delay, and the largest delay change that is ramped.
+    // The delay is a double, so that slow ramps of long delays are not quantized.
+    double delay    = 0.0;
+    double maxDelay = 0.0;
+    double maxRamp  = 0.0;
+    bool   hasDelay = false;
+
+    // The number of frames since the last non-silent input (the line is silent after `lineFrames`).
+    ma_uint32 silentFrames = 0;
+};
+}  // namespace Audio
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// Counts the render passes of the audio thread, so the game thread can tell when the audio thread
+/// no longer uses the data it has replaced.
+/// </summary>
+/// <remarks>
+/// The epoch is odd while the audio thread renders. Data that was replaced at an even epoch is no longer
+/// used, and data that was replaced at an odd epoch is no longer used once the epoch has changed.
+/// </remarks>
+class RenderEpoch
+{
+public:
+    /// <summary>
+    /// Start (or end) a render pass (on the audio thread).
+    /// </summary>
+    void begin() noexcept
+    {
+        epoch.fetch_add( 1 );
+    }
+
+    void end() noexcept
+    {
+        epoch.fetch_add( 1 );
+    }
+
+    uint64_t get() const noexcept
+    {
+        return epoch.load();
+    }
+
+    /// <summary>
+    /// Check if the render pass that was running at an epoch (if any) has ended.
+    /// </summary>
+    bool hasPassed( uint64_t value ) const noexcept
+    {
+        return ( value & 1 ) == 0 || epoch.load() != value;
+    }
+
+    /// <summary>
+    /// Wait for the current render pass to end (never call this on the audio thread).
+    /// </summary>
+    void synchronize() const noexcept
+    {
+        const uint64_t value = get();
+        while ( !hasPassed( value ) )
+            std::this_thread::yield();
+    }
+
+private:
+    std::atomic<uint64_t> epoch { 0 };
+};
+
+/// <summary>
+/// Hands the last value that was written by one thread over to another thread without a lock.
+/// </summary>
+/// <remarks>
+/// The writer and the reader each own one of three copies, and swap it with the copy that was published last
+/// (like the transforms of a transform buffer). `published` holds the index of the last published copy, and
+/// `Fresh` if it has not been read yet.
+/// </remarks>
+template<typename T>
+class TripleBuffer
+{
+public:
+    explicit TripleBuffer( const T& value = {} )
+    : buffers { value, value, value }
+    {}
+
+    /// <summary>
+    /// Publish a value (on the writing thread).
+    /// </summary>
+    void publish( const T& value )
+    {
+        buffers[back] = value;
+        back          = published.exchange( back | Fresh, std::memory_order_acq_rel ) & ~Fresh;
+    }
+
+    /// <summary>
+    /// Get the last published value (on the reading thread).
+    /// </summary>
+    const T& acquire() noexcept
+    {
+        if ( published.load( std::memory_order_relaxed ) & Fresh )
+            front = published.exchange( front, std::memory_order_acq_rel ) & ~Fresh;
+
+        return buffers[front];
+    }
+
+    TripleBuffer( const TripleBuffer& )            = delete;
+    TripleBuffer( TripleBuffer&& )                 = delete;
+    TripleBuffer& operator=( const TripleBuffer& ) = delete;
+    TripleBuffer& operator=( TripleBuffer&& )      = delete;
+
+private:
+    static constexpr uint32_t Fresh = 4;
+
+    std::array<T, 3>      buffers;
+    uint32_t              back  = 0;
+    uint32_t              front = 1;
+    std::atomic<uint32_t> published { 2 };
+};
+
+/// <summary>
+/// A list that is changed by the game thread and read by the audio thread without a lock.
+/// </summary>
+/// <remarks>
+/// Every change publishes a new (immutable) copy of the list behind an atomic pointer. The replaced copies are
+/// freed by the game thread once the audio thread no longer reads them. Removing an item waits for the
+/// current render pass to end, so the item can be destroyed as soon as it is removed.
+/// </remarks>
+template<typename T>
+class RealtimeList
+{
+public:
+    explicit RealtimeList( RenderEpoch& epoch )
+    : epoch { epoch }
+    , list { std::make_unique<std::vector<T>>() }
+    , current { list.get() }
+    {}
+
+    /// <summary>
+    /// Get the items (on the game thread).
+    /// </summary>
+    const std::vector<T>& items() const noexcept
+    {
+        return *list;
+    }
+
+    /// <summary>
+    /// Get the items (on the audio thread). The items are valid until the end of the render pass.
+    /// </summary>
+    const std::vector<T>& acquire() const noexcept
+    {
+        return *current.load();
+    }
+
+    void add( const T& item )
+    {
+        auto next = std::make_unique<std::vector<T>>( *list );
+        next->push_back( item );
+        publish( std::move( next ) );
+    }
+
+    /// <summary>
+    /// Replace the items. Items that are no longer in the list may still be used by the current render pass.
+    /// </summary>
+    void assign( std::vector<T> items )
+    {
+        publish( std::make_unique<std::vector<T>>( std::move( items ) ) );
+    }
+
+    template<typename Predicate>
+    void removeIf( Predicate predicate )
+    {
+        auto       next = std::make_unique<std::vector<T>>( *list );
+        const auto end  = std::remove_if( next->begin(), next->end(), predicate );
+        if ( end == next->end() )
+            return;
+
+        next->erase( end, next->end() );
+        publish( std::move( next ) );
+
+        // The removed items may still be used by the current render pass.
+        epoch.synchronize();
+        reclaim();
+    }
+
+    void remove( const T& item )
+    {
+        removeIf( [&item]( const T& other ) { return other == item; } );
+    }
+
+    RealtimeList( const RealtimeList& )            = delete;
+    RealtimeList( RealtimeList&& )                 = delete;
+    RealtimeList& operator=( const RealtimeList& ) = delete;
+    RealtimeList& operator=( RealtimeList&& )      = delete;
+
+private:
+    void publish( std::unique_ptr<std::vector<T>> next )
+    {
+        current.store( next.get() );
+        retired.emplace_back( epoch.get(), std::move( list ) );
+        list = std::move( next );
+
+        reclaim();
+    }
+
+    // Free the copies that are no longer read by the audio thread.
+    void reclaim()
+    {
+        retired.erase( std::remove_if( retired.begin(), retired.end(), [this]( const auto& copy ) { return epoch.hasPassed( copy.first ); } ), retired.end() );
+    }
+
+    RenderEpoch& epoch;
+
+    // The current copy (owned by the game thread), and the copy that is read by the audio thread.
+    std::unique_ptr<std::vector<T>> list;
+    std::atomic<std::vector<T>*>    current;
+
+    // The replaced copies, and the epoch at which they were replaced.
+    std::vector<std::pair<uint64_t, std::unique_ptr<std::vector<T>>>> retired;
+};
+}  // namespace Audio
@@ -0,0 +1,626 @@
+#include "Resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#if defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 )
+    #include <xmmintrin.h>
+    #define AUDIO_RESAMPLER_SSE
+#elif defined( __ARM_NEON ) || defined( _M_ARM64 )
+    #include <arm_neon.h>
+    #define AUDIO_RESAMPLER_NEON
+#endif
+
+using namespace Audio;
+
+namespace
+{
+// The number of frames of history that are kept before the read position.
+// This is enough for the left half of the widest kernel.
+constexpr size_t Lead = Resampler::MaxTaps / 2 - 1;
+
+// The number of phases (fractional positions) of the sinc kernel table.
+constexpr size_t Phases = 256;
+
+constexpr double Pi = 3.14159265358979323846;
+
+// The zeroth order modified Bessel function of the first kind (for the Kaiser window).
+double besselI0( double x )
+{
+    double sum  = 1.0;
+    double term = 1.0;
+    for ( int k = 1; k < 32; ++k )
+    {
+        term *= ( x / ( 2.0 * k ) ) * ( x / ( 2.0 * k ) );
+        sum += term;
+    }
+    return sum;
+}
+
+/// <summary>
+/// Polyphase table of a Kaiser-windowed sinc kernel.
+/// Row `p` contains the taps for a fractional position of `p / Phases`. There is one extra
+/// row so that the coefficients can be interpolated between two rows without wrapping around.
+/// </summary>
+struct SincTable
+{
+    SincTable( size_t _taps, double beta )
+    : taps { _taps }
+    , coefficients( ( Phases + 1 ) * _taps )
+    {
+        const double half = static_cast<double>( taps / 2 );
+        const double norm = besselI0( beta );
+
+        for ( size_t p = 0; p <= Phases; ++p )
+        {
+            float* row = coefficients.data() + p * taps;
+            double sum = 0.0;
+
+            for ( size_t k = 0; k < taps; ++k )
+            {
+                // The distance between the tap and the (fractional) read position.
+                const double x    = static_cast<double>( k ) - ( half - 1.0 ) - static_cast<double>( p ) / Phases;
+                const double sinc = x == 0.0 ? 1.0 : std::sin( Pi * x ) / ( Pi * x );
+                const double w    = x / half;
+                const double win  = std::abs( w ) < 1.0 ? besselI0( beta * std::sqrt( 1.0 - w * w ) ) / norm : 0.0;
+
+                row[k] = static_cast<float>( sinc * win );
+                sum += row[k];
+            }
+
+            // Normalize each row to unity gain at DC.
+            for ( size_t k = 0; k < taps; ++k )
+                row[k] = static_cast<float>( row[k] / sum );
+        }
+    }
+
+    size_t             taps;
+    std::vector<float> coefficients;
+};
+
+// The window of the shorter kernel is narrower (lower beta) to keep its passband flat.
+const SincTable& getSincTable( size_t taps )
+{
+    static const SincTable sinc8 { 8, 5.0 };
+    static const SincTable sinc32 { Resampler::MaxTaps, 9.0 };
+    return taps == 8 ? sinc8 : sinc32;
+}
+
+// The dot product of `count` floats. `count` must be a multiple of 8.
+inline float dot( const float* a, const float* b, size_t count ) noexcept
+{
+#if defined( AUDIO_RESAMPLER_SSE )
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for ( size_t i = 0; i < count; i += 8 )
+    {
+        acc0 = _mm_add_ps( acc0, _mm_mul_ps( _mm_loadu_ps( a + i ), _mm_loadu_ps( b + i ) ) );
+        acc1 = _mm_add_ps( acc1, _mm_mul_ps( _mm_loadu_ps( a + i + 4 ), _mm_loadu_ps( b + i + 4 ) ) );
+    }
+    __m128 acc = _mm_add_ps( acc0, acc1 );
+    acc        = _mm_add_ps( acc, _mm_movehl_ps( acc, acc ) );
+    acc        = _mm_add_ss( acc, _mm_shuffle_ps( acc, acc, 1 ) );
+    return _mm_cvtss_f32( acc );
+#elif defined( AUDIO_RESAMPLER_NEON )
+    float32x4_t acc0 = vdupq_n_f32( 0.0f );
+    float32x4_t acc1 = vdupq_n_f32( 0.0f );
+    for ( size_t i = 0; i < count; i += 8 )
+    {
+        acc0 = vmlaq_f32( acc0, vld1q_f32( a + i ), vld1q_f32( b + i ) );
+        acc1 = vmlaq_f32( acc1, vld1q_f32( a + i + 4 ), vld1q_f32( b + i + 4 ) );
+    }
+    const float32x4_t acc = vaddq_f32( acc0, acc1 );
+    const float32x2_t sum = vadd_f32( vget_low_f32( acc ), vget_high_f32( acc ) );
+    return vget_lane_f32( vpadd_f32( sum, sum ), 0 );
+#else
+    float acc[4] {};
+    for ( size_t i = 0; i < count; i += 4 )
+    {
+        acc[0] += a[i + 0] * b[i + 0];
+        acc[1] += a[i + 1] * b[i + 1];
+        acc[2] += a[i + 2] * b[i + 2];
+        acc[3] += a[i + 3] * b[i + 3];
+    }
+    return ( acc[0] + acc[1] ) + ( acc[2] + acc[3] );
+#endif
+}
+}  // namespace
+
+const ma_data_source_vtable Resampler::vtable = {
+    &Resampler::onRead,
+    &Resampler::onSeek,
+    &Resampler::onGetDataFormat,
+    &Resampler::onGetCursor,
+    &Resampler::onGetLength,
+    &Resampler::onSetLooping,
+    // Looping is handled by the input data source.
+    MA_DATA_SOURCE_SELF_MANAGED_RANGE_AND_LOOP_POINT,
+};
+
+Resampler::Resampler( ma_engine* pEngine, ma_data_source* pDataSource )
+: input { pDataSource }
+{
+    ma_format format;
+    if ( ma_data_source_get_data_format( input, &format, &channels, &sampleRate, nullptr, 0 ) != MA_SUCCESS || format != ma_format_f32 )
+    {
+        std::cerr << "Failed to initialize resampler: the data source must produce 32-bit floating point samples." << std::endl;
+        channels   = 0;
+        sampleRate = ma_engine_get_sample_rate( pEngine );
+    }
+
+    baseRatio = static_cast<double>( sampleRate ) / ma_engine_get_sample_rate( pEngine );
+
+    ma_data_source_config config = ma_data_source_config_init();
+    config.vtable                = &vtable;
+
+    if ( ma_data_source_init( &config, &dataSource.base ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize resampler." << std::endl;
+    }
+    dataSource.resampler = this;
+
+    // The history must hold a full block at the highest rate ratio (and the kernel on either side).
+    capacity = static_cast<size_t>( BlockSize * MaxRatio ) + MaxTaps * 2;
+    history.resize( capacity * channels );
+    monoHistory.resize( capacity );
+    scratch.resize( capacity * channels );
+    lowRate.resize( BlockSize * channels );
+    lowRatePrevious.resize( channels );
+
+    // Make sure the tables are not built on the audio thread.
+    getSincTable( 8 );
+    getSincTable( MaxTaps );
+
+    reset();
+}
+
+Resampler::~Resampler()
+{
+    ma_data_source_uninit( &dataSource.base );
+}
+
+void Resampler::setPitch( float _pitch ) noexcept
+{
+    pitch.store( _pitch, std::memory_order_relaxed );
+}
+
+float Resampler::getPitch() const noexcept
+{
+    return pitch.load( std::memory_order_relaxed );
+}
+
+void Resampler::setQuality( Sound::ResampleQuality _quality ) noexcept
+{
+    quality.store( _quality, std::memory_order_relaxed );
+}
+
+Sound::ResampleQuality Resampler::getQuality() const noexcept
+{
+    return quality.load( std::memory_order_relaxed );
+}
+
+void Resampler::setLodDistances( float mono, float halfRate, float quarterRate ) noexcept
+{
+    monoDistance.store( mono, std::memory_order_relaxed );
+    halfRateDistance.store( halfRate, std::memory_order_relaxed );
+    quarterRateDistance.store( quarterRate, std::memory_order_relaxed );
+}
+
+void Resampler::getLodDistances( float& mono, float& halfRate, float& quarterRate ) const noexcept
+{
+    mono        = monoDistance.load( std::memory_order_relaxed );
+    halfRate    = halfRateDistance.load( std::memory_order_relaxed );
+    quarterRate = quarterRateDistance.load( std::memory_order_relaxed );
+}
+
+ma_result Resampler::onRead( ma_data_source* pDataSource, void* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead )
+{
+    return static_cast<DataSource*>( pDataSource )->resampler->read( static_cast<float*>( pFramesOut ), frameCount, pFramesRead );
+}
+
+ma_result Resampler::onSeek( ma_data_source* pDataSource, ma_uint64 frameIndex )
+{
+    return static_cast<DataSource*>( pDataSource )->resampler->seek( frameIndex );
+}
+
+ma_result Resampler::onGetDataFormat( ma_data_source* pDataSource, ma_format* pFormat, ma_uint32* pChannels, ma_uint32* pSampleRate, ma_channel* pChannelMap, size_t channelMapCap )
+{
+    const Resampler* resampler = static_cast<DataSource*>( pDataSource )->resampler;
+
+    // The sample rate of the input is reported so that the cursor and length (in frames of the input) can be converted to seconds.
+    return ma_data_source_get_data_format( resampler->input, pFormat, pChannels, pSampleRate, pChannelMap, channelMapCap );
+}
+
+ma_result Resampler::onGetCursor( ma_data_source* pDataSource, ma_uint64* pCursor )
+{
+    const Resampler* resampler = static_cast<DataSource*>( pDataSource )->resampler;
+
+    ma_uint64       cursor;
+    const ma_result result = ma_data_source_get_cursor_in_pcm_frames( resampler->input, &cursor );
+    if ( result != MA_SUCCESS )
+        return result;
+
+    // The input is read ahead of the frames that are played.
+    const ma_uint64 buffered = resampler->bufferedFrames.load( std::memory_order_relaxed );
+    if ( cursor >= buffered )
+    {
+        *pCursor = cursor - buffered;
+    }
+    else
+    {
+        // The input looped around.
+        ma_uint64 length = 0;
+        ma_data_source_get_length_in_pcm_frames( resampler->input, &length );
+        *pCursor = length + cursor >= buffered ? length + cursor - buffered : 0;
+    }
+
+    return MA_SUCCESS;
+}
+
+ma_result Resampler::onGetLength( ma_data_source* pDataSource, ma_uint64* pLength )
+{
+    return ma_data_source_get_length_in_pcm_frames( static_cast<DataSource*>( pDataSource )->resampler->input, pLength );
+}
+
+ma_result Resampler::onSetLooping( ma_data_source* pDataSource, ma_bool32 isLooping )
+{
+    return ma_data_source_set_looping( static_cast<DataSource*>( pDataSource )->resampler->input, isLooping );
+}
+
+ma_result Resampler::read( float* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead )
+{
+    // The doppler pitch is computed by the spatializer of the sound (on the audio thread).
+    // Sounds that are part of a cluster are not spatialized (and have no doppler).
+    const float                  doppler  = sound && ma_sound_is_spatialization_enabled( sound ) ? sound->engineNode.spatializer.dopplerPitch : 1.0f;
+    const double                 ratio    = std::clamp( baseRatio * pitch.load( std::memory_order_relaxed ) * doppler, MinRatio, MaxRatio );
+    const Sound::ResampleQuality _quality = quality.load( std::memory_order_relaxed );
+
+    // Select the level of detail from the distance to the listener.
+    const float distance = getListenerDistance();
+    const bool  mono     = distance >= monoDistance.load( std::memory_order_relaxed );
+    size_t      divisor  = 1;
+    if ( distance >= quarterRateDistance.load( std::memory_order_relaxed ) )
+        divisor = 4;
+    else if ( distance >= halfRateDistance.load( std::memory_order_relaxed ) )
+        divisor = 2;
+
+    // The reduced rate must not exceed the capacity of the history.
+    while ( divisor > 1 && ratio * static_cast<double>( divisor ) > MaxRatio )
+        divisor /= 2;
+
+    if ( divisor != rateDivisor )
+    {
+        rateDivisor = divisor;
+        resetUpsampler();
+    }
+
+    ma_uint64 totalFramesRead = 0;
+    while ( totalFramesRead < frameCount && channels > 0 )
+    {
+        const size_t count = static_cast<size_t>( std::min<ma_uint64>( frameCount - totalFramesRead, BlockSize ) );
+        float*       pOut  = pFramesOut + totalFramesRead * channels;
+
+        const size_t framesRendered = rateDivisor > 1 ? upsample( pOut, count, ratio, _quality, mono ) : render( pOut, count, ratio, _quality, mono );
+
+        totalFramesRead += framesRendered;
+
+        if ( framesRendered < count )
+            break;
+    }
+
+    const size_t played = static_cast<size_t>( position );
+    const size_t valid  = historyFrames - paddingFrames;
+    bufferedFrames.store( valid > played ? valid - played : 0, std::memory_order_relaxed );
+
+    *pFramesRead = totalFramesRead;
+
+    if ( totalFramesRead == 0 )
+        return atEnd ? MA_AT_END : MA_BUSY;
+
+    return MA_SUCCESS;
+}
+
+size_t Resampler::render( float* pFramesOut, size_t frameCount, double ratio, Sound::ResampleQuality _quality, bool mono )
+{
+    // The last frame of the block reads up to half of the widest kernel past its position.
+    const size_t required = static_cast<size_t>( position + static_cast<double>( frameCount - 1 ) * ratio ) + MaxTaps / 2 + 1;
+    fill( required );
+
+    // The input is not ready yet (a stream that is still being decoded).
+    if ( historyFrames < required )
+        return 0;
+
+    if ( atEnd )
+    {
+        // Stop at the last frame of the input.
+        const double end = static_cast<double>( historyFrames - paddingFrames );
+        if ( position >= end )
+            return 0;
+
+        frameCount = std::min( frameCount, static_cast<size_t>( std::ceil( ( end - position ) / ratio ) ) );
+    }
+
+    const float* in            = history.data();
+    size_t       inputChannels = channels;
+
+    if ( mono && channels > 1 )
+    {
+        // Downmix the frames that are read by the kernels, so they only run once.
+        const float scale = 1.0f / static_cast<float>( channels );
+        std::fill_n( monoHistory.data(), required, 0.0f );
+        for ( size_t c = 0; c < channels; ++c )
+        {
+            const float* h = history.data() + c * capacity;
+            for ( size_t i = 0; i < required; ++i )
+                monoHistory[i] += h[i] * scale;
+        }
+
+        in            = monoHistory.data();
+        inputChannels = 1;
+    }
+
+    if ( ratio == 1.0 && position == std::floor( position ) )
+    {
+        copy( in, inputChannels, pFramesOut, frameCount );
+    }
+    else
+    {
+        switch ( _quality )
+        {
+        case Sound::ResampleQuality::Fast:
+            resampleNearest( in, inputChannels, pFramesOut, frameCount, ratio );
+            break;
+        case Sound::ResampleQuality::Linear:
+            resampleLinear( in, inputChannels, pFramesOut, frameCount, ratio );
+            break;
+        case Sound::ResampleQuality::Sinc8:
+            resampleSinc( in, inputChannels, pFramesOut, frameCount, ratio, 8 );
+            break;
+        case Sound::ResampleQuality::Sinc32:
+            resampleSinc( in, inputChannels, pFramesOut, frameCount, ratio, 32 );
+            break;
+        }
+    }
+
+    if ( inputChannels < channels )
+    {
+        // Copy the mono mix to all channels.
+        for ( size_t i = 0; i < frameCount; ++i )
+            std::fill_n( pFramesOut + i * channels + 1, channels - 1, pFramesOut[i * channels] );
+    }
+
+    position += static_cast<double>( frameCount ) * ratio;
+
+    discard();
+
+    return frameCount;
+}
+
+size_t Resampler::upsample( float* pFramesOut, size_t frameCount, double ratio, Sound::ResampleQuality _quality, bool mono )
+{
+    const size_t divisor = rateDivisor;
+    const float  scale   = 1.0f / static_cast<float>( divisor );
+
+    for ( size_t i = 0; i < frameCount; ++i )
+    {
+        if ( lowRatePhase == 0 )
+        {
+            // Move on to the next frame at the reduced rate.
+            if ( lowRateIndex < lowRateFrames )
+                std::copy_n( lowRate.data() + lowRateIndex * channels, channels, lowRatePrevious.data() );
+
+            if ( ++lowRateIndex >= lowRateFrames )
+            {
+                // Only render the frames that are needed for this block, so the cursor does not run ahead.
+                const size_t count = std::min( ( frameCount - i + divisor - 1 ) / divisor, BlockSize );
+
+                lowRateFrames = render( lowRate.data(), count, ratio * static_cast<double>( divisor ), _quality, mono );
+                lowRateIndex  = 0;
+
+                if ( lowRateFrames == 0 )
+                    return i;
+
+                if ( !lowRatePrimed )
+                {
+                    std::copy_n( lowRate.data(), channels, lowRatePrevious.data() );
+                    lowRatePrimed = true;
+                }
+            }
+        }
+
+        // Linear interpolation between the previous and the current frame at the reduced rate.
+        const float  t       = static_cast<float>( lowRatePhase ) * scale;
+        const float* current = lowRate.data() + lowRateIndex * channels;
+        for ( size_t c = 0; c < channels; ++c )
+            pFramesOut[i * channels + c] = lowRatePrevious[c] + t * ( current[c] - lowRatePrevious[c] );
+
+        lowRatePhase = ( lowRatePhase + 1 ) % divisor;
+    }
+
+    return frameCount;
+}
+
+void Resampler::resetUpsampler()
+{
+    lowRateFrames = 0;
+    lowRateIndex  = 0;
+    lowRatePhase  = 0;
+    lowRatePrimed = false;
+}
+
+float Resampler::getListenerDistance() const
+{
+    // Only 3D sounds have a level of detail (this includes the sounds of a cluster).
+    if ( !sound || !spatialized )
+        return 0.0f;
+
+    ma_vec3f position = ma_sound_get_position( sound );
+
+    if ( ma_sound_get_positioning( sound ) == ma_positioning_absolute )
+    {
+        const ma_vec3f listener = ma_engine_listener_get_position( ma_sound_get_engine( sound ), ma_sound_get_listener_index( sound ) );
+        position.x -= listener.x;
+        position.y -= listener.y;
+        position.z -= listener.z;
+    }
+
+    return std::sqrt( position.x * position.x + position.y * position.y + position.z * position.z );
+}
+
+ma_result Resampler::seek( ma_uint64 frameIndex )
+{
+    const ma_result result = ma_data_source_seek_to_pcm_frame( input, frameIndex );
+    reset();
+    resetUpsampler();
+    return result;
+}
+
+void Resampler::reset()
+{
+    // Start with silence on the left side of the kernel.
+    for ( size_t c = 0; c < channels; ++c )
+        std::fill_n( history.data() + c * capacity, Lead, 0.0f );
+
+    historyFrames = Lead;
+    paddingFrames = 0;
+    atEnd         = false;
+    position      = static_cast<double>( Lead );
+    bufferedFrames.store( 0, std::memory_order_relaxed );
+}
+
+void Resampler::fill( size_t frameCount )
+{
+    frameCount = std::min( frameCount, capacity );
+
+    while ( historyFrames < frameCount && !atEnd )
+    {
+        ma_uint64       framesRead = 0;
+        const ma_result result     = ma_data_source_read_pcm_frames( input, scratch.data(), frameCount - historyFrames, &framesRead );
+
+        // Deinterleave the input into the history.
+        for ( size_t c = 0; c < channels; ++c )
+        {
+            float*       dst = history.data() + c * capacity + historyFrames;
+            const float* src = scratch.data() + c;
+            for ( size_t i = 0; i < framesRead; ++i )
+                dst[i] = src[i * channels];
+        }
+        historyFrames += static_cast<size_t>( framesRead );
+
+        if ( result == MA_AT_END || ( result == MA_SUCCESS && framesRead == 0 ) )
+            atEnd = true;
+        else if ( framesRead == 0 )
+            return;  // Busy (or failed), try again on the next read.
+    }
+
+    if ( atEnd && historyFrames < frameCount )
+    {
+        // The kernel reads silence after the end of the input.
+        for ( size_t c = 0; c < channels; ++c )
+            std::fill( history.data() + c * capacity + historyFrames, history.data() + c * capacity + frameCount, 0.0f );
+
+        paddingFrames += frameCount - historyFrames;
+        historyFrames = frameCount;
+    }
+}
+
+void Resampler::discard()
+{
+    const size_t drop = static_cast<size_t>( position ) - Lead;
+    if ( drop == 0 )
+        return;
+
+    for ( size_t c = 0; c < channels; ++c )
+    {
+        float* h = history.data() + c * capacity;
+        std::copy( h + drop, h + historyFrames, h );
+    }
+
+    const size_t valid = historyFrames - paddingFrames;
+    if ( drop > valid )
+        paddingFrames -= drop - valid;
+
+    historyFrames -= drop;
+    position -= static_cast<double>( drop );
+}
+
+void Resampler::resampleNearest( const float* in, size_t inputChannels, float* pFramesOut, size_t frameCount, double ratio ) const
+{
+    size_t index[BlockSize];
+    for ( size_t i = 0; i < frameCount; ++i )
+        index[i] = static_cast<size_t>( position + static_cast<double>( i ) * ratio + 0.5 );
+
+    for ( size_t c = 0; c < inputChannels; ++c )
+    {
+        const float* h   = in + c * capacity;
+        float*       out = pFramesOut + c;
+        for ( size_t i = 0; i < frameCount; ++i )
+            out[i * channels] = h[index[i]];
+    }
+}
+
+void Resampler::resampleLinear( const float* in, size_t inputChannels, float* pFramesOut, size_t frameCount, double ratio ) const
+{
+    // Compute the positions once for all channels.
+    size_t index[BlockSize];
+    float  fraction[BlockSize];
+    for ( size_t i = 0; i < frameCount; ++i )
+    {
+        const double p = position + static_cast<double>( i ) * ratio;
+        index[i]       = static_cast<size_t>( p );
+        fraction[i]    = static_cast<float>( p - static_cast<double>( index[i] ) );
+    }
+
+    for ( size_t c = 0; c < inputChannels; ++c )
+    {
+        const float* h   = in + c * capacity;
+        float*       out = pFramesOut + c;
+        for ( size_t i = 0; i < frameCount; ++i )
+        {
+            const float a     = h[index[i]];
+            const float b     = h[index[i] + 1];
+            out[i * channels] = a + fraction[i] * ( b - a );
+        }
+    }
+}
+
+void Resampler::resampleSinc( const float* in, size_t inputChannels, float* pFramesOut, size_t frameCount, double ratio, size_t taps ) const
+{
+    const SincTable& table = getSincTable( taps );
+
+    alignas( 16 ) float kernel[MaxTaps];
+
+    for ( size_t i = 0; i < frameCount; ++i )
+    {
+        const double p     = position + static_cast<double>( i ) * ratio;
+        const size_t index = static_cast<size_t>( p );
+
+        // Interpolate between the two nearest phases of the table.
+        const float  phase = static_cast<float>( p - static_cast<double>( index ) ) * Phases;
+        const size_t row   = std::min( static_cast<size_t>( phase ), Phases - 1 );
+        const float  t     = phase - static_cast<float>( row );
+        const float* k0    = table.coefficients.data() + row * taps;
+        const float* k1    = k0 + taps;
+        for ( size_t k = 0; k < taps; ++k )
+            kernel[k] = k0[k] + t * ( k1[k] - k0[k] );
+
+        // The first tap is `taps / 2 - 1` frames before the read position.
+        const size_t first = index + 1 - taps / 2;
+        for ( size_t c = 0; c < inputChannels; ++c )
+            pFramesOut[i * channels + c] = dot( in + c * capacity + first, kernel, taps );
+    }
+}
+
+void Resampler::copy( const float* in, size_t inputChannels, float* pFramesOut, size_t frameCount ) const
+{
+    const size_t first = static_cast<size_t>( position );
+
+    for ( size_t c = 0; c < inputChannels; ++c )
+    {
+        const float* h   = in + c * capacity + first;
+        float*       out = pFramesOut + c;
+        for ( size_t i = 0; i < frameCount; ++i )
+            out[i * channels] = h[i];
+    }
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <Audio/Sound.hpp>
+
+#include "miniaudio.h"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// A data source that resamples (and pitch shifts) another data source.
+/// </summary>
+/// <remarks>
+/// The engine resamples every pitched sound one frame (and one channel) at a time. This resampler
+/// is used instead (the sound is initialized with `MA_SOUND_FLAG_NO_PITCH`): the input is
+/// deinterleaved into a history buffer and resampled in blocks, so the interpolation kernels are
+/// contiguous multiply-adds that run on SIMD registers.
+/// The rate ratio is the product of the pitch, the doppler pitch of the sound, and the ratio
+/// between the sample rate of the data source and the sample rate of the engine.
+///
+/// Distant 3D sounds use a cheaper level of detail: beyond the LOD distances the input is
+/// downmixed to mono before it is resampled, and/or it is resampled at half or a quarter of
+/// the engine rate and linearly upsampled to the engine rate.
+/// </remarks>
+class Resampler
+{
+public:
+    /// <summary>
+    /// Create a resampler.
+    /// </summary>
+    /// <param name="pEngine">The engine that plays the resampled data source.</param>
+    /// <param name="pDataSource">The data source to resample. The resampler does not take ownership.</param>
+    Resampler( ma_engine* pEngine, ma_data_source* pDataSource );
+    ~Resampler();
+
+    Resampler( const Resampler& )            = delete;
+    Resampler( Resampler&& )                 = delete;
+    Resampler& operator=( const Resampler& ) = delete;
+    Resampler& operator=( Resampler&& )      = delete;
+
+    ma_data_source* getDataSource() noexcept
+    {
+        return &dataSource.base;
+    }
+
+    /// <summary>
+    /// Set the sound that plays the resampled data source.
+    /// The doppler pitch of the sound is applied to the rate ratio.
+    /// </summary>
+    void setSound( ma_sound* pSound ) noexcept
+    {
+        sound       = pSound;
+        spatialized = pSound && ma_sound_is_spatialization_enabled( pSound );
+    }
+
+    void  setPitch( float pitch ) noexcept;
+    float getPitch() const noexcept;
+
+    void                   setQuality( Sound::ResampleQuality quality ) noexcept;
+    Sound::ResampleQuality getQuality() const noexcept;
+
+    void setLodDistances( float mono, float halfRate, float quarterRate ) noexcept;
+    void getLodDistances( float& mono, float& halfRate, float& quarterRate ) const noexcept;
+
+    // Rate ratios are clamped to this range.
+    static constexpr double MinRatio = 1.0 / 64.0;
+    static constexpr double MaxRatio = 8.0;
+
+    // The number of frames that are resampled at a time.
+    static constexpr size_t BlockSize = 256;
+
+    // The number of taps of the widest interpolation kernel.
+    static constexpr size_t MaxTaps = 32;
+
+private:
+    // The data source base must be the first member so the callbacks can find the resampler.
+    struct DataSource
+    {
+        ma_data_source_base base;
+        Resampler*          resampler;
+    };
+
+    static ma_result onRead( ma_data_source* pDataSource, void* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead );
+    static ma_result onSeek( ma_data_source* pDataSource, ma_uint64 frameIndex );
+    static ma_result onGetDataFormat( ma_data_source* pDataSource, ma_format* pFormat, ma_uint32* pChannels, ma_uint32* pSampleRate, ma_channel* pChannelMap, size_t channelMapCap );
+    static ma_result onGetCursor( ma_data_source* pDataSource, ma_uint64* pCursor );
+    static ma_result onGetLength( ma_data_source* pDataSource, ma_uint64* pLength );
+    static ma_result onSetLooping( ma_data_source* pDataSource, ma_bool32 isLooping );
+
+    static const ma_data_source_vtable vtable;
+
+    ma_result read( float* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead );
+    ma_result seek( ma_uint64 frameIndex );
+
+    // Clear the history (and restart at the current position of the input).
+    void reset();
+
+    // Resample up to `frameCount` (at most `BlockSize`) frames at `ratio`.
+    // Returns the number of frames that were resampled.
+    size_t render( float* pFramesOut, size_t frameCount, double ratio, Sound::ResampleQuality quality, bool mono );
+
+    // Render at the reduced rate and upsample to the engine rate.
+    size_t upsample( float* pFramesOut, size_t frameCount, double ratio, Sound::ResampleQuality quality, bool mono );
+    void   resetUpsampler();
+
+    // The distance between the sound and its listener (0 if the sound is not spatialized).
+    float getListenerDistance() const;
+
+    // Read from the input until the history contains `frameCount` frames.
+    void fill( size_t frameCount );
+
+    // Remove the frames that are no longer needed from the front of the history.
+    void discard();
+
+    // Resample `frameCount` frames at `ratio` starting at the current position.
+    // `in` points to `inputChannels` deinterleaved channels of history.
+    void resampleNearest( const float* in, size_t inputChannels, float* pFramesOut, size_t frameCount, double ratio ) const;
+    void resampleLinear( const float* in, size_t inputChannels, float* pFramesOut, size_t frameCount, double ratio ) const;
+    void resampleSinc( const float* in, size_t inputChannels, float* pFramesOut, size_t frameCount, double ratio, size_t taps ) const;
+    void copy( const float* in, size_t inputChannels, float* pFramesOut, size_t frameCount ) const;
+
+    DataSource      dataSource {};
+    ma_data_source* input       = nullptr;
+    ma_sound*       sound       = nullptr;
+    bool            spatialized = false;
+    ma_uint32       channels;
+    ma_uint32       sampleRate;
+    double          baseRatio;
+
+    std::atomic<float>                  pitch { 1.0f };
+    std::atomic<Sound::ResampleQuality> quality { Sound::ResampleQuality::Linear };
+
+    // Deinterleaved input history. Each channel has `capacity` frames.
+    std::vector<float> history;
+    size_t             capacity;
+    size_t             historyFrames = 0;
+    // Silence that was appended after the end of the input.
+    size_t             paddingFrames = 0;
+    bool               atEnd         = false;
+    // The read position (in history frames).
+    double             position      = 0.0;
+
+    // The mono downmix of the history (for the mono level of detail).
+    std::vector<float> monoHistory;
+
+    // Interleaved frames read from the input.
+    std::vector<float> scratch;
+
+    // Level of detail. The distances are in world units; beyond each distance the cheaper level is used.
+    std::atomic<float> monoDistance { std::numeric_limits<float>::infinity() };
+    std::atomic<float> halfRateDistance { std::numeric_limits<float>::infinity() };
+    std::atomic<float> quarterRateDistance { std::numeric_limits<float>::infinity() };
+
+    // Frames at the reduced rate (1/rateDivisor of the engine rate) that are upsampled to the engine rate.
+    size_t             rateDivisor = 1;
+    std::vector<float> lowRate;
+    std::vector<float> lowRatePrevious;
+    size_t             lowRateFrames = 0;
+    size_t             lowRateIndex  = 0;
+    size_t             lowRatePhase  = 0;
+    bool               lowRatePrimed = false;
+
+    // The number of input frames that were read but not yet played (for the cursor).
+    std::atomic<ma_uint64> bufferedFrames { 0 };
+};
+}  // namespace Audio
@@ -0,0 +1,75 @@
+#include <Audio/Device.hpp>
+#include <Audio/Reverb.hpp>
+
+#include "ReverbImpl.hpp"
+
+using namespace Audio;
+
+Reverb::Reverb( float roomSize, float decayTime )
+{
+    *this = Device::createReverb( roomSize, decayTime );
+}
+
+Reverb::Reverb( std::shared_ptr<EffectImpl> impl )
+: Effect( std::move( impl ) )
+{}
+
+void Reverb::setRoomSize( float roomSize )
+{
+    std::static_pointer_cast<ReverbImpl>( get() )->setRoomSize( roomSize );
+}
+
+float Reverb::getRoomSize() const
+{
+    return std::static_pointer_cast<ReverbImpl>( get() )->getRoomSize();
+}
+
+void Reverb::setDecayTime( float decayTime )
+{
+    std::static_pointer_cast<ReverbImpl>( get() )->setDecayTime( decayTime );
+}
+
+float Reverb::getDecayTime() const
+{
+    return std::static_pointer_cast<ReverbImpl>( get() )->getDecayTime();
+}
+
+void Reverb::setDamping( float damping )
+{
+    std::static_pointer_cast<ReverbImpl>( get() )->setDamping( damping );
+}
+
+float Reverb::getDamping() const
+{
+    return std::static_pointer_cast<ReverbImpl>( get() )->getDamping();
+}
+
+void Reverb::setPreDelay( float preDelay )
+{
+    std::static_pointer_cast<ReverbImpl>( get() )->setPreDelay( preDelay );
+}
+
+float Reverb::getPreDelay() const
+{
+    return std::static_pointer_cast<ReverbImpl>( get() )->getPreDelay();
+}
+
+void Reverb::setWet( float wet )
+{
+    std::static_pointer_cast<ReverbImpl>( get() )->setWet( wet );
+}
+
+float Reverb::getWet() const
+{
+    return std::static_pointer_cast<ReverbImpl>( get() )->getWet();
+}
+
+void Reverb::setDry( float dry )
+{
+    std::static_pointer_cast<ReverbImpl>( get() )->setDry( dry );
+}
+
+float Reverb::getDry() const
+{
+    return std::static_pointer_cast<ReverbImpl>( get() )->getDry();
+}
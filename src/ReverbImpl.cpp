@@ -0,0 +1,226 @@
+#include "ReverbImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+// Mutually prime delay line lengths (in seconds) for the largest room.
+static constexpr float LineLengths[] = { 0.0313f, 0.0379f, 0.0411f, 0.0473f, 0.0537f, 0.0593f, 0.0671f, 0.0739f };
+
+static size_t NextPowerOfTwo( size_t n )
+{
+    size_t p = 1;
+    while ( p < n )
+        p *= 2;
+    return p;
+}
+
+/// <summary>
+/// In-place fast Walsh-Hadamard transform of 8 values, normalized to preserve energy.
+/// </summary>
+static inline void Hadamard8( float* v )
+{
+    for ( size_t h = 1; h < 8; h *= 2 )
+    {
+        for ( size_t i = 0; i < 8; i += h * 2 )
+        {
+            for ( size_t j = i; j < i + h; ++j )
+            {
+                const float a = v[j];
+                const float b = v[j + h];
+                v[j]          = a + b;
+                v[j + h]      = a - b;
+            }
+        }
+    }
+
+    constexpr float scale = 0.35355339059327376f;  // 1 / sqrt(8)
+    for ( size_t i = 0; i < 8; ++i )
+        v[i] *= scale;
+}
+
+ReverbImpl::ReverbImpl( std::shared_ptr<DeviceImpl> device, float _roomSize, float _decayTime, ma_engine* pEngine )
+: CustomEffectImpl( std::move( device ), pEngine, 1, MA_NODE_FLAG_CONTINUOUS_PROCESSING )
+, roomSize { std::clamp( _roomSize, 0.0f, 1.0f ) }
+, decayTime { std::max( _decayTime, 0.01f ) }
+{
+    if ( !isInitialized() )
+        return;
+
+    // Allocate the delay lines for the largest room, so changing the parameters never allocates.
+    const size_t maxDelay = static_cast<size_t>( LineLengths[lineCount - 1] * static_cast<float>( sampleRate ) ) + 1;
+    lineMask              = NextPowerOfTwo( maxDelay ) - 1;
+    lines.resize( ( lineMask + 1 ) * lineCount );
+
+    const size_t maxPreDelayFrames = static_cast<size_t>( maxPreDelay * static_cast<float>( sampleRate ) ) + 1;
+    preDelayMask                   = NextPowerOfTwo( maxPreDelayFrames ) - 1;
+    preDelayLine.resize( preDelayMask + 1 );
+
+    // Rows 1..7 of the Hadamard matrix are orthogonal, so every channel gets a decorrelated mix of the lines.
+    outputGain.resize( channels * lineCount );
+    for ( ma_uint32 c = 0; c < channels; ++c )
+    {
+        const size_t row = c % ( lineCount - 1 ) + 1;
+        for ( size_t i = 0; i < lineCount; ++i )
+        {
+            // The sign of H[row][i] is the parity of the number of common bits.
+            size_t bits = row & i;
+            int    sign = 1;
+            while ( bits )
+            {
+                sign = -sign;
+                bits &= bits - 1;
+            }
+            outputGain[c * lineCount + i] = static_cast<float>( sign ) * 0.5f;
+        }
+    }
+}
+
+ReverbImpl::~ReverbImpl()
+{
+    uninit();
+}
+
+void ReverbImpl::setRoomSize( float _roomSize ) noexcept
+{
+    roomSize.store( std::clamp( _roomSize, 0.0f, 1.0f ), std::memory_order_relaxed );
+    version.fetch_add( 1, std::memory_order_release );
+}
+
+float ReverbImpl::getRoomSize() const noexcept
+{
+    return roomSize.load( std::memory_order_relaxed );
+}
+
+void ReverbImpl::setDecayTime( float _decayTime ) noexcept
+{
+    decayTime.store( std::max( _decayTime, 0.01f ), std::memory_order_relaxed );
+    version.fetch_add( 1, std::memory_order_release );
+}
+
+float ReverbImpl::getDecayTime() const noexcept
+{
+    return decayTime.load( std::memory_order_relaxed );
+}
+
+void ReverbImpl::setDamping( float _damping ) noexcept
+{
+    damping.store( std::clamp( _damping, 0.0f, 1.0f ), std::memory_order_relaxed );
+    version.fetch_add( 1, std::memory_order_release );
+}
+
+float ReverbImpl::getDamping() const noexcept
+{
+    return damping.load( std::memory_order_relaxed );
+}
+
+void ReverbImpl::setPreDelay( float _preDelay ) noexcept
+{
+    preDelay.store( std::clamp( _preDelay, 0.0f, maxPreDelay ), std::memory_order_relaxed );
+    version.fetch_add( 1, std::memory_order_release );
+}
+
+float ReverbImpl::getPreDelay() const noexcept
+{
+    return preDelay.load( std::memory_order_relaxed );
+}
+
+void ReverbImpl::setWet( float _wet ) noexcept
+{
+    wet.store( _wet, std::memory_order_relaxed );
+}
+
+float ReverbImpl::getWet() const noexcept
+{
+    return wet.load( std::memory_order_relaxed );
+}
+
+void ReverbImpl::setDry( float _dry ) noexcept
+{
+    dry.store( _dry, std::memory_order_relaxed );
+}
+
+float ReverbImpl::getDry() const noexcept
+{
+    return dry.load( std::memory_order_relaxed );
+}
+
+void ReverbImpl::update()
+{
+    const float size  = 0.25f + 0.75f * roomSize.load( std::memory_order_relaxed );
+    const float decay = decayTime.load( std::memory_order_relaxed );
+    const float rate  = static_cast<float>( sampleRate );
+
+    for ( size_t i = 0; i < lineCount; ++i )
+    {
+        delay[i] = std::clamp<size_t>( static_cast<size_t>( LineLengths[i] * size * rate ), 1, lineMask );
+        // Each pass through a line must attenuate by the fraction of 60 dB that matches the length of the line.
+        gain[i] = std::pow( 10.0f, -3.0f * static_cast<float>( delay[i] ) / ( decay * rate ) );
+    }
+
+    dampingCoefficient = 0.95f * damping.load( std::memory_order_relaxed );
+    preDelayFrames     = std::min( static_cast<size_t>( preDelay.load( std::memory_order_relaxed ) * rate ), preDelayMask );
+}
+
+void ReverbImpl::process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount )
+{
+    const uint32_t v = version.load( std::memory_order_acquire );
+    if ( v != currentVersion )
+    {
+        update();
+        currentVersion = v;
+    }
+
+    const float* in        = ppFramesIn[0];
+    const float  wetMix    = wet.load( std::memory_order_relaxed );
+    const float  dryMix    = dry.load( std::memory_order_relaxed );
+    const float  inputGain = 1.0f / static_cast<float>( channels );
+    const float  d         = dampingCoefficient;
+
+    float out[lineCount];
+    float feedback[lineCount];
+
+    for ( ma_uint32 f = 0; f < frameCount; ++f )
+    {
+        const float* frameIn  = in + f * channels;
+        float*       frameOut = pFramesOut + f * channels;
+
+        // The reverb is fed with the mono mix of the input.
+        float mono = 0.0f;
+        for ( ma_uint32 c = 0; c < channels; ++c )
+            mono += frameIn[c];
+
+        preDelayLine[preDelayPos] = mono * inputGain;
+        const float x             = preDelayLine[( preDelayPos - preDelayFrames ) & preDelayMask];
+        preDelayPos               = ( preDelayPos + 1 ) & preDelayMask;
+
+        for ( size_t i = 0; i < lineCount; ++i )
+            out[i] = lines[( ( linePos - delay[i] ) & lineMask ) * lineCount + i];
+
+        // Damping (one-pole low-pass) and decay in the feedback path.
+        for ( size_t i = 0; i < lineCount; ++i )
+        {
+            lowPass[i]  = out[i] + d * ( lowPass[i] - out[i] );
+            feedback[i] = lowPass[i] * gain[i];
+        }
+
+        Hadamard8( feedback );
+
+        float* write = lines.data() + linePos * lineCount;
+        for ( size_t i = 0; i < lineCount; ++i )
+            write[i] = feedback[i] + ( i & 1 ? -x : x );
+
+        linePos = ( linePos + 1 ) & lineMask;
+
+        for ( ma_uint32 c = 0; c < channels; ++c )
+        {
+            const float* g      = outputGain.data() + c * lineCount;
+            float        reverb = 0.0f;
+            for ( size_t i = 0; i < lineCount; ++i )
+                reverb += g[i] * out[i];
+
+            frameOut[c] = dryMix * frameIn[c] + wetMix * reverb;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "EffectImpl.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace Audio
+{
+class ReverbImpl : public CustomEffectImpl
+{
+public:
+    ReverbImpl( std::shared_ptr<DeviceImpl> device, float roomSize, float decayTime, ma_engine* pEngine );
+    ~ReverbImpl() override;
+
+    void  setRoomSize( float roomSize ) noexcept;
+    float getRoomSize() const noexcept;
+
+    void  setDecayTime( float decayTime ) noexcept;
+    float getDecayTime() const noexcept;
+
+    void  setDamping( float damping ) noexcept;
+    float getDamping() const noexcept;
+
+    void  setPreDelay( float preDelay ) noexcept;
+    float getPreDelay() const noexcept;
+
+    void  setWet( float wet ) noexcept;
+    float getWet() const noexcept;
+
+    void  setDry( float dry ) noexcept;
+    float getDry() const noexcept;
+
+protected:
+    void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) override;
+
+private:
+    // The number of delay lines in the feedback delay network.
+    static constexpr size_t lineCount = 8;
+    // The maximum pre-delay (in seconds).
+    static constexpr float maxPreDelay = 0.25f;
+
+    // Recompute the delay lengths and filter coefficients (on the audio thread) after a parameter changed.
+    void update();
+
+    // Parameters (written by the game thread).
+    std::atomic<float>    roomSize;
+    std::atomic<float>    decayTime;
+    std::atomic<float>    damping { 0.5f };
+    std::atomic<float>    preDelay { 0.02f };
+    std::atomic<float>    wet { 0.5f };
+    std::atomic<float>    dry { 1.0f };
+    std::atomic<uint32_t> version { 1 };
+
+    // Derived state (only used on the audio thread).
+    uint32_t currentVersion = 0;
+    size_t   delay[lineCount] {};
+    float    gain[lineCount] {};
+    float    lowPass[lineCount] {};
+    float    dampingCoefficient = 0.0f;
+    size_t   preDelayFrames     = 0;
+
+    // The delay lines are interleaved (8 floats per frame) so that all lines are written with a single vector store.
+    std::vector<float> lines;
+    size_t             lineMask = 0;
+    size_t             linePos  = 0;
+
+    std::vector<float> preDelayLine;
+    size_t             preDelayMask = 0;
+    size_t             preDelayPos  = 0;
+
+    // Output gains for each channel (a row of the Hadamard matrix per channel).
+    std::vector<float> outputGain;
+};
+}  // namespace Audio
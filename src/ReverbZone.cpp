@@ -0,0 +1,92 @@
+#include <Audio/ReverbZone.hpp>
+
+#include "ReverbZoneImpl.hpp"
+
+using namespace Audio;
+
+ReverbZone::ReverbZone( std::shared_ptr<ReverbZoneImpl> impl )
+: impl { std::move( impl ) }
+{}
+
+ReverbZone::ReverbZone()                                   = default;
+ReverbZone::~ReverbZone()                                  = default;
+ReverbZone::ReverbZone( const ReverbZone& )                = default;
+ReverbZone::ReverbZone( ReverbZone&& ) noexcept            = default;
+ReverbZone& ReverbZone::operator=( const ReverbZone& )     = default;
+ReverbZone& ReverbZone::operator=( ReverbZone&& ) noexcept = default;
+
+ReverbZone& ReverbZone::operator=( nullptr_t ) noexcept
+{
+    impl = nullptr;
+    return *this;
+}
+
+bool ReverbZone::operator==( nullptr_t ) const noexcept
+{
+    return impl == nullptr;
+}
+
+bool ReverbZone::operator!=( nullptr_t ) const noexcept
+{
+    return impl != nullptr;
+}
+
+void ReverbZone::setBox( const Vector& center, const Vector& halfExtents )
+{
+    impl->setBox( { center.x, center.y, center.z }, { halfExtents.x, halfExtents.y, halfExtents.z } );
+}
+
+void ReverbZone::setSphere( const Vector& center, float radius )
+{
+    impl->setSphere( { center.x, center.y, center.z }, radius );
+}
+
+ReverbZone::Shape ReverbZone::getShape() const
+{
+    return impl->getShape();
+}
+
+void ReverbZone::setFadeDistance( float fadeDistance )
+{
+    impl->setFadeDistance( fadeDistance );
+}
+
+float ReverbZone::getFadeDistance() const
+{
+    return impl->getFadeDistance();
+}
+
+void ReverbZone::setSendLevel( float level )
+{
+    impl->setSendLevel( level );
+}
+
+float ReverbZone::getSendLevel() const
+{
+    return impl->getSendLevel();
+}
+
+void ReverbZone::setReverb( float decayTime, float damping )
+{
+    impl->setReverb( decayTime, damping );
+}
+
+float ReverbZone::getWeight( const Vector& position ) const
+{
+    return impl->getWeight( { position.x, position.y, position.z } );
+}
+
+ReverbZone::operator bool() const noexcept
+{
+    return impl != nullptr;
+}
+
+std::shared_ptr<ReverbZoneImpl> ReverbZone::get() const noexcept
+{
+    return impl;
+}
+
+void ReverbZone::reset() noexcept
+{
+    impl.reset();
+}
@@ -0,0 +1,372 @@
+#include "ReverbZoneImpl.hpp"
+#include "BusImpl.hpp"
+#include "ReverbImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+using namespace Audio;
+
+namespace
+{
+// The zones are created and updated by the game (but the buses can be destroyed from any thread).
+std::mutex& GetMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<ReverbZoneImpl*>& GetZones()
+{
+    static std::vector<ReverbZoneImpl*> zones;
+    return zones;
+}
+
+// The buses that have zone sends enabled.
+std::vector<BusImpl*>& GetSources()
+{
+    static std::vector<BusImpl*> sources;
+    return sources;
+}
+
+// The reverb buses that were driven by the last update.
+std::vector<std::shared_ptr<BusImpl>>& GetDrivenBuses()
+{
+    static std::vector<std::shared_ptr<BusImpl>> buses;
+    return buses;
+}
+
+// The zones sorted into a uniform grid (by their bounds, including the fade distance).
+struct Grid
+{
+    std::unordered_map<uint64_t, std::vector<ReverbZoneImpl*>> cells;
+    std::vector<ReverbZoneImpl*>                               large;
+    bool                                                       dirty = true;
+};
+
+Grid& GetGrid()
+{
+    static Grid grid;
+    return grid;
+}
+
+int32_t GetCell( float p ) noexcept
+{
+    return static_cast<int32_t>( std::clamp( std::floor( static_cast<double>( p ) / ReverbZoneImpl::CellSize ), -1048576.0, 1048575.0 ) );
+}
+
+uint64_t GetKey( int32_t x, int32_t y, int32_t z ) noexcept
+{
+    // 21 bits per coordinate (like the emitter grid).
+    constexpr uint64_t mask = ( 1u << 21 ) - 1;
+    return ( ( static_cast<uint64_t>( x ) & mask ) << 42 ) | ( ( static_cast<uint64_t>( y ) & mask ) << 21 ) | ( static_cast<uint64_t>( z ) & mask );
+}
+}  // namespace
+
+ReverbZoneImpl::ReverbZoneImpl( std::shared_ptr<BusImpl> _bus, std::shared_ptr<ReverbImpl> _reverb )
+: bus { std::move( _bus ) }
+, reverb { std::move( _reverb ) }
+{
+    std::lock_guard lock { GetMutex() };
+
+    GetZones().push_back( this );
+    GetGrid().dirty = true;
+}
+
+ReverbZoneImpl::~ReverbZoneImpl()
+{
+    std::lock_guard lock { GetMutex() };
+
+    auto&      zones = GetZones();
+    const auto iter  = std::find( zones.begin(), zones.end(), this );
+    if ( iter != zones.end() )
+        zones.erase( iter );
+
+    GetGrid().dirty = true;
+}
+
+void ReverbZoneImpl::setBox( const ma_vec3f& _center, const ma_vec3f& _halfExtents )
+{
+    std::lock_guard lock { GetMutex() };
+
+    shape       = ReverbZone::Shape::Box;
+    center      = _center;
+    halfExtents = { std::abs( _halfExtents.x ), std::abs( _halfExtents.y ), std::abs( _halfExtents.z ) };
+
+    GetGrid().dirty = true;
+}
+
+void ReverbZoneImpl::setSphere( const ma_vec3f& _center, float _radius )
+{
+    std::lock_guard lock { GetMutex() };
+
+    shape  = ReverbZone::Shape::Sphere;
+    center = _center;
+    radius = std::abs( _radius );
+
+    GetGrid().dirty = true;
+}
+
+ReverbZone::Shape ReverbZoneImpl::getShape() const
+{
+    std::lock_guard lock { GetMutex() };
+    return shape;
+}
+
+void ReverbZoneImpl::setFadeDistance( float _fadeDistance )
+{
+    std::lock_guard lock { GetMutex() };
+
+    fadeDistance = std::max( _fadeDistance, 0.0f );
+
+    GetGrid().dirty = true;
+}
+
+float ReverbZoneImpl::getFadeDistance() const
+{
+    std::lock_guard lock { GetMutex() };
+    return fadeDistance;
+}
+
+void ReverbZoneImpl::setSendLevel( float level )
+{
+    std::lock_guard lock { GetMutex() };
+    sendLevel = std::max( level, 0.0f );
+}
+
+float ReverbZoneImpl::getSendLevel() const
+{
+    std::lock_guard lock { GetMutex() };
+    return sendLevel;
+}
+
+void ReverbZoneImpl::setReverb( float _decayTime, float _damping )
+{
+    std::lock_guard lock { GetMutex() };
+
+    hasReverb = true;
+    decayTime = _decayTime;
+    damping   = _damping;
+}
+
+float ReverbZoneImpl::getWeight( const ma_vec3f& position ) const
+{
+    std::lock_guard lock { GetMutex() };
+    return computeWeight( position );
+}
+
+float ReverbZoneImpl::computeWeight( const ma_vec3f& position ) const noexcept
+{
+    const float x = position.x - center.x;
+    const float y = position.y - center.y;
+    const float z = position.z - center.z;
+
+    // The distance from the position to the zone (0 inside of the zone).
+    float distance = 0.0f;
+    if ( shape == ReverbZone::Shape::Box )
+    {
+        const float dx = std::max( std::abs( x ) - halfExtents.x, 0.0f );
+        const float dy = std::max( std::abs( y ) - halfExtents.y, 0.0f );
+        const float dz = std::max( std::abs( z ) - halfExtents.z, 0.0f );
+        distance       = std::sqrt( dx * dx + dy * dy + dz * dz );
+    }
+    else
+    {
+        distance = std::max( std::sqrt( x * x + y * y + z * z ) - radius, 0.0f );
+    }
+
+    if ( distance <= 0.0f )
+        return 1.0f;
+
+    return fadeDistance > 0.0f ? std::max( 1.0f - distance / fadeDistance, 0.0f ) : 0.0f;
+}
+
+void ReverbZoneImpl::getBounds( ma_vec3f& min, ma_vec3f& max ) const noexcept
+{
+    const ma_vec3f extents = shape == ReverbZone::Shape::Box ? halfExtents : ma_vec3f { radius, radius, radius };
+
+    min = { center.x - extents.x - fadeDistance, center.y - extents.y - fadeDistance, center.z - extents.z - fadeDistance };
+    max = { center.x + extents.x + fadeDistance, center.y + extents.y + fadeDistance, center.z + extents.z + fadeDistance };
+}
+
+void ReverbZoneImpl::addSource( BusImpl* source )
+{
+    std::lock_guard lock { GetMutex() };
+
+    auto& sources = GetSources();
+    if ( std::find( sources.begin(), sources.end(), source ) == sources.end() )
+        sources.push_back( source );
+}
+
+void ReverbZoneImpl::removeSource( BusImpl* source )
+{
+    std::lock_guard lock { GetMutex() };
+
+    auto&      sources = GetSources();
+    const auto iter    = std::find( sources.begin(), sources.end(), source );
+    if ( iter != sources.end() )
+        sources.erase( iter );
+}
+
+std::vector<std::shared_ptr<BusImpl>> ReverbZoneImpl::getTargets()
+{
+    std::lock_guard lock { GetMutex() };
+
+    auto targets = GetDrivenBuses();
+    for ( const ReverbZoneImpl* zone: GetZones() )
+    {
+        if ( std::find( targets.begin(), targets.end(), zone->bus ) == targets.end() )
+            targets.push_back( zone->bus );
+    }
+
+    return targets;
+}
+
+void ReverbZoneImpl::updateAll( ma_engine* pEngine )
+{
+    // The reverb buses that are no longer driven by a zone are released after unlocking (destroying a bus takes the lock).
+    std::vector<std::shared_ptr<BusImpl>> released;
+
+    std::lock_guard lock { GetMutex() };
+
+    auto& grid  = GetGrid();
+    auto& zones = GetZones();
+
+    if ( grid.dirty )
+    {
+        grid.cells.clear();
+        grid.large.clear();
+
+        for ( ReverbZoneImpl* zone: zones )
+        {
+            ma_vec3f min, max;
+            zone->getBounds( min, max );
+
+            const int32_t minX = GetCell( min.x ), minY = GetCell( min.y ), minZ = GetCell( min.z );
+            const int32_t maxX = GetCell( max.x ), maxY = GetCell( max.y ), maxZ = GetCell( max.z );
+
+            const double cellCount = ( maxX - minX + 1.0 ) * ( maxY - minY + 1.0 ) * ( maxZ - minZ + 1.0 );
+            if ( cellCount > static_cast<double>( MaxCellCount ) )
+            {
+                grid.large.push_back( zone );
+                continue;
+            }
+
+            for ( int32_t z = minZ; z <= maxZ; ++z )
+            {
+                for ( int32_t y = minY; y <= maxY; ++y )
+                {
+                    for ( int32_t x = minX; x <= maxX; ++x )
+                        grid.cells[GetKey( x, y, z )].push_back( zone );
+                }
+            }
+        }
+
+        grid.dirty = false;
+    }
+
+    // The send level of each reverb bus for each listener, and the weighted sum of the parameters of its reverb.
+    struct Target
+    {
+        std::shared_ptr<BusImpl> bus;
+        float                    levels[MA_ENGINE_MAX_LISTENERS] {};
+        ReverbImpl*              reverb    = nullptr;
+        float                    weight    = 0.0f;
+        float                    decayTime = 0.0f;
+        float                    damping   = 0.0f;
+    };
+
+    // The bus of every zone is a target (so the sends are turned down when the listeners leave the zones).
+    std::vector<Target> targets;
+    for ( ReverbZoneImpl* zone: zones )
+    {
+        if ( std::none_of( targets.begin(), targets.end(), [zone]( const Target& t ) { return t.bus == zone->bus; } ) )
+            targets.push_back( { zone->bus } );
+    }
+
+    const ma_uint32 listenerCount = std::min<ma_uint32>( ma_engine_get_listener_count( pEngine ), MA_ENGINE_MAX_LISTENERS );
+    for ( ma_uint32 listener = 0; listener < listenerCount; ++listener )
+    {
+        if ( !ma_engine_listener_is_enabled( pEngine, listener ) )
+            continue;
+
+        const ma_vec3f position = ma_engine_listener_get_position( pEngine, listener );
+
+        // Only the zones in the cell of the listener (and the large zones) can contain the listener.
+        const auto evaluate = [&]( const std::vector<ReverbZoneImpl*>& candidates ) {
+            for ( ReverbZoneImpl* zone: candidates )
+            {
+                const float weight = zone->computeWeight( position );
+                if ( weight <= 0.0f )
+                    continue;
+
+                Target& target          = *std::find_if( targets.begin(), targets.end(), [zone]( const Target& t ) { return t.bus == zone->bus; } );
+                target.levels[listener] = std::max( target.levels[listener], weight * zone->sendLevel );
+
+                if ( zone->hasReverb && zone->reverb )
+                {
+                    target.reverb = zone->reverb.get();
+                    target.weight += weight;
+                    target.decayTime += weight * zone->decayTime;
+                    target.damping += weight * zone->damping;
+                }
+            }
+        };
+
+        evaluate( grid.large );
+
+        const auto cell = grid.cells.find( GetKey( GetCell( position.x ), GetCell( position.y ), GetCell( position.z ) ) );
+        if ( cell != grid.cells.end() )
+            evaluate( cell->second );
+    }
+
+    // Each source bus sends to the reverb buses at the levels of its listener (or the first listener).
+    for ( BusImpl* source: GetSources() )
+    {
+        const ma_uint32 listener = source->getListener() == MA_LISTENER_INDEX_CLOSEST ? 0 : source->getListener();
+
+        for ( const Target& target: targets )
+        {
+            if ( target.bus.get() == source || target.bus->feeds( source ) )
+                continue;
+
+            const float level = listener < MA_ENGINE_MAX_LISTENERS ? target.levels[listener] : 0.0f;
+            if ( level != source->getSend( target.bus ) )
+                source->setSend( target.bus, level );
+        }
+    }
+
+    for ( const Target& target: targets )
+    {
+        if ( !target.reverb || target.weight <= 0.0f )
+            continue;
+
+        // Setting a parameter recomputes the reverb, so only changes are applied.
+        const float decay = target.decayTime / target.weight;
+        const float damp  = target.damping / target.weight;
+        if ( std::abs( decay - target.reverb->getDecayTime() ) > 1e-3f )
+            target.reverb->setDecayTime( decay );
+        if ( std::abs( damp - target.reverb->getDamping() ) > 1e-3f )
+            target.reverb->setDamping( damp );
+    }
+
+    // Remove the sends to the buses that are no longer driven by any zone.
+    auto& driven = GetDrivenBuses();
+    for ( auto& bus: driven )
+    {
+        if ( std::any_of( targets.begin(), targets.end(), [&bus]( const Target& t ) { return t.bus == bus; } ) )
+            continue;
+
+        for ( BusImpl* source: GetSources() )
+            source->removeSend( bus );
+
+        released.push_back( std::move( bus ) );
+    }
+
+    driven.clear();
+    for ( const Target& target: targets )
+        driven.push_back( target.bus );
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Audio/ReverbZone.hpp>
+
+#include "miniaudio.h"
+
+#include <memory>
+#include <vector>
+
+namespace Audio
+{
+class BusImpl;
+class ReverbImpl;
+
+class ReverbZoneImpl
+{
+public:
+    /// <summary>
+    /// Create a zone that drives a reverb bus (and optionally the parameters of a reverb effect).
+    /// </summary>
+    ReverbZoneImpl( std::shared_ptr<BusImpl> bus, std::shared_ptr<ReverbImpl> reverb );
+    ~ReverbZoneImpl();
+
+    void              setBox( const ma_vec3f& center, const ma_vec3f& halfExtents );
+    void              setSphere( const ma_vec3f& center, float radius );
+    ReverbZone::Shape getShape() const;
+
+    void  setFadeDistance( float fadeDistance );
+    float getFadeDistance() const;
+
+    void  setSendLevel( float level );
+    float getSendLevel() const;
+
+    void setReverb( float decayTime, float damping );
+
+    float getWeight( const ma_vec3f& position ) const;
+
+    /// <summary>
+    /// Let the reverb zones drive the sends of a bus (or stop driving them).
+    /// </summary>
+    static void addSource( BusImpl* bus );
+    static void removeSource( BusImpl* bus );
+
+    /// <summary>
+    /// Get the reverb buses that are driven by the zones.
+    /// </summary>
+    static std::vector<std::shared_ptr<BusImpl>> getTargets();
+
+    /// <summary>
+    /// Find the zones around each listener of the engine and update the sends of the source buses
+    /// and the parameters of the reverbs (once per frame).
+    /// </summary>
+    static void updateAll( ma_engine* pEngine );
+
+    // The size of the cells of the grid that the zones are sorted into.
+    static constexpr float CellSize = 32.0f;
+
+    // Zones that cover more cells than this are not sorted into the grid (they are checked for every listener).
+    static constexpr size_t MaxCellCount = 4096;
+
+    ReverbZoneImpl( const ReverbZoneImpl& )            = delete;
+    ReverbZoneImpl( ReverbZoneImpl&& )                 = delete;
+    ReverbZoneImpl& operator=( const ReverbZoneImpl& ) = delete;
+    ReverbZoneImpl& operator=( ReverbZoneImpl&& )      = delete;
+
+private:
+    // The weight without locking the zones.
+    float computeWeight( const ma_vec3f& position ) const noexcept;
+
+    // Get the bounds of the zone, including the fade distance.
+    void getBounds( ma_vec3f& min, ma_vec3f& max ) const noexcept;
+
+    std::shared_ptr<BusImpl>    bus;
+    std::shared_ptr<ReverbImpl> reverb;
+
+    // Guarded by the mutex of all zones.
+    ReverbZone::Shape shape = ReverbZone::Shape::Sphere;
+    ma_vec3f          center {};
+    ma_vec3f          halfExtents {};
+    float             radius       = 0.0f;
+    float             fadeDistance = 0.0f;
+    float             sendLevel    = 1.0f;
+    bool              hasReverb    = false;
+    float             decayTime    = 1.5f;
+    float             damping      = 0.5f;
+};
+}  // namespace Audio
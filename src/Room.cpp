@@ -0,0 +1,88 @@
+#include <Audio/Room.hpp>
+
+#include "RoomImpl.hpp"
+
+using namespace Audio;
+
+Room::Room( std::shared_ptr<RoomImpl> impl )
+: impl { std::move( impl ) }
+{}
+
+Room::Room()                             = default;
+Room::~Room()                            = default;
+Room::Room( const Room& )                = default;
+Room::Room( Room&& ) noexcept            = default;
+Room& Room::operator=( const Room& )     = default;
+Room& Room::operator=( Room&& ) noexcept = default;
+
+Room& Room::operator=( nullptr_t ) noexcept
+{
+    impl = nullptr;
+    return *this;
+}
+
+bool Room::operator==( nullptr_t ) const noexcept
+{
+    return impl == nullptr;
+}
+
+bool Room::operator!=( nullptr_t ) const noexcept
+{
+    return impl != nullptr;
+}
+
+void Room::setBox( const Vector& center, const Vector& halfExtents )
+{
+    impl->setBox( { center.x, center.y, center.z }, { halfExtents.x, halfExtents.y, halfExtents.z } );
+}
+
+void Room::setAbsorption( float absorption )
+{
+    for ( uint32_t wall = 0; wall < RoomImpl::WallCount; ++wall )
+        impl->setAbsorption( wall, absorption );
+}
+
+void Room::setAbsorption( Wall wall, float absorption )
+{
+    impl->setAbsorption( static_cast<uint32_t>( wall ), absorption );
+}
+
+float Room::getAbsorption( Wall wall ) const
+{
+    return impl->getAbsorption( static_cast<uint32_t>( wall ) );
+}
+
+void Room::setOrder( uint32_t order )
+{
+    impl->setOrder( order );
+}
+
+uint32_t Room::getOrder() const
+{
+    return impl->getOrder();
+}
+
+void Room::setLevel( float level )
+{
+    impl->setLevel( level );
+}
+
+float Room::getLevel() const
+{
+    return impl->getLevel();
+}
+
+Room::operator bool() const noexcept
+{
+    return impl != nullptr;
+}
+
+std::shared_ptr<RoomImpl> Room::get() const noexcept
+{
+    return impl;
+}
+
+void Room::reset() noexcept
+{
+    impl.reset();
+}
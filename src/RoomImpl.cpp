@@ -0,0 +1,70 @@
+#include "RoomImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+RoomImpl::RoomImpl( const ma_vec3f& center, const ma_vec3f& halfExtents )
+{
+    for ( auto& wall: absorption )
+        wall.store( 0.3f, std::memory_order_relaxed );
+
+    setBox( center, halfExtents );
+}
+
+void RoomImpl::setBox( const ma_vec3f& center, const ma_vec3f& halfExtents ) noexcept
+{
+    const ma_vec3f extents = { std::abs( halfExtents.x ), std::abs( halfExtents.y ), std::abs( halfExtents.z ) };
+
+    bounds[0].store( center.x - extents.x, std::memory_order_relaxed );
+    bounds[1].store( center.y - extents.y, std::memory_order_relaxed );
+    bounds[2].store( center.z - extents.z, std::memory_order_relaxed );
+    bounds[3].store( center.x + extents.x, std::memory_order_relaxed );
+    bounds[4].store( center.y + extents.y, std::memory_order_relaxed );
+    bounds[5].store( center.z + extents.z, std::memory_order_relaxed );
+
+    version.fetch_add( 1, std::memory_order_release );
+}
+
+void RoomImpl::getBox( ma_vec3f& min, ma_vec3f& max ) const noexcept
+{
+    min = { bounds[0].load( std::memory_order_relaxed ), bounds[1].load( std::memory_order_relaxed ), bounds[2].load( std::memory_order_relaxed ) };
+    max = { bounds[3].load( std::memory_order_relaxed ), bounds[4].load( std::memory_order_relaxed ), bounds[5].load( std::memory_order_relaxed ) };
+}
+
+void RoomImpl::setAbsorption( uint32_t wall, float _absorption ) noexcept
+{
+    if ( wall >= WallCount )
+        return;
+
+    absorption[wall].store( std::clamp( _absorption, 0.0f, 1.0f ), std::memory_order_relaxed );
+    version.fetch_add( 1, std::memory_order_release );
+}
+
+float RoomImpl::getAbsorption( uint32_t wall ) const noexcept
+{
+    return wall < WallCount ? absorption[wall].load( std::memory_order_relaxed ) : 0.0f;
+}
+
+void RoomImpl::setOrder( uint32_t _order ) noexcept
+{
+    order.store( std::clamp( _order, 1u, 2u ), std::memory_order_relaxed );
+    version.fetch_add( 1, std::memory_order_release );
+}
+
+uint32_t RoomImpl::getOrder() const noexcept
+{
+    return order.load( std::memory_order_relaxed );
+}
+
+void RoomImpl::setLevel( float _level ) noexcept
+{
+    level.store( std::max( _level, 0.0f ), std::memory_order_relaxed );
+    version.fetch_add( 1, std::memory_order_release );
+}
+
+float RoomImpl::getLevel() const noexcept
+{
+    return level.load( std::memory_order_relaxed );
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "miniaudio.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace Audio
+{
+/// <summary>
+/// The parameters of a box-shaped room. The parameters are set by the game and read by the
+/// image sources of the sounds (on the audio thread) whenever the version changes.
+/// </summary>
+class RoomImpl
+{
+public:
+    static constexpr uint32_t WallCount = 6;
+
+    RoomImpl( const ma_vec3f& center, const ma_vec3f& halfExtents );
+
+    void setBox( const ma_vec3f& center, const ma_vec3f& halfExtents ) noexcept;
+
+    /// <summary>
+    /// Get the minimum and maximum corner of the room.
+    /// </summary>
+    void getBox( ma_vec3f& min, ma_vec3f& max ) const noexcept;
+
+    void  setAbsorption( uint32_t wall, float absorption ) noexcept;
+    float getAbsorption( uint32_t wall ) const noexcept;
+
+    void     setOrder( uint32_t order ) noexcept;
+    uint32_t getOrder() const noexcept;
+
+    void  setLevel( float level ) noexcept;
+    float getLevel() const noexcept;
+
+    /// <summary>
+    /// The version is incremented whenever a parameter changes.
+    /// </summary>
+    uint32_t getVersion() const noexcept
+    {
+        return version.load( std::memory_order_acquire );
+    }
+
+private:
+    // The corners of the room (min x, min y, min z, max x, max y, max z).
+    std::atomic<float>    bounds[6];
+    std::atomic<float>    absorption[WallCount];
+    std::atomic<uint32_t> order { 2 };
+    std::atomic<float>    level { 1.0f };
+    std::atomic<uint32_t> version { 1 };
+};
+}  // namespace Audio
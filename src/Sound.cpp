@@ -5,6 +5,13 @@
 
 using namespace Audio;
 
+struct MakeBus : Bus
+{
+    MakeBus( std::shared_ptr<BusImpl> impl )
+    : Bus( std::move( impl ) )
+    {}
+};
+
 Sound::Sound()                              = default;
 Sound::~Sound()                             = default;
 Sound::Sound( const Sound& )                = default;
@@ -131,6 +138,16 @@ void Sound::setPinnedListener( const Listener& listener )
     impl->setPinnedListener( listener );
 }
 
+void Sound::setBus( const Bus& bus )
+{
+    impl->setBus( bus.get() );
+}
+
+Bus Sound::getBus() const
+{
+    return MakeBus( impl->getBus() );
+}
+
 void Sound::setVolume( float volume )
 {
     impl->setVolume( volume );
@@ -161,11 +178,56 @@ float Sound::getPitch() const
     return impl->getPitch();
 }
 
+void Sound::setResampleQuality( ResampleQuality quality )
+{
+    impl->setResampleQuality( quality );
+}
+
+Sound::ResampleQuality Sound::getResampleQuality() const
+{
+    return impl->getResampleQuality();
+}
+
+void Sound::setLodDistances( float monoDistance, float halfRateDistance, float quarterRateDistance )
+{
+    impl->setLodDistances( monoDistance, halfRateDistance, quarterRateDistance );
+}
+
+void Sound::getLodDistances( float& monoDistance, float& halfRateDistance, float& quarterRateDistance ) const
+{
+    impl->getLodDistances( monoDistance, halfRateDistance, quarterRateDistance );
+}
+
+void Sound::setSpatialization( Spatialization spatialization )
+{
+    impl->setSpatialization( spatialization );
+}
+
+Sound::Spatialization Sound::getSpatialization() const
+{
+    return impl->getSpatialization();
+}
+
 void Sound::setPosition( const Vector& position )
 {
     impl->setPosition( position );
 }
 
+void Sound::setPosition( const Vector& position, double seconds )
+{
+    impl->setPosition( position, seconds );
+}
+
+void Sound::setPositionInterpolation( bool enabled )
+{
+    impl->setPositionInterpolation( enabled );
+}
+
+bool Sound::getPositionInterpolation() const
+{
+    return impl->getPositionInterpolation();
+}
+
 Vector Sound::getPosition() const
 {
     return impl->getPosition();
@@ -191,6 +253,11 @@ Vector Sound::getVelocity() const
     return impl->getVelocity();
 }
 
+void Sound::setTransform( const TransformBuffer& buffer, uint32_t slot )
+{
+    impl->setTransform( buffer.get(), slot );
+}
+
 void Sound::setCone( float innerAngle, float outerAngle, float outerGain )
 {
     impl->setCone( innerAngle, outerAngle, outerGain );
@@ -211,6 +278,11 @@ Sound::AttenuationModel Sound::getAttenuationModel() const
     return impl->getAttenuationModel();
 }
 
+void Sound::setAttenuationCurve( const AttenuationCurve& curve )
+{
+    impl->setAttenuationCurve( curve.get() );
+}
+
 void Sound::setRollOff( float rollOff )
 {
     impl->setRollOff( rollOff );
@@ -271,6 +343,51 @@ float Sound::getDopplerFactor() const
     return impl->getDopplerFactor();
 }
 
+void Sound::setPropagationDelay( bool enabled )
+{
+    impl->setPropagationDelay( enabled );
+}
+
+bool Sound::getPropagationDelay() const
+{
+    return impl->getPropagationDelay();
+}
+
+void Sound::setPortalPropagation( bool enabled )
+{
+    impl->setPortalPropagation( enabled );
+}
+
+bool Sound::getPortalPropagation() const
+{
+    return impl->getPortalPropagation();
+}
+
+void Sound::setOcclusionQuery( bool enabled )
+{
+    impl->setOcclusionQuery( enabled );
+}
+
+bool Sound::getOcclusionQuery() const
+{
+    return impl->getOcclusionQuery();
+}
+
+void Sound::setOcclusion( float occlusion, float obstruction )
+{
+    impl->setOcclusion( occlusion, obstruction );
+}
+
+float Sound::getOcclusion() const
+{
+    return impl->getOcclusion();
+}
+
+float Sound::getObstruction() const
+{
+    return impl->getObstruction();
+}
+
 void Sound::setFade( float endVolume, uint64_t milliseconds )
 {
     impl->setFade( endVolume, milliseconds );
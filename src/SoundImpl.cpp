@@ -1,25 +1,149 @@
 #include "SoundImpl.hpp"
+#include "Ambisonics.hpp"
+#include "AttenuationCurveImpl.hpp"
+#include "BusImpl.hpp"
+#include "ChannelMixer.hpp"
+#include "EarlyReflections.hpp"
+#include "EmitterGrid.hpp"
+#include "HrtfFilterImpl.hpp"
 #include "ListenerImpl.hpp"
-
+#include "OcclusionFilterImpl.hpp"
+#include "OcclusionScheduler.hpp"
+#include "PortalImpl.hpp"
+#include "PositionInterpolator.hpp"
+#include "PropagationDelayImpl.hpp"
+#include "Resampler.hpp"
+#include "TransformBufferImpl.hpp"
+#include "VbapPannerImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <mutex>
+#include <vector>
+
+#if defined( _MSC_VER )
+    #include <intrin.h>
+#endif
 
 using namespace Audio;
 
-SoundImpl::SoundImpl( std::shared_ptr<DeviceImpl> device, const std::filesystem::path& filePath, ma_engine* pEngine, ma_sound_group* pGroup, uint32_t flags )
-: device { std::move( device ) }
+namespace
+{
+// The sounds that use HRTF spatialization.
+std::mutex& getHrtfMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<SoundImpl*>& getHrtfSounds()
+{
+    static std::vector<SoundImpl*> sounds;
+    return sounds;
+}
+
+// Store the pinned listener of a sound atomically (like `ma_sound_set_pinned_listener_index`), because the audio
+// thread reads it while it spatializes the sound.
+void storePinnedListenerIndex( ma_sound* pSound, ma_uint32 listenerIndex )
+{
+#if defined( _MSC_VER )
+    _InterlockedExchange( reinterpret_cast<volatile long*>( &pSound->engineNode.pinnedListenerIndex ), static_cast<long>( listenerIndex ) );
+#else
+    __atomic_exchange_n( &pSound->engineNode.pinnedListenerIndex, listenerIndex, __ATOMIC_RELEASE );
+#endif
+}
+}  // namespace
+
+SoundImpl::SoundImpl( std::shared_ptr<DeviceImpl> _device, const std::filesystem::path& filePath, ma_engine* pEngine, std::shared_ptr<BusImpl> _bus, uint32_t flags )
+: device { std::move( _device ) }
 , engine { pEngine }
-, group { pGroup }
+, bus { std::move( _bus ) }
 {
+    ma_sound_group* group = bus ? static_cast<ma_sound_group*>( bus->getInputNode() ) : nullptr;
+
+    // The engine needs to know the format of the data source before the sound is initialized.
+    const ma_uint32 dataSourceFlags = ( flags & ( MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_ASYNC ) ) | MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_WAIT_INIT;
 
-    if ( ma_sound_init_from_file_w( engine, filePath.wstring().c_str(), flags, group, nullptr, &sound ) != MA_SUCCESS )
+    if ( ma_resource_manager_data_source_init_w( ma_engine_get_resource_manager( engine ), filePath.wstring().c_str(), dataSourceFlags, nullptr, &dataSource ) != MA_SUCCESS )
     {
         std::cerr << "Failed to initialize sound from source: " << filePath.string() << std::endl;
+        return;
+    }
+
+    // Pitching is done by the resampler instead of the engine.
+    resampler = std::make_unique<Resampler>( engine, &dataSource );
+
+    spatialized = ( flags & MA_SOUND_FLAG_NO_SPATIALIZATION ) == 0;
+
+    ma_uint32 sourceChannels = 0;
+    ma_data_source_get_data_format( resampler->getDataSource(), nullptr, &sourceChannels, nullptr, nullptr, 0 );
+
+    // 2D sounds keep their channels, and are mixed to the channels of the engine with a precomputed matrix.
+    const bool mixed = !spatialized && sourceChannels > 0 && ChannelMixer::isNeeded( sourceChannels, ma_engine_get_channels( engine ) );
+
+    ma_sound_config config    = ma_sound_config_init_2( engine );
+    config.pDataSource        = resampler->getDataSource();
+    config.flags              = flags | MA_SOUND_FLAG_NO_PITCH | ( mixed ? MA_SOUND_FLAG_NO_DEFAULT_ATTACHMENT : 0 );
+    config.pInitialAttachment = mixed ? nullptr : group;
+    config.channelsOut        = mixed ? MA_SOUND_SOURCE_CHANNEL_COUNT : 0;
+
+    if ( ma_sound_init_ex( engine, &config, &sound ) != MA_SUCCESS )
+    {
+        std::cerr << "Failed to initialize sound from source: " << filePath.string() << std::endl;
+    }
+
+    resampler->setSound( &sound );
+
+    if ( mixed )
+    {
+        channelMixer = std::make_unique<ChannelMixer>( engine, sourceChannels );
+        connect();
+    }
+
+    // The spatializer only pans between the speakers of stereo devices.
+    if ( spatialized && ma_engine_get_channels( engine ) > 2 )
+    {
+        panner = std::make_unique<VbapPannerImpl>( device, engine, &sound );
+        connect();
     }
+
+    if ( bus )
+        bus->addSound( this );
+
+    updateListener();
+    updateAmbisonics();
+    updateReflections();
+
+    // Only 3D sounds can be found by their position.
+    if ( spatialized )
+        EmitterGrid::get().insert( this, ma_sound_get_position( &sound ) );
 }
 
 SoundImpl::~SoundImpl()
 {
+    setTransform( nullptr, 0 );
+    setAttenuationCurve( nullptr );
+    interpolator.reset();
+    occlusionQuery.reset();
+    portalSource.reset();
+    propagationDelay.reset();
+    imageSources.reset();
+    setSpatialization( Sound::Spatialization::Panning );
+
+    if ( spatialized )
+        EmitterGrid::get().remove( this );
+
+    if ( bus )
+        bus->removeSound( this );
+
     ma_sound_uninit( &sound );
+
+    if ( resampler )
+    {
+        resampler.reset();
+        ma_resource_manager_data_source_uninit( &dataSource );
+    }
 }
 
 void SoundImpl::play()
@@ -80,11 +204,28 @@ void SoundImpl::setPinnedListener( const Listener& listener )
 {
     if ( const auto listenerImpl = listener.get() )
     {
-        const uint32_t index = listenerImpl->getIndex();
-        ma_sound_set_pinned_listener_index( &sound, index );
+        pinnedListener = listenerImpl->getIndex();
+        updateListener();
     }
 }
 
+void SoundImpl::setBus( std::shared_ptr<BusImpl> _bus )
+{
+    // Leaving the bus also removes the sound from its cluster.
+    if ( bus )
+        bus->removeSound( this );
+
+    bus = std::move( _bus );
+
+    if ( bus )
+        bus->addSound( this );
+
+    updateListener();
+    updateAmbisonics();
+    updateReflections();
+    connect();
+}
+
 void SoundImpl::setVolume( float volume )
 {
     ma_sound_set_volume( &sound, volume );
@@ -107,22 +248,91 @@ float SoundImpl::getPan() const
 
 void SoundImpl::setPitch( float pitch )
 {
-    ma_sound_set_pitch( &sound, pitch );
+    if ( resampler && pitch > 0.0f )
+        resampler->setPitch( pitch );
 }
 
 float SoundImpl::getPitch() const
 {
-    return ma_sound_get_pitch( &sound );
+    return resampler ? resampler->getPitch() : 1.0f;
+}
+
+void SoundImpl::setResampleQuality( Sound::ResampleQuality quality )
+{
+    if ( resampler )
+        resampler->setQuality( quality );
+}
+
+Sound::ResampleQuality SoundImpl::getResampleQuality() const
+{
+    return resampler ? resampler->getQuality() : Sound::ResampleQuality::Linear;
+}
+
+void SoundImpl::setLodDistances( float monoDistance, float halfRateDistance, float quarterRateDistance )
+{
+    if ( resampler )
+        resampler->setLodDistances( monoDistance, halfRateDistance, quarterRateDistance );
+}
+
+void SoundImpl::getLodDistances( float& monoDistance, float& halfRateDistance, float& quarterRateDistance ) const
+{
+    if ( resampler )
+    {
+        resampler->getLodDistances( monoDistance, halfRateDistance, quarterRateDistance );
+    }
+    else
+    {
+        monoDistance        = std::numeric_limits<float>::infinity();
+        halfRateDistance    = std::numeric_limits<float>::infinity();
+        quarterRateDistance = std::numeric_limits<float>::infinity();
+    }
 }
 
 void SoundImpl::setPosition( const Vector& pos )
 {
     ma_sound_set_position( &sound, pos.x, pos.y, pos.z );
+
+    if ( portalSource )
+        portalSource->setPosition( { pos.x, pos.y, pos.z } );
+
+    // Jump to the new position.
+    if ( interpolator )
+        interpolator->push( { pos.x, pos.y, pos.z }, { 0.0f, 0.0f, 0.0f }, 0.0 );
+
+    if ( spatialized )
+        EmitterGrid::get().move( this, { pos.x, pos.y, pos.z } );
+
+    velocityTracker.reset();
+}
+
+void SoundImpl::setPosition( const Vector& pos, double time )
+{
+    ma_vec3f velocity;
+    if ( !velocityTracker.update( { pos.x, pos.y, pos.z }, time, velocity ) )
+        return;
+
+    if ( interpolator )
+    {
+        interpolator->push( { pos.x, pos.y, pos.z }, velocity, velocityTracker.getInterval() );
+    }
+    else
+    {
+        ma_sound_set_position( &sound, pos.x, pos.y, pos.z );
+
+        if ( portalSource )
+            portalSource->setPosition( { pos.x, pos.y, pos.z } );
+    }
+
+    ma_sound_set_velocity( &sound, velocity.x, velocity.y, velocity.z );
+
+    if ( spatialized )
+        EmitterGrid::get().move( this, { pos.x, pos.y, pos.z } );
 }
 
 Vector SoundImpl::getPosition() const
 {
-    auto pos = ma_sound_get_position( &sound );
+    // The sound is moved to its apparent position by the portals.
+    auto pos = portalSource ? portalSource->getPosition() : ma_sound_get_position( &sound );
     return { pos.x, pos.y, pos.z };
 }
 
@@ -148,6 +358,31 @@ Vector SoundImpl::getVelocity() const
     return { vel.x, vel.y, vel.z };
 }
 
+void SoundImpl::setPositionInterpolation( bool enabled )
+{
+    if ( enabled == getPositionInterpolation() )
+        return;
+
+    interpolator = enabled ? std::make_unique<PositionInterpolator>( device, engine, &sound ) : nullptr;
+}
+
+void SoundImpl::setTransform( std::shared_ptr<TransformBufferImpl> buffer, uint32_t slot )
+{
+    if ( buffer && slot >= buffer->getSlotCount() )
+    {
+        std::cerr << "Transform slot " << slot << " is out of range." << std::endl;
+        return;
+    }
+
+    if ( transformBuffer && transformBuffer != buffer )
+        transformBuffer->detach( this );
+
+    transformBuffer = std::move( buffer );
+
+    if ( transformBuffer )
+        transformBuffer->attach( this, slot );
+}
+
 void SoundImpl::setCone( float innerConeAngle, float outerConeAngle, float outerGain )
 {
     ma_sound_set_cone( &sound, innerConeAngle, outerConeAngle, outerGain );
@@ -158,28 +393,35 @@ void SoundImpl::getCone( float& innerConeAngle, float& outerConeAngle, float& ou
     ma_sound_get_cone( &sound, &innerConeAngle, &outerConeAngle, &outerGain );
 }
 
-void SoundImpl::setAttenuationModel( Sound::AttenuationModel attenuation )
+void SoundImpl::setAttenuationModel( Sound::AttenuationModel _attenuation )
 {
-    switch ( attenuation )
+    ma_attenuation_model model = ma_attenuation_model_none;
+
+    switch ( _attenuation )
     {
     case Sound::AttenuationModel::None:
-        ma_sound_set_attenuation_model( &sound, ma_attenuation_model_none );
+        model = ma_attenuation_model_none;
         break;
     case Sound::AttenuationModel::Inverse:
-        ma_sound_set_attenuation_model( &sound, ma_attenuation_model_inverse );
+        model = ma_attenuation_model_inverse;
         break;
     case Sound::AttenuationModel::Linear:
-        ma_sound_set_attenuation_model( &sound, ma_attenuation_model_linear );
+        model = ma_attenuation_model_linear;
         break;
     case Sound::AttenuationModel::Exponential:
-        ma_sound_set_attenuation_model( &sound, ma_attenuation_model_exponential );
+        model = ma_attenuation_model_exponential;
         break;
     }
+
+    if ( attenuationCurve )
+        attenuation.model = model;
+    else
+        ma_sound_set_attenuation_model( &sound, model );
 }
 
 Sound::AttenuationModel SoundImpl::getAttenuationModel() const
 {
-    switch ( ma_sound_get_attenuation_model( &sound ) )
+    switch ( attenuationCurve ? attenuation.model : ma_sound_get_attenuation_model( &sound ) )
     {
     case ma_attenuation_model_none:
         return Sound::AttenuationModel::None;
@@ -194,14 +436,43 @@ Sound::AttenuationModel SoundImpl::getAttenuationModel() const
     return Sound::AttenuationModel::None;
 }
 
+void SoundImpl::setAttenuationCurve( std::shared_ptr<AttenuationCurveImpl> curve )
+{
+    if ( curve == attenuationCurve )
+        return;
+
+    if ( attenuationCurve )
+        attenuationCurve->detach( this );
+    else
+        attenuation = { ma_sound_get_attenuation_model( &sound ), ma_sound_get_rolloff( &sound ), ma_sound_get_min_distance( &sound ), ma_sound_get_max_distance( &sound ) };
+
+    attenuationCurve = std::move( curve );
+
+    // A cluster is attenuated like a single sound, so sounds with a curve leave their cluster (see `isClusterable`).
+    if ( attenuationCurve )
+    {
+        attenuationCurve->attach( this );
+    }
+    else
+    {
+        ma_sound_set_attenuation_model( &sound, attenuation.model );
+        ma_sound_set_rolloff( &sound, attenuation.rollOff );
+        ma_sound_set_min_distance( &sound, attenuation.minDistance );
+        ma_sound_set_max_distance( &sound, attenuation.maxDistance );
+    }
+}
+
 void SoundImpl::setRollOff( float rollOff )
 {
-    ma_sound_set_rolloff( &sound, rollOff );
+    if ( attenuationCurve )
+        attenuation.rollOff = rollOff;
+    else
+        ma_sound_set_rolloff( &sound, rollOff );
 }
 
 float SoundImpl::getRollOff() const
 {
-    return ma_sound_get_rolloff( &sound );
+    return attenuationCurve ? attenuation.rollOff : ma_sound_get_rolloff( &sound );
 }
 
 void SoundImpl::setMinGain( float minGain )
@@ -226,32 +497,123 @@ float SoundImpl::getMaxGain() const
 
 void SoundImpl::setMinDistance( float minDistance )
 {
-    ma_sound_set_min_distance( &sound, minDistance );
+    if ( attenuationCurve )
+        attenuation.minDistance = minDistance;
+    else
+        ma_sound_set_min_distance( &sound, minDistance );
 }
 
 float SoundImpl::getMinDistance() const
 {
-    return ma_sound_get_min_distance( &sound );
+    return attenuationCurve ? attenuation.minDistance : ma_sound_get_min_distance( &sound );
 }
 
 void SoundImpl::setMaxDistance( float maxDistance )
 {
-    ma_sound_set_max_distance( &sound, maxDistance );
+    if ( attenuationCurve )
+        attenuation.maxDistance = maxDistance;
+    else
+        ma_sound_set_max_distance( &sound, maxDistance );
 }
 
 float SoundImpl::getMaxDistance() const
 {
-    return ma_sound_get_max_distance( &sound );
+    return attenuationCurve ? attenuation.maxDistance : ma_sound_get_max_distance( &sound );
 }
 
-void SoundImpl::setDopplerFactor( float dopplerFactor )
+void SoundImpl::setDopplerFactor( float _dopplerFactor )
 {
-    ma_sound_set_doppler_factor( &sound, dopplerFactor );
+    dopplerFactor = _dopplerFactor;
+
+    // The propagation delay already shifts the pitch.
+    ma_sound_set_doppler_factor( &sound, propagationDelay ? 0.0f : dopplerFactor );
 }
 
 float SoundImpl::getDopplerFactor() const
 {
-    return ma_sound_get_doppler_factor( &sound );
+    return dopplerFactor;
+}
+
+void SoundImpl::setPropagationDelay( bool enabled )
+{
+    if ( enabled == getPropagationDelay() )
+        return;
+
+    // Connect the sound to the new node before the previous node is destroyed.
+    auto previous    = std::move( propagationDelay );
+    propagationDelay = enabled ? std::make_unique<PropagationDelayImpl>( device, engine, &sound ) : nullptr;
+
+    connect();
+    setDopplerFactor( dopplerFactor );
+}
+
+void SoundImpl::setOcclusion( float occlusion, float obstruction )
+{
+    // The occlusion is combined with the occlusion of the path through the portals on the audio thread.
+    if ( portalSource )
+    {
+        portalSource->setOcclusion( occlusion, obstruction );
+        return;
+    }
+
+    if ( !occlusionFilter )
+    {
+        // Sounds that are never occluded don't pay for the filter.
+        if ( occlusion <= 0.0f && obstruction <= 0.0f )
+            return;
+
+        occlusionFilter = std::make_unique<OcclusionFilterImpl>( device, engine );
+        occlusionFilter->setOcclusion( occlusion, obstruction );
+
+        // Insert the filter between the sound and the bus.
+        connect();
+        return;
+    }
+
+    occlusionFilter->setOcclusion( occlusion, obstruction );
+}
+
+void SoundImpl::setPortalPropagation( bool enabled )
+{
+    if ( !spatialized || enabled == ( portalSource != nullptr ) )
+        return;
+
+    if ( enabled )
+    {
+        // The occlusion filter applies the occlusion of the path.
+        if ( !occlusionFilter )
+        {
+            occlusionFilter = std::make_unique<OcclusionFilterImpl>( device, engine );
+            connect();
+        }
+
+        portalSource = std::make_unique<PortalSource>( device, engine, &sound, occlusionFilter.get() );
+        return;
+    }
+
+    // Move the sound back to its position.
+    const ma_vec3f position = portalSource->getPosition();
+    portalSource.reset();
+    ma_sound_set_position( &sound, position.x, position.y, position.z );
+}
+
+void SoundImpl::setOcclusionQuery( bool enabled )
+{
+    if ( !spatialized || enabled == ( occlusionQuery != nullptr ) )
+        return;
+
+    // The occlusion keeps the last (smoothed) result when the queries are disabled.
+    occlusionQuery = enabled ? std::make_unique<OcclusionQuerySource>( this ) : nullptr;
+}
+
+float SoundImpl::getOcclusion() const noexcept
+{
+    return occlusionFilter ? occlusionFilter->getOcclusion() : 0.0f;
+}
+
+float SoundImpl::getObstruction() const noexcept
+{
+    return occlusionFilter ? occlusionFilter->getObstruction() : 0.0f;
 }
 
 void SoundImpl::setFade( float endVolume, uint64_t milliseconds )
@@ -268,3 +630,209 @@ void SoundImpl::setStopTime( uint64_t milliseconds )
 {
     ma_sound_set_stop_time_in_milliseconds( &sound, milliseconds );
 }
+
+bool SoundImpl::isClusterable() const
+{
+    return spatialized && isPlaying() && ma_sound_get_positioning( &sound ) == ma_positioning_absolute && ma_sound_get_attenuation_model( &sound ) != ma_attenuation_model_none && !attenuationCurve;
+}
+
+void SoundImpl::setCluster( ma_node* _cluster )
+{
+    if ( cluster == _cluster )
+        return;
+
+    cluster = _cluster;
+
+    // The cluster spatializes the mix of its sounds.
+    if ( cluster )
+        setHrtf( nullptr );
+
+    ma_sound_set_spatialization_enabled( &sound, cluster ? MA_FALSE : MA_TRUE );
+
+    connect();
+}
+
+ma_node* SoundImpl::getTargetNode() noexcept
+{
+    if ( cluster )
+        return cluster;
+
+    if ( encoder )
+        return encoder->getNode();
+
+    return bus ? bus->getInputNode() : ma_engine_get_endpoint( engine );
+}
+
+void SoundImpl::connect()
+{
+    ma_node* output = getTargetNode();
+
+    // Clustered sounds are not spatialized individually, so their reflections are not rendered.
+    if ( imageSources && !cluster )
+    {
+        ma_node_attach_output_bus( imageSources->getNode(), 0, output, 0 );
+        output = imageSources->getNode();
+    }
+
+    if ( occlusionFilter )
+    {
+        ma_node_attach_output_bus( occlusionFilter->getNode(), 0, output, 0 );
+        output = occlusionFilter->getNode();
+    }
+
+    if ( hrtfFilter )
+    {
+        ma_node_attach_output_bus( hrtfFilter->getNode(), 0, output, 0 );
+        output = hrtfFilter->getNode();
+    }
+    else if ( panner && !cluster && !encoder )
+    {
+        ma_node_attach_output_bus( panner->getNode(), 0, output, 0 );
+        output = panner->getNode();
+    }
+
+    if ( propagationDelay )
+    {
+        ma_node_attach_output_bus( propagationDelay->getNode(), 0, output, 0 );
+        output = propagationDelay->getNode();
+    }
+
+    if ( channelMixer )
+    {
+        ma_node_attach_output_bus( channelMixer->getNode(), 0, output, 0 );
+        output = channelMixer->getNode();
+    }
+
+    ma_node_attach_output_bus( &sound, 0, output, 0 );
+
+    // The HRTF filter, the panner, and the ambisonic encoder replace the panning of the spatializer (but not the attenuation).
+    ma_sound_set_directional_attenuation_factor( &sound, hrtfFilter || panner || encoder ? 0.0f : 1.0f );
+}
+
+void SoundImpl::setSpatialization( Sound::Spatialization _spatialization )
+{
+    if ( !spatialized || spatialization == _spatialization )
+        return;
+
+    spatialization = _spatialization;
+
+    std::lock_guard lock { getHrtfMutex() };
+    auto&           sounds = getHrtfSounds();
+
+    if ( spatialization == Sound::Spatialization::Hrtf )
+    {
+        sounds.push_back( this );
+    }
+    else
+    {
+        sounds.erase( std::remove( sounds.begin(), sounds.end(), this ), sounds.end() );
+        setHrtf( nullptr );
+    }
+}
+
+void SoundImpl::setHrtf( const Hrtf* hrtf )
+{
+    if ( ( hrtfFilter ? hrtfFilter->getHrtf() : nullptr ) == hrtf )
+        return;
+
+    // Binaural rendering needs a stereo device.
+    if ( hrtf && ma_engine_get_channels( engine ) != 2 )
+        hrtf = nullptr;
+
+    hrtfFilter = hrtf ? std::make_unique<HrtfFilterImpl>( device, engine, hrtf, &sound ) : nullptr;
+
+    connect();
+}
+
+void SoundImpl::updateHrtf( const Hrtf* hrtf, size_t voiceLimit )
+{
+    std::lock_guard lock { getHrtfMutex() };
+
+    // Rank the playing sounds by their estimated loudness.
+    std::vector<std::pair<float, SoundImpl*>> voices;
+    for ( SoundImpl* sound: getHrtfSounds() )
+    {
+        // Sounds in a cluster are spatialized by their cluster, and sounds on an ambisonic bus by their bus.
+        if ( !hrtf || sound->cluster || sound->encoder )
+        {
+            sound->setHrtf( nullptr );
+            continue;
+        }
+
+        // Stopped sounds keep their filter (so they don't switch when they start playing again).
+        if ( !sound->isPlaying() )
+            continue;
+
+        const ma_vec3f position = ma_sound_get_position( &sound->sound );
+        ma_vec3f       listener = ma_engine_listener_get_position( sound->engine, ma_sound_get_listener_index( &sound->sound ) );
+        if ( ma_sound_get_positioning( &sound->sound ) == ma_positioning_relative )
+            listener = { 0.0f, 0.0f, 0.0f };
+
+        const float x = position.x - listener.x;
+        const float y = position.y - listener.y;
+        const float z = position.z - listener.z;
+
+        voices.emplace_back( EmitterGrid::estimateGain( sound, std::sqrt( x * x + y * y + z * z ) ), sound );
+    }
+
+    const auto last = voices.begin() + static_cast<std::ptrdiff_t>( std::min( voiceLimit, voices.size() ) );
+    std::partial_sort( voices.begin(), last, voices.end(), []( const auto& a, const auto& b ) { return a.first > b.first; } );
+
+    // Release the filters of the low priority voices first.
+    for ( auto iter = last; iter != voices.end(); ++iter )
+        iter->second->setHrtf( nullptr );
+
+    for ( auto iter = voices.begin(); iter != last; ++iter )
+        iter->second->setHrtf( hrtf );
+}
+
+void SoundImpl::updateAmbisonics()
+{
+    AmbisonicDecoder* decoder = spatialized && bus ? bus->getAmbisonicDecoder() : nullptr;
+
+    if ( ( encoder ? encoder->getDecoder() : nullptr ) == decoder )
+        return;
+
+    // The bus spatializes the sound field (the HRTF filter is only used for individually spatialized sounds).
+    if ( decoder )
+        setHrtf( nullptr );
+
+    // Attach the sound to the new encoder before the previous encoder is destroyed.
+    auto previous = std::move( encoder );
+    encoder       = decoder ? std::make_unique<AmbisonicEncoder>( decoder, &sound ) : nullptr;
+
+    connect();
+}
+
+void SoundImpl::updateReflections()
+{
+    EarlyReflections* reflections = spatialized && bus ? bus->getEarlyReflections() : nullptr;
+
+    if ( ( imageSources ? imageSources->getReflections() : nullptr ) == reflections )
+        return;
+
+    // Attach the sound to the new image sources before the previous image sources are destroyed.
+    auto previous = std::move( imageSources );
+    imageSources  = reflections ? std::make_unique<ImageSources>( reflections, &sound ) : nullptr;
+
+    connect();
+}
+
+void SoundImpl::updateListener()
+{
+    const ma_uint32 busListener = bus ? bus->getListener() : MA_LISTENER_INDEX_CLOSEST;
+
+    const ma_uint32 listenerIndex = busListener != MA_LISTENER_INDEX_CLOSEST ? busListener : pinnedListener;
+
+    // `ma_sound_set_pinned_listener_index` rejects `MA_LISTENER_INDEX_CLOSEST`, so a sound could not be unpinned.
+    if ( listenerIndex == MA_LISTENER_INDEX_CLOSEST )
+        storePinnedListenerIndex( &sound, MA_LISTENER_INDEX_CLOSEST );
+    else
+        ma_sound_set_pinned_listener_index( &sound, listenerIndex );
+}
+
+void SoundImpl::updateEmitter()
+{
+    if ( spatialized )
+        EmitterGrid::get().move( this, ma_sound_get_position( &sound ) );
+}
@@ -3,19 +3,36 @@
 #include <Audio/Listener.hpp>
 #include <Audio/Sound.hpp>
 
+#include "VelocityTracker.hpp"
 #include "miniaudio.h"
 
 #include <chrono>
 #include <filesystem>
+#include <memory>
 
 namespace Audio
 {
+class AmbisonicEncoder;
+class AttenuationCurveImpl;
+class BusImpl;
+class ChannelMixer;
 class DeviceImpl;
+class Hrtf;
+class HrtfFilterImpl;
+class ImageSources;
+class OcclusionFilterImpl;
+class OcclusionQuerySource;
+class PortalSource;
+class PositionInterpolator;
+class PropagationDelayImpl;
+class Resampler;
+class TransformBufferImpl;
+class VbapPannerImpl;
 
-class SoundImpl
+class SoundImpl : public std::enable_shared_from_this<SoundImpl>
 {
 public:
-    SoundImpl( std::shared_ptr<DeviceImpl> device, const std::filesystem::path& filePath, ma_engine* pEngine, ma_sound_group* pGroup = nullptr, uint32_t flags = 0 );
+    SoundImpl( std::shared_ptr<DeviceImpl> device, const std::filesystem::path& filePath, ma_engine* pEngine, std::shared_ptr<BusImpl> bus = nullptr, uint32_t flags = 0 );
     ~SoundImpl();
 
     void play();
@@ -35,6 +52,12 @@ public:
 
     void setPinnedListener( const Listener& listener );
 
+    void                            setBus( std::shared_ptr<BusImpl> bus );
+    const std::shared_ptr<BusImpl>& getBus() const noexcept
+    {
+        return bus;
+    }
+
     void  setVolume( float volume );
     float getVolume() const;
 
@@ -44,7 +67,20 @@ public:
     void  setPitch( float pitch );
     float getPitch() const;
 
+    void                   setResampleQuality( Sound::ResampleQuality quality );
+    Sound::ResampleQuality getResampleQuality() const;
+
+    void setLodDistances( float monoDistance, float halfRateDistance, float quarterRateDistance );
+    void getLodDistances( float& monoDistance, float& halfRateDistance, float& quarterRateDistance ) const;
+
     void   setPosition( const Vector& pos );
+    void   setPosition( const Vector& pos, double time );
+
+    void setPositionInterpolation( bool enabled );
+    bool getPositionInterpolation() const noexcept
+    {
+        return interpolator != nullptr;
+    }
     Vector getPosition() const;
 
     void   setDirection( const Vector& dir );
@@ -53,12 +89,20 @@ public:
     void   setVelocity( const Vector& vel );
     Vector getVelocity() const;
 
+    void setTransform( std::shared_ptr<TransformBufferImpl> buffer, uint32_t slot );
+
     void setCone( float innerConeAngle, float outerConeAngle, float outerGain );
     void getCone( float& innerConeAngle, float& outerConeAngle, float& outerGain ) const;
 
     void                    setAttenuationModel( Sound::AttenuationModel attenuation );
     Sound::AttenuationModel getAttenuationModel() const;
 
+    void                        setAttenuationCurve( std::shared_ptr<AttenuationCurveImpl> curve );
+    const AttenuationCurveImpl* getAttenuationCurve() const noexcept
+    {
+        return attenuationCurve.get();
+    }
+
     void  setRollOff( float rollOff );
     float getRollOff() const;
 
@@ -77,16 +121,174 @@ public:
     void  setDopplerFactor( float dopplerFactor );
     float getDopplerFactor() const;
 
+    void setPropagationDelay( bool enabled );
+    bool getPropagationDelay() const noexcept
+    {
+        return propagationDelay != nullptr;
+    }
+
+    void setPortalPropagation( bool enabled );
+    bool getPortalPropagation() const noexcept
+    {
+        return portalSource != nullptr;
+    }
+
+    void  setOcclusion( float occlusion, float obstruction );
+    float getOcclusion() const noexcept;
+
+    void setOcclusionQuery( bool enabled );
+    bool getOcclusionQuery() const noexcept
+    {
+        return occlusionQuery != nullptr;
+    }
+    float getObstruction() const noexcept;
+
     void setFade( float endVolume, uint64_t milliseconds );
 
     void setStartTime( uint64_t milliseconds );
     void setStopTime( uint64_t milliseconds );
 
+    /// <summary>
+    /// Check if this sound can be part of a cluster: a playing, spatialized sound with an absolute position.
+    /// </summary>
+    bool isClusterable() const;
+
+    /// <summary>
+    /// Mix this sound into a cluster instead of spatializing it individually.
+    /// </summary>
+    /// <param name="cluster">The (spatialized) group of the cluster, or `nullptr` to leave the cluster.</param>
+    void     setCluster( ma_node* cluster );
+    ma_node* getCluster() const noexcept
+    {
+        return cluster;
+    }
+
+    ma_sound* getSound() noexcept
+    {
+        return &sound;
+    }
+
+    const ma_sound* getSound() const noexcept
+    {
+        return &sound;
+    }
+
+    void                  setSpatialization( Sound::Spatialization spatialization );
+    Sound::Spatialization getSpatialization() const noexcept
+    {
+        return spatialization;
+    }
+
+    /// <summary>
+    /// Check if the sound is currently rendered with the HRTF (instead of panning).
+    /// </summary>
+    bool isHrtfActive() const noexcept
+    {
+        return hrtfFilter != nullptr;
+    }
+
+    /// <summary>
+    /// Render the (at most `voiceLimit`) loudest playing sounds that use HRTF spatialization with the HRTF,
+    /// and fall back to panning for the other sounds.
+    /// </summary>
+    /// <param name="hrtf">The HRIR set to use (or `nullptr` if no HRIR set is loaded).</param>
+    /// <param name="voiceLimit">The maximum number of sounds that are rendered with the HRTF.</param>
+    static void updateHrtf( const Hrtf* hrtf, size_t voiceLimit );
+
+    /// <summary>
+    /// Encode this sound into the ambisonic mix of its bus (if the bus has ambisonics enabled),
+    /// or spatialize it individually again.
+    /// </summary>
+    void updateAmbisonics();
+
+    /// <summary>
+    /// Add the early reflections of the room of its bus to this sound (if the bus has a room), or remove them.
+    /// </summary>
+    void updateReflections();
+
+    /// <summary>
+    /// Pin the sound to the listener of its bus (if the bus has a listener), or to the listener of the sound.
+    /// </summary>
+    void updateListener();
+
+    /// <summary>
+    /// Move the sound in the emitter grid to its current position (for sounds that are moved by the audio thread).
+    /// </summary>
+    void updateEmitter();
+
 private:
+    // Get the node the sound (or its filters) outputs to: the cluster, the ambisonic encoder, the bus, or the endpoint.
+    ma_node* getTargetNode() noexcept;
+
+    // Attach the sound, the channel mixer, the propagation delay, the HRTF filter (or the panner), the occlusion filter,
+    // and the image sources (if any) in that order.
+    void connect();
+
+    // Render this sound with the HRTF (or with panning if `hrtf` is `nullptr`).
+    void setHrtf( const Hrtf* hrtf );
+
     std::shared_ptr<DeviceImpl> device;
     ma_engine*                  engine = nullptr;
-    ma_sound_group*             group  = nullptr;
-    ma_sound                    sound {};
+    std::shared_ptr<BusImpl>    bus;
+    ma_node*                    cluster        = nullptr;
+    ma_uint32                   pinnedListener = MA_LISTENER_INDEX_CLOSEST;
+    bool                        spatialized    = false;
+    Sound::Spatialization       spatialization = Sound::Spatialization::Panning;
+
+    // The sound plays the resampler, which pulls from the data source loaded by the resource manager.
+    ma_resource_manager_data_source dataSource {};
+    std::unique_ptr<Resampler>      resampler;
+    ma_sound                        sound {};
+
+    // Derives the velocity from timestamped positions.
+    VelocityTracker velocityTracker;
+
+    // Smooths timestamped positions on the audio thread (only created if position interpolation is enabled).
+    std::unique_ptr<PositionInterpolator> interpolator;
+
+    // The transform buffer the sound is attached to (if any).
+    std::shared_ptr<TransformBufferImpl> transformBuffer;
+
+    // The attenuation curve (if any) replaces the attenuation of the spatializer. The attenuation that
+    // was set on the sound is kept here while the curve is attached, and restored when it is removed.
+    struct Attenuation
+    {
+        ma_attenuation_model model;
+        float                rollOff;
+        float                minDistance;
+        float                maxDistance;
+    };
+    std::shared_ptr<AttenuationCurveImpl> attenuationCurve;
+    Attenuation                           attenuation {};
+
+    // The occlusion filter is only created once the sound is occluded (or obstructed).
+    std::unique_ptr<OcclusionFilterImpl> occlusionFilter;
+
+    // Moves the sound to its apparent position through the portals (only created if portal propagation is enabled).
+    // The occlusion filter is always created while portal propagation is enabled.
+    std::unique_ptr<PortalSource> portalSource;
+
+    // Queries the occlusion with the occlusion callback of the device (only created if occlusion queries are enabled).
+    std::unique_ptr<OcclusionQuerySource> occlusionQuery;
+
+    // The propagation delay is only created if it is enabled. It replaces the doppler effect of the spatializer.
+    std::unique_ptr<PropagationDelayImpl> propagationDelay;
+    float                                 dopplerFactor = 1.0f;
+
+    // The HRTF filter is only created while the sound is rendered with the HRTF.
+    std::unique_ptr<HrtfFilterImpl> hrtfFilter;
+
+    // The ambisonic encoder is only created while the bus of the sound has ambisonics enabled.
+    std::unique_ptr<AmbisonicEncoder> encoder;
+
+    // The image sources are only created while the bus of the sound has a room.
+    std::unique_ptr<ImageSources> imageSources;
+
+    // Spatialized sounds are panned with VBAP on multichannel devices (more than two channels).
+    std::unique_ptr<VbapPannerImpl> panner;
+
+    // 2D sounds are mixed to the channels of the engine (only created if the channel counts don't match).
+    std::unique_ptr<ChannelMixer> channelMixer;
 };
 
 }  // namespace Audio
@@ -0,0 +1,62 @@
+#include <Audio/TransformBuffer.hpp>
+
+#include "TransformBufferImpl.hpp"
+
+using namespace Audio;
+
+TransformBuffer::TransformBuffer( std::shared_ptr<TransformBufferImpl> impl )
+: impl { std::move( impl ) }
+{}
+
+TransformBuffer::TransformBuffer()                                        = default;
+TransformBuffer::~TransformBuffer()                                       = default;
+TransformBuffer::TransformBuffer( const TransformBuffer& )                = default;
+TransformBuffer::TransformBuffer( TransformBuffer&& ) noexcept            = default;
+TransformBuffer& TransformBuffer::operator=( const TransformBuffer& )     = default;
+TransformBuffer& TransformBuffer::operator=( TransformBuffer&& ) noexcept = default;
+
+TransformBuffer& TransformBuffer::operator=( nullptr_t ) noexcept
+{
+    impl = nullptr;
+    return *this;
+}
+
+bool TransformBuffer::operator==( nullptr_t ) const noexcept
+{
+    return impl == nullptr;
+}
+
+bool TransformBuffer::operator!=( nullptr_t ) const noexcept
+{
+    return impl != nullptr;
+}
+
+uint32_t TransformBuffer::getSlotCount() const
+{
+    return impl->getSlotCount();
+}
+
+Transform* TransformBuffer::getTransforms()
+{
+    return impl->getTransforms();
+}
+
+void TransformBuffer::publish()
+{
+    impl->publish();
+}
+
+TransformBuffer::operator bool() const noexcept
+{
+    return impl != nullptr;
+}
+
+std::shared_ptr<TransformBufferImpl> TransformBuffer::get() const noexcept
+{
+    return impl;
+}
+
+void TransformBuffer::reset() noexcept
+{
+    impl.reset();
+}
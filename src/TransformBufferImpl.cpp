@@ -0,0 +1,86 @@
+#include "TransformBufferImpl.hpp"
+#include "DeviceImpl.hpp"
+#include "SoundImpl.hpp"
+
+#include <algorithm>
+
+using namespace Audio;
+
+TransformBufferImpl::TransformBufferImpl( std::shared_ptr<DeviceImpl> _device, uint32_t _slotCount )
+: device { std::move( _device ) }
+, slotCount { _slotCount }
+, transforms( static_cast<size_t>( _slotCount ) * 3 )
+, attachments { device->getRenderEpoch() }
+{
+    device->getTransformBuffers().add( this );
+}
+
+TransformBufferImpl::~TransformBufferImpl()
+{
+    device->getTransformBuffers().remove( this );
+}
+
+void TransformBufferImpl::publish() noexcept
+{
+    const Transform* written = getTransforms();
+
+    back = published.exchange( back | Fresh, std::memory_order_acq_rel ) & ~Fresh;
+
+    std::copy_n( written, slotCount, getTransforms() );
+}
+
+const Transform* TransformBufferImpl::acquire() noexcept
+{
+    if ( published.load( std::memory_order_relaxed ) & Fresh )
+        front = published.exchange( front, std::memory_order_acq_rel ) & ~Fresh;
+
+    return transforms.data() + static_cast<size_t>( front ) * slotCount;
+}
+
+void TransformBufferImpl::attach( SoundImpl* sound, uint32_t slot )
+{
+    // Publish a copy of the attachments with the sound in its new slot.
+    auto       next = attachments.items();
+    const auto iter = std::find_if( next.begin(), next.end(), [sound]( const Attachment& attachment ) { return attachment.sound == sound; } );
+    if ( iter != next.end() )
+        iter->slot = slot;
+    else
+        next.push_back( { sound, slot } );
+
+    attachments.assign( std::move( next ) );
+}
+
+void TransformBufferImpl::detach( SoundImpl* sound )
+{
+    attachments.removeIf( [sound]( const Attachment& attachment ) { return attachment.sound == sound; } );
+}
+
+void TransformBufferImpl::applyAll( const RealtimeList<TransformBufferImpl*>& buffers )
+{
+    for ( TransformBufferImpl* buffer: buffers.acquire() )
+    {
+        const auto& attachments = buffer->attachments.acquire();
+        if ( attachments.empty() )
+            continue;
+
+        const Transform* transforms = buffer->acquire();
+        for ( const auto& [sound, slot]: attachments )
+        {
+            const Transform& transform = transforms[slot];
+            ma_sound*        pSound    = sound->getSound();
+
+            ma_sound_set_position( pSound, transform.position.x, transform.position.y, transform.position.z );
+            ma_sound_set_direction( pSound, transform.direction.x, transform.direction.y, transform.direction.z );
+            ma_sound_set_velocity( pSound, transform.velocity.x, transform.velocity.y, transform.velocity.z );
+        }
+    }
+}
+
+void TransformBufferImpl::updateEmitters( const RealtimeList<TransformBufferImpl*>& buffers )
+{
+    for ( TransformBufferImpl* buffer: buffers.items() )
+    {
+        for ( const auto& attachment: buffer->attachments.items() )
+            attachment.sound->updateEmitter();
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Audio/TransformBuffer.hpp>
+
+#include "Realtime.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Audio
+{
+class DeviceImpl;
+class SoundImpl;
+
+class TransformBufferImpl
+{
+public:
+    TransformBufferImpl( std::shared_ptr<DeviceImpl> device, uint32_t slotCount );
+    ~TransformBufferImpl();
+
+    uint32_t getSlotCount() const noexcept
+    {
+        return slotCount;
+    }
+
+    /// <summary>
+    /// Get the copy of the transforms that is written by the game.
+    /// </summary>
+    Transform* getTransforms() noexcept
+    {
+        return transforms.data() + static_cast<size_t>( back ) * slotCount;
+    }
+
+    /// <summary>
+    /// Swap the written copy with the published copy, and carry the written transforms over to the new copy.
+    /// </summary>
+    void publish() noexcept;
+
+    /// <summary>
+    /// Attach a sound to a slot (or move it to another slot).
+    /// </summary>
+    void attach( SoundImpl* sound, uint32_t slot );
+    void detach( SoundImpl* sound );
+
+    /// <summary>
+    /// Apply the last published transforms of all buffers of a device to the attached sounds (on the audio thread).
+    /// </summary>
+    static void applyAll( const RealtimeList<TransformBufferImpl*>& buffers );
+
+    /// <summary>
+    /// Move the attached sounds in the emitter grid to the positions that were applied by the audio thread.
+    /// </summary>
+    static void updateEmitters( const RealtimeList<TransformBufferImpl*>& buffers );
+
+    TransformBufferImpl( const TransformBufferImpl& )            = delete;
+    TransformBufferImpl( TransformBufferImpl&& )                 = delete;
+    TransformBufferImpl& operator=( const TransformBufferImpl& ) = delete;
+    TransformBufferImpl& operator=( TransformBufferImpl&& )      = delete;
+
+private:
+    // Take the last published copy (if it is newer than the copy that was read before).
+    const Transform* acquire() noexcept;
+
+    struct Attachment
+    {
+        SoundImpl* sound;
+        uint32_t   slot;
+    };
+
+    // The device that owns the list of all buffers.
+    std::shared_ptr<DeviceImpl> device;
+
+    uint32_t slotCount;
+
+    // Three copies of the transforms (copy x slot): the copy that is written (`back`), the copy that is read (`front`),
+    // and the copy that was published last. `published` holds the index of the last published copy, and `Fresh` if it
+    // has not been read yet.
+    std::vector<Transform> transforms;
+    uint32_t               back  = 0;
+    uint32_t               front = 1;
+    std::atomic<uint32_t>  published { 2 };
+
+    static constexpr uint32_t Fresh = 4;
+
+    // The attached sounds (read by the audio thread).
+    RealtimeList<Attachment> attachments;
+};
+}  // namespace Audio
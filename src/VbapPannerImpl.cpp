@@ -0,0 +1,197 @@
+#include "VbapPannerImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+static constexpr float pi = 3.14159265358979323846f;
+
+// The angle (in degrees, clockwise from the front) of a speaker, or a negative value for channels without a direction.
+// The surround channels are placed at the angles of the ITU layouts (5.1 uses the side channels, 7.1 uses both).
+static float GetSpeakerAngle( ma_channel channel, bool hasSide, bool hasBack )
+{
+    switch ( channel )
+    {
+    case MA_CHANNEL_FRONT_LEFT:
+        return 330.0f;
+    case MA_CHANNEL_FRONT_RIGHT:
+        return 30.0f;
+    case MA_CHANNEL_FRONT_CENTER:
+        return 0.0f;
+    case MA_CHANNEL_FRONT_LEFT_CENTER:
+        return 345.0f;
+    case MA_CHANNEL_FRONT_RIGHT_CENTER:
+        return 15.0f;
+    case MA_CHANNEL_SIDE_LEFT:
+        return hasBack ? 270.0f : 250.0f;
+    case MA_CHANNEL_SIDE_RIGHT:
+        return hasBack ? 90.0f : 110.0f;
+    case MA_CHANNEL_BACK_LEFT:
+        return hasSide ? 210.0f : 225.0f;
+    case MA_CHANNEL_BACK_RIGHT:
+        return hasSide ? 150.0f : 135.0f;
+    case MA_CHANNEL_BACK_CENTER:
+        return 180.0f;
+    default:
+        return -1.0f;
+    }
+}
+
+VbapPannerImpl::VbapPannerImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, ma_sound* pSound )
+: CustomEffectImpl( std::move( device ), pEngine )
+, engine { pEngine }
+, sound { pSound }
+{
+    std::vector<ma_channel> channelMap( channels );
+    ma_channel_map_init_standard( ma_standard_channel_map_default, channelMap.data(), channelMap.size(), channels );
+
+    const auto has = [&channelMap]( ma_channel a, ma_channel b ) {
+        return std::find( channelMap.begin(), channelMap.end(), a ) != channelMap.end() || std::find( channelMap.begin(), channelMap.end(), b ) != channelMap.end();
+    };
+    const bool hasSide = has( MA_CHANNEL_SIDE_LEFT, MA_CHANNEL_SIDE_RIGHT );
+    const bool hasBack = has( MA_CHANNEL_BACK_LEFT, MA_CHANNEL_BACK_RIGHT );
+
+    for ( ma_uint32 channel = 0; channel < channels; ++channel )
+    {
+        const float angle = GetSpeakerAngle( channelMap[channel], hasSide, hasBack );
+        if ( angle < 0.0f )
+            continue;
+
+        const float azimuth = angle * pi / 180.0f;
+        speakers.push_back( { channel, azimuth, std::sin( azimuth ), std::cos( azimuth ) } );
+    }
+
+    std::sort( speakers.begin(), speakers.end(), []( const Speaker& a, const Speaker& b ) { return a.azimuth < b.azimuth; } );
+
+    gains.resize( channels );
+    targetGains.resize( channels );
+
+    // Blocks are usually smaller than this, so the audio thread doesn't need to allocate.
+    mono.reserve( 4096 );
+}
+
+VbapPannerImpl::~VbapPannerImpl()
+{
+    uninit();
+}
+
+void VbapPannerImpl::computeGains( const ma_vec3f& direction, float* out ) const
+{
+    std::fill_n( out, channels, 0.0f );
+
+    if ( speakers.empty() )
+        return;
+
+    const float count = static_cast<float>( speakers.size() );
+
+    // The part of the direction on the horizontal plane (+X is right, -Z is front).
+    const float x          = direction.x;
+    const float y          = -direction.z;
+    const float horizontal = x * x + y * y;
+
+    if ( horizontal > 1e-6f && speakers.size() > 1 )
+    {
+        float azimuth = std::atan2( x, y );
+        if ( azimuth < 0.0f )
+            azimuth += 2.0f * pi;
+
+        // The pair of adjacent speakers around the direction (wrapping around behind the listener).
+        size_t second = 0;
+        while ( second < speakers.size() && speakers[second].azimuth <= azimuth )
+            ++second;
+
+        const Speaker& a = speakers[( second + speakers.size() - 1 ) % speakers.size()];
+        const Speaker& b = speakers[second % speakers.size()];
+
+        // Solve p = g1 * l1 + g2 * l2 for the gains of the pair.
+        const float length = std::sqrt( horizontal );
+        const float px     = x / length;
+        const float py     = y / length;
+        const float det    = a.x * b.y - a.y * b.x;
+
+        float g1 = 1.0f;
+        float g2 = 0.0f;
+        if ( std::abs( det ) > 1e-6f )
+        {
+            g1 = std::max( ( px * b.y - py * b.x ) / det, 0.0f );
+            g2 = std::max( ( py * a.x - px * a.y ) / det, 0.0f );
+        }
+
+        const float norm = std::sqrt( g1 * g1 + g2 * g2 );
+        if ( norm > 1e-6f )
+        {
+            out[a.channel] = g1 / norm;
+            out[b.channel] = g2 / norm;
+        }
+    }
+
+    // Sounds above or below the listener are spread over all speakers (keeping the power constant).
+    const float spread = 1.0f - std::min( horizontal, 1.0f );
+    for ( const Speaker& speaker: speakers )
+    {
+        const float g        = out[speaker.channel];
+        out[speaker.channel] = std::sqrt( ( 1.0f - spread ) * g * g + spread / count );
+    }
+}
+
+ma_vec3f VbapPannerImpl::getDirection() const
+{
+    ma_vec3f relativePosition;
+
+    if ( ma_sound_get_positioning( sound ) == ma_positioning_relative )
+    {
+        relativePosition = ma_sound_get_position( sound );
+    }
+    else
+    {
+        const ma_uint32 listener = ma_sound_get_listener_index( sound );
+        ma_spatializer_get_relative_position_and_direction( &sound->engineNode.spatializer, &engine->listeners[listener], &relativePosition, nullptr );
+    }
+
+    const float length = std::sqrt( relativePosition.x * relativePosition.x + relativePosition.y * relativePosition.y + relativePosition.z * relativePosition.z );
+
+    // A sound on top of the listener is spread over all speakers.
+    if ( length < 1e-3f )
+        return { 0.0f, 0.0f, 0.0f };
+
+    return { relativePosition.x / length, relativePosition.y / length, relativePosition.z / length };
+}
+
+void VbapPannerImpl::process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount )
+{
+    const float* in = ppFramesIn[0];
+
+    computeGains( getDirection(), targetGains.data() );
+
+    // The first block starts at the target gains (the sound starts from silence).
+    if ( !hasGains )
+    {
+        gains    = targetGains;
+        hasGains = true;
+    }
+
+    // The spatializer does not pan the sound, so the speakers are downmixed to mono.
+    mono.resize( frameCount );
+    std::fill( mono.begin(), mono.end(), 0.0f );
+
+    const float scale = 1.0f / static_cast<float>( std::max<size_t>( speakers.size(), 1 ) );
+    for ( const Speaker& speaker: speakers )
+    {
+        for ( ma_uint32 frame = 0; frame < frameCount; ++frame )
+            mono[frame] += in[frame * channels + speaker.channel];
+    }
+
+    // Ramp the gains over the block (one channel at a time, so the inner loop has no dependencies).
+    const float step = frameCount > 0 ? 1.0f / static_cast<float>( frameCount ) : 0.0f;
+    for ( ma_uint32 channel = 0; channel < channels; ++channel )
+    {
+        const float start = gains[channel] * scale;
+        const float delta = ( targetGains[channel] - gains[channel] ) * scale * step;
+
+        for ( ma_uint32 frame = 0; frame < frameCount; ++frame )
+            pFramesOut[frame * channels + channel] = mono[frame] * ( start + delta * static_cast<float>( frame + 1 ) );
+    }
+
+    gains = targetGains;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "EffectImpl.hpp"
+
+#include <vector>
+
+namespace Audio
+{
+/// <summary>
+/// Per-voice vector base amplitude panning (VBAP) for multichannel devices: the (downmixed) output of a sound
+/// is panned between the pair of adjacent speakers around the direction of the sound. The panner is inserted
+/// between a sound and its bus, and the panning of the sound is disabled (the sound is still attenuated by its
+/// spatializer).
+/// </summary>
+/// <remarks>
+/// The speakers are placed on the horizontal plane (at the ITU angles of the standard channel map of the engine),
+/// and the LFE channel is not used. Sounds above or below the listener are spread over all speakers. The gains
+/// are power-normalized, and ramped over each block.
+/// </remarks>
+class VbapPannerImpl : public CustomEffectImpl
+{
+public:
+    /// <summary>
+    /// Create a panner.
+    /// </summary>
+    /// <param name="device">The device that owns the engine.</param>
+    /// <param name="pEngine">The engine. The engine must have at least three output channels.</param>
+    /// <param name="pSound">The sound that is panned (for its position relative to the listener).</param>
+    VbapPannerImpl( std::shared_ptr<DeviceImpl> device, ma_engine* pEngine, ma_sound* pSound );
+    ~VbapPannerImpl() override;
+
+    /// <summary>
+    /// Compute the gain of each channel for a direction (relative to the listener).
+    /// </summary>
+    /// <param name="direction">The (unit) direction, or zero for a sound on top of the listener.</param>
+    /// <param name="gains">The gain of each channel of the engine.</param>
+    void computeGains( const ma_vec3f& direction, float* gains ) const;
+
+protected:
+    void process( const float* const* ppFramesIn, float* pFramesOut, ma_uint32 frameCount ) override;
+
+private:
+    ma_vec3f getDirection() const;
+
+    ma_engine* engine = nullptr;
+    ma_sound*  sound  = nullptr;
+
+    struct Speaker
+    {
+        ma_uint32 channel;
+        float     azimuth;  // In radians, clockwise from the front.
+        float     x, y;     // The direction on the horizontal plane (right and front).
+    };
+
+    // The speakers, sorted by their azimuth.
+    std::vector<Speaker> speakers;
+
+    // The current and the target gain of each channel.
+    std::vector<float> gains;
+    std::vector<float> targetGains;
+    bool               hasGains = false;
+
+    // The downmixed input.
+    std::vector<float> mono;
+};
+}  // namespace Audio
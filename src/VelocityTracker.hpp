@@ -0,0 +1,72 @@
+#pragma once
+
+#include "miniaudio.h"
+
+namespace Audio
+{
+/// <summary>
+/// Derives the velocity of a sound (or listener) from successive timestamped positions.
+/// </summary>
+class VelocityTracker
+{
+public:
+    /// <summary>
+    /// Add a timestamped position.
+    /// </summary>
+    /// <param name="position">The new position.</param>
+    /// <param name="time">The time of the position (in seconds).</param>
+    /// <param name="velocity">Receives the velocity from the previous position to the new position.
+    /// The velocity is zero for the first position, and after a gap of more than `MaxInterval` (like a teleport after a pause).</param>
+    /// <returns>`true` if the velocity was updated, `false` if the position is not newer than the previous position.</returns>
+    bool update( const ma_vec3f& position, double time, ma_vec3f& velocity ) noexcept
+    {
+        const double interval = time - previousTime;
+        if ( hasPrevious && interval <= 0.0 )
+            return false;
+
+        if ( hasPrevious && interval <= MaxInterval )
+        {
+            const float scale = static_cast<float>( 1.0 / interval );
+            velocity          = { ( position.x - previousPosition.x ) * scale, ( position.y - previousPosition.y ) * scale, ( position.z - previousPosition.z ) * scale };
+            lastInterval      = interval;
+        }
+        else
+        {
+            velocity     = { 0.0f, 0.0f, 0.0f };
+            lastInterval = 0.0;
+        }
+
+        previousPosition = position;
+        previousTime     = time;
+        hasPrevious      = true;
+
+        return true;
+    }
+
+    /// <summary>
+    /// Forget the previous position (for example, when the position is set without a timestamp).
+    /// </summary>
+    void reset() noexcept
+    {
+        hasPrevious  = false;
+        lastInterval = 0.0;
+    }
+
+    /// <summary>
+    /// Get the time (in seconds) between the last two positions, or 0 if the velocity was not derived from the last position.
+    /// </summary>
+    double getInterval() const noexcept
+    {
+        return lastInterval;
+    }
+
+    // Positions that are further apart (in seconds) are not used to derive the velocity.
+    static constexpr double MaxInterval = 0.5;
+
+private:
+    ma_vec3f previousPosition {};
+    double   previousTime = 0.0;
+    double   lastInterval = 0.0;
+    bool     hasPrevious  = false;
+};
+}  // namespace Audio
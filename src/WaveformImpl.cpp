@@ -1,4 +1,5 @@
 #include "WaveformImpl.hpp"
+#include "BusImpl.hpp"
 
 #include "Audio/Waveform.hpp"
 
@@ -53,8 +54,9 @@ static void waveform_callback( ma_device* pDevice, void* output, const void*, ma
     ma_waveform_read_pcm_frames( waveform, output, frameCount, nullptr );
 }
 
-WaveformImpl::WaveformImpl( std::shared_ptr<DeviceImpl> device, Waveform::Type _type, float _amplitude, float _frequency, ma_engine* pEngine )
+WaveformImpl::WaveformImpl( std::shared_ptr<DeviceImpl> device, Waveform::Type _type, float _amplitude, float _frequency, ma_engine* pEngine, std::shared_ptr<BusImpl> _bus )
 : device { std::move( device ) }
+, bus { std::move( _bus ) }
 , type( _type )
 , amplitude( _amplitude )
 , frequency( _frequency )
@@ -77,8 +79,8 @@ WaveformImpl::WaveformImpl( std::shared_ptr<DeviceImpl> device, Waveform::Type _
 
         if ( result == MA_SUCCESS )
         {
-            // Attach the data source node to the endpoint of the engine's node graph.
-            ma_node* outputNode = ma_node_graph_get_endpoint( nodeGraph );
+            // Attach the data source node to the bus (or the endpoint of the engine's node graph).
+            ma_node* outputNode = bus ? bus->getInputNode() : ma_node_graph_get_endpoint( nodeGraph );
             result              = ma_node_attach_output_bus( &node, 0, outputNode, 0 );
 
             if ( result != MA_SUCCESS )
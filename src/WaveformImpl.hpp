@@ -4,14 +4,17 @@
 
 #include "miniaudio.h"
 
+#include <memory>
+
 namespace Audio
 {
+class BusImpl;
 class DeviceImpl;
 
 class WaveformImpl
 {
 public:
-    WaveformImpl( std::shared_ptr<DeviceImpl> device, Waveform::Type type, float amplitude, float frequency, ma_engine* pEngine );
+    WaveformImpl( std::shared_ptr<DeviceImpl> device, Waveform::Type type, float amplitude, float frequency, ma_engine* pEngine, std::shared_ptr<BusImpl> bus = nullptr );
     ~WaveformImpl();
 
     void           setType( Waveform::Type type );
@@ -32,6 +35,7 @@ public:
 
 private:
     std::shared_ptr<DeviceImpl> device;
+    std::shared_ptr<BusImpl>    bus;
     Waveform::Type type;
     float          amplitude  = 0.0f;
     float          frequency  = 0.0f;